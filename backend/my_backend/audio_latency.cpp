@@ -0,0 +1,100 @@
+#include "audio_latency.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+int64_t LatencyTable::offset_for(const std::string &sink) const {
+    auto it = sinks_.find(sink);
+    return global_offset_us_ + (it != sinks_.end() ? it->second : 0);
+}
+
+bool LatencyTable::load(const std::string &path) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string kind; long long offset_us = 0;
+        if (!(fields >> kind >> offset_us)) continue;
+        if (kind == "global") { global_offset_us_ = offset_us; continue; }
+        std::string sink;
+        if (kind == "sink" && (fields >> std::ws, std::getline(fields, sink)) && !sink.empty()) sinks_[sink] = offset_us;
+    }
+    return true;
+}
+
+bool LatencyTable::save(const std::string &path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "# musicfox-lyric 音频延迟补偿（微秒，正值表示歌词推迟）\n";
+    out << "global " << global_offset_us_ << "\n";
+    for (const auto &kv : sinks_) out << "sink " << kv.second << " " << kv.first << "\n";
+    return static_cast<bool>(out);
+}
+
+// 单引号包起来交给 sh，值里的单引号写成 '\''
+static std::string shell_quote(const std::string &value) {
+    std::string quoted = "'";
+    for (char c : value) { if (c == '\'') quoted += "'\\''"; else quoted += c; }
+    return quoted + "'";
+}
+
+static std::string run_command(const char *command) {
+    std::string output;
+    FILE *pipe = popen(command, "r");
+    if (!pipe) return output;
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), pipe)) > 0) output.append(buffer, n);
+    pclose(pipe);
+    return output;
+}
+
+bool PactlSinkProbe::probe(std::string &sink, int64_t &latency_us) {
+    std::string env = server_.empty() ? std::string("LC_ALL=C ") : "LC_ALL=C PULSE_SERVER=" + shell_quote(server_) + " ";
+    sink = run_command((env + "pactl get-default-sink 2>/dev/null").c_str());
+    sink.erase(sink.find_last_not_of(" \t\r\n") + 1);
+    if (sink.empty()) return false;
+    // pactl list sinks 按 sink 分段，找到 "Name: <sink>" 之后的第一条 "Latency:"
+    std::istringstream listing(run_command((env + "pactl list sinks 2>/dev/null").c_str()));
+    std::string line;
+    bool in_sink = false;
+    while (std::getline(listing, line)) {
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos) continue;
+        if (line.compare(start, 5, "Name:") == 0) {
+            std::string name = line.substr(start + 5);
+            name.erase(0, name.find_first_not_of(" \t"));
+            in_sink = (name == sink);
+        } else if (in_sink && line.compare(start, 8, "Latency:") == 0) {
+            long long value = 0;
+            if (sscanf(line.c_str() + start + 8, "%lld", &value) != 1) return false;
+            latency_us = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool calibrate_sink_latency(SinkProbe &probe, LatencyTable &table, int samples, std::string *sink_out, int64_t *latency_out) {
+    std::string sink;
+    std::vector<int64_t> latencies;
+    for (int i = 0; i < samples; ++i) {
+        std::string name; int64_t latency_us = 0;
+        if (!probe.probe(name, latency_us)) continue;
+        // 采样期间换了设备，以最后的设备重新开始
+        if (name != sink) { sink = name; latencies.clear(); }
+        latencies.push_back(latency_us);
+    }
+    if (latencies.empty()) return false;
+    std::nth_element(latencies.begin(), latencies.begin() + latencies.size() / 2, latencies.end());
+    int64_t median = latencies[latencies.size() / 2];
+    table.set_sink_offset_us(sink, median);
+    if (sink_out) *sink_out = sink;
+    if (latency_out) *latency_out = median;
+    return true;
+}
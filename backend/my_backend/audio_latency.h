@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+// 音频输出延迟补偿：PipeWire / 蓝牙输出会让声音比 MPRIS 报告的位置晚 150~300ms。
+// 偏移 = 全局偏移 + 当前输出设备（sink）的偏移，正值表示歌词推迟。
+// 偏移在时间轴生成/更换时一次性加到时间戳上，显示路径没有额外开销。
+
+class LatencyTable {
+public:
+    int64_t global_offset_us() const { return global_offset_us_; }
+    void set_global_offset_us(int64_t offset_us) { global_offset_us_ = offset_us; }
+    void set_sink_offset_us(const std::string &sink, int64_t offset_us) { sinks_[sink] = offset_us; }
+    int64_t offset_for(const std::string &sink) const;
+    size_t sink_count() const { return sinks_.size(); }
+
+    // 文本格式，每行一项："global <us>" 或 "sink <us> <sink 名>"，# 开头为注释
+    bool load(const std::string &path);
+    bool save(const std::string &path) const;
+
+private:
+    int64_t global_offset_us_ = 0;
+    std::map<std::string, int64_t> sinks_;
+};
+
+// 查询当前默认输出设备及其延迟的替身接口，测试里可以换成假的实现
+class SinkProbe {
+public:
+    virtual ~SinkProbe() = default;
+    virtual bool probe(std::string &sink, int64_t &latency_us) = 0;
+};
+
+// 通过 pactl（PulseAudio 或 pipewire-pulse）查询：默认 sink 名和 "Latency: N usec"。
+// server 非空时通过 PULSE_SERVER 连接指定的声音服务（守护模式下是各用户自己的 pulse/native 套接字）
+class PactlSinkProbe : public SinkProbe {
+public:
+    explicit PactlSinkProbe(std::string server = std::string()) : server_(std::move(server)) {}
+    bool probe(std::string &sink, int64_t &latency_us) override;
+
+private:
+    std::string server_;
+};
+
+// 校准：采样 samples 次取中位数，写入当前 sink 的偏移；成功返回 true
+bool calibrate_sink_latency(SinkProbe &probe, LatencyTable &table, int samples, std::string *sink_out = nullptr, int64_t *latency_out = nullptr);
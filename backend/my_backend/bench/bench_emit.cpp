@@ -0,0 +1,109 @@
+// 每次更新的 CPU / RSS 基准，不连总线，两条路径跑同一串更新：
+//   ./bench_emit [次数]            手写接口：player_interface_build（快照比较 + 构造信号参数）
+//   ./bench_emit --codegen [次数]  gdbus-codegen 骨架：逐个属性 setter（GObject 属性 + GValue），
+//                                  flush 出 PropertiesChanged，再 emit StateChanged
+// 默认 1000000 次。--codegen 只在构建时找到 gdbus-codegen 时可用，骨架由当前的 music_info_service.xml 生成。
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "player_interface.h"
+#ifdef MUSICFOX_BENCH_CODEGEN
+#include "music-info-service-generated.h"
+#endif
+
+static long rss_kib() {
+    long pages = 0, resident = 0;
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    if (fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+    fclose(f);
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+static double cpu_seconds() {
+    struct rusage usage; getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// 模拟 100ms 刷新：位置每次都变，歌词大约每 40 次换一行
+static void next_state(PlayerState &state, long i) {
+    state.position = static_cast<double>(i % 2690) / 10.0;
+    if (i % 40 == 0) state.current_lyric = "故事的小黄花 从出生那年就飘着 " + std::to_string(i / 40);
+}
+
+static void run_vtable(PlayerState &state, long iterations) {
+    PlayerState snapshot;
+    for (long i = 0; i < iterations; ++i) {
+        next_state(state, i);
+        GVariant *properties_changed = nullptr;
+        GVariant *state_changed = nullptr;
+        GVariant *clock_anchor = nullptr;
+        player_interface_build(snapshot, state, &properties_changed, &state_changed, &clock_anchor);
+        if (properties_changed) g_variant_unref(g_variant_ref_sink(properties_changed));
+        if (clock_anchor) g_variant_unref(g_variant_ref_sink(clock_anchor));
+        g_variant_unref(g_variant_ref_sink(state_changed));
+    }
+}
+
+#ifdef MUSICFOX_BENCH_CODEGEN
+// 与改写前的服务一样每次设置全部属性，由 GObject 比较 GValue 决定是否记入变化；
+// 没导出的骨架不会自己发 PropertiesChanged，每次更新后 flush 一次，相当于空闲回调逐次触发
+static void run_codegen(PlayerState &state, long iterations) {
+    MusicInfoServicePlayer *player = music_info_service_player_skeleton_new();
+    PlayerState anchor;
+    for (long i = 0; i < iterations; ++i) {
+        next_state(state, i);
+        music_info_service_player_set_artist(player, state.artist.c_str());
+        music_info_service_player_set_title(player, state.title.c_str());
+        music_info_service_player_set_is_playing(player, state.is_playing);
+        music_info_service_player_set_current_lyric(player, state.current_lyric.c_str());
+        music_info_service_player_set_current_segment(player, state.current_segment.c_str());
+        music_info_service_player_set_duration(player, state.duration);
+        music_info_service_player_set_position(player, state.position);
+        music_info_service_player_set_current_romanization(player, state.current_romanization.c_str());
+        music_info_service_player_set_line_start_us(player, state.line_start_us);
+        music_info_service_player_set_line_end_us(player, state.line_end_us);
+        music_info_service_player_set_next_lyric(player, state.next_lyric.c_str());
+        // 锚点是元组，setter 前要先构造 GVariant，和手写路径一样只在变化时构造
+        if (i == 0 || state.anchor_monotonic_us != anchor.anchor_monotonic_us || state.anchor_position_us != anchor.anchor_position_us || state.rate != anchor.rate || state.is_playing != anchor.is_playing) {
+            music_info_service_player_set_clock_anchor(player, g_variant_new("(xxdb)", static_cast<gint64>(state.anchor_monotonic_us), static_cast<gint64>(state.anchor_position_us), state.rate, state.is_playing));
+            anchor = state;
+        }
+        g_dbus_interface_skeleton_flush(G_DBUS_INTERFACE_SKELETON(player));
+        music_info_service_player_emit_state_changed(player, state.artist.c_str(), state.title.c_str(), state.is_playing, state.current_lyric.c_str(), state.duration, state.position);
+    }
+    g_object_unref(player);
+}
+#endif
+
+int main(int argc, char *argv[]) {
+    bool codegen = argc > 1 && strcmp(argv[1], "--codegen") == 0;
+    if (codegen) { argc--; argv++; }
+    long iterations = argc > 1 ? std::atol(argv[1]) : 1000000;
+#ifndef MUSICFOX_BENCH_CODEGEN
+    if (codegen) { std::cerr << "built without gdbus-codegen: --codegen is not available" << std::endl; return 2; }
+#endif
+    PlayerState state;
+    state.artist = "周杰伦"; state.title = "晴天"; state.is_playing = true; state.duration = 269.0;
+    long rss_start = rss_kib();
+    double cpu_start = cpu_seconds();
+    auto start = std::chrono::steady_clock::now();
+#ifdef MUSICFOX_BENCH_CODEGEN
+    if (codegen) run_codegen(state, iterations);
+    else
+#endif
+    run_vtable(state, iterations);
+    auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    double cpu_ns = (cpu_seconds() - cpu_start) * 1e9;
+    struct rusage usage; getrusage(RUSAGE_SELF, &usage);
+    std::cout << (codegen ? "codegen" : "vtable") << " updates: " << iterations
+              << ", ns/update: " << (iterations ? elapsed_ns / iterations : 0)
+              << ", CPU ns/update: " << (iterations ? static_cast<long>(cpu_ns / iterations) : 0)
+              << ", RSS growth: " << rss_kib() - rss_start << " KiB, max RSS: " << usage.ru_maxrss << " KiB" << std::endl;
+    return 0;
+}
@@ -0,0 +1,143 @@
+// 歌词核心、时钟模型和换歌路径的基准测试，同时作为 PGO 的训练负载
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "clock_model.h"
+#include "lrc_timestamp.h"
+#include "lyric_engine.h"
+#include "lyric_timeline.h"
+#include "romanization.h"
+#include "text_encoding.h"
+#include "trace_ring.h"
+
+// 合成一份 n 行的 LRC：带元数据标签，一半两位毫秒一半三位毫秒，时间戳乱序
+static std::string make_lrc(int lines, const char *text) {
+    std::string lrc = "[ti:晴天]\n[ar:周杰伦]\n[offset:0]\n";
+    char stamp[32];
+    for (int i = 0; i < lines; ++i) {
+        int t = (i * 7919) % lines * 3170;  // 毫秒
+        if (i % 2) snprintf(stamp, sizeof(stamp), "[%02d:%02d.%02d]", t / 60000, t / 1000 % 60, t % 1000 / 10);
+        else snprintf(stamp, sizeof(stamp), "[%02d:%02d.%03d]", t / 60000, t / 1000 % 60, t % 1000);
+        lrc += stamp; lrc += text; lrc += "\n";
+    }
+    return lrc;
+}
+
+static void BM_ParseLrc(benchmark::State &state) {
+    std::string lrc = make_lrc(static_cast<int>(state.range(0)), "故事的小黄花 从出生那年就飘着");
+    for (auto _ : state) benchmark::DoNotOptimize(parse_lrc(lrc));
+    state.SetBytesProcessed(state.iterations() * lrc.size());
+    // 每行耗时 = 1 / items_per_second
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParseLrc)->Arg(60)->Arg(1000);
+
+// 单个时间标签的解码：0 = SWAR 快速路径，1 = 通用定宽解码 <2, 2>，2 = 毫秒形状 <2, 3>
+static void BM_DecodeTimestamp(benchmark::State &state) {
+    std::vector<std::string> stamps;
+    for (int i = 0; i < 256; ++i) {
+        char stamp[16];
+        if (state.range(0) == 2) snprintf(stamp, sizeof(stamp), "%02d:%02d.%03d]", i % 60, i * 7 % 60, i * 37 % 1000);
+        else snprintf(stamp, sizeof(stamp), "%02d:%02d.%02d]", i % 60, i * 7 % 60, i * 37 % 100);
+        stamps.push_back(stamp);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        const char *p = stamps[i++ & 255].c_str();
+        if (state.range(0) == 0) benchmark::DoNotOptimize(lrc_decode_timestamp_swar(p));
+        else if (state.range(0) == 1) benchmark::DoNotOptimize(lrc_decode_timestamp<2, 2>(p));
+        else benchmark::DoNotOptimize(lrc_decode_timestamp<2, 3>(p));
+    }
+}
+BENCHMARK(BM_DecodeTimestamp)->ArgName("shape")->Arg(0)->Arg(1)->Arg(2);
+
+static void BM_DecodeLyricText(benchmark::State &state) {
+    std::string lrc = make_lrc(static_cast<int>(state.range(0)), "Here comes the sun, and I say it's all right");
+    for (size_t pos = 0; (pos = lrc.find('\n', pos)) != std::string::npos; pos += 2) lrc.insert(pos, "\r");
+    for (auto _ : state) benchmark::DoNotOptimize(decode_lyric_text(lrc));
+    state.SetBytesProcessed(state.iterations() * lrc.size());
+}
+BENCHMARK(BM_DecodeLyricText)->Arg(60)->Arg(1000);
+
+static void BM_Utf8Validate(benchmark::State &state) {
+    std::string text = state.range(1) ? "故事的小黄花 从出生那年就飘着 " : "Here comes the sun ";
+    while (text.size() < static_cast<size_t>(state.range(0))) text += text;
+    text.resize(state.range(0));
+    // 截断可能切在多字节字符中间，退回到最后一个完整字符
+    while (!text.empty() && !utf8_validate_scalar(text.data(), text.size())) text.pop_back();
+    for (auto _ : state) benchmark::DoNotOptimize(utf8_validate(text.data(), text.size()));
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_Utf8Validate)->Args({4096, 0})->Args({4096, 1})->Args({65536, 0})->Args({65536, 1});
+
+static void BM_TimelineIndexAt(benchmark::State &state) {
+    std::vector<LyricLine> timeline = parse_lrc(make_lrc(static_cast<int>(state.range(0)), "line"));
+    int64_t end_us = timeline.empty() ? 1 : timeline.back().timestamp_us + 1;
+    int64_t position_us = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(timeline_index_at(timeline, position_us));
+        position_us = (position_us + 100000) % end_us;
+    }
+}
+BENCHMARK(BM_TimelineIndexAt)->Arg(60)->Arg(1000);
+
+static void BM_RomanizeLine(benchmark::State &state) {
+    const char *line = state.range(0) ? "きみがいない よるだって" : "故事的小黄花 从出生那年就飘着";
+    for (auto _ : state) benchmark::DoNotOptimize(romanize_line(line));
+}
+BENCHMARK(BM_RomanizeLine)->Arg(0)->Arg(1);
+
+static void BM_ClockPredict(benchmark::State &state) {
+    clock_model_t clock = {};
+    clock_sync(clock, 42000000, clock_now_us());
+    for (auto _ : state) benchmark::DoNotOptimize(clock_predict_us(clock, true, clock_now_us()));
+}
+BENCHMARK(BM_ClockPredict);
+
+// 热路径上每条追踪事件的开销
+static void BM_TraceRecord(benchmark::State &state) {
+    for (auto _ : state) trace_instant(TraceEvent::Emit, 3);
+}
+BENCHMARK(BM_TraceRecord)->Threads(1)->Threads(4);
+
+// 模拟播放器按队列顺序换歌，测换歌到发出第一行歌词的延迟（即 track_change_lyric_emit）。
+// 第二个参数为 1 时，每首歌开始前先像后台线程那样把下一首解析好交给引擎（不计时），
+// 对照 0 即可看出预取省下的主线程解析时间
+static void BM_TrackChange(benchmark::State &state) {
+    const int lines = static_cast<int>(state.range(0));
+    const bool prefetch = state.range(1) != 0;
+    std::vector<PlayerUpdate> queue;
+    for (int i = 0; i < 16; ++i) {
+        PlayerUpdate update;
+        update.has_status = true; update.is_playing = true; update.has_metadata = true;
+        update.metadata.trackid = "/org/musicfox/track/" + std::to_string(i);
+        update.metadata.title = "曲目" + std::to_string(i); update.metadata.artist = "歌手"; update.metadata.duration_us = 240000000;
+        update.has_lyrics = true; update.lyrics = make_lrc(lines, i % 2 ? "故事的小黄花 从出生那年就飘着" : "きみがいない よるだって");
+        update.lyrics += "[99:00.00]" + std::to_string(i) + "\n";
+        queue.push_back(std::move(update));
+    }
+    SteadyClock clock;
+    LyricEngine engine(clock, EngineCallbacks());
+    size_t next = 0;
+    for (auto _ : state) {
+        const PlayerUpdate &update = queue[next];
+        if (prefetch) {
+            state.PauseTiming();
+            PrefetchedLyrics prefetched; prefetched.trackid = update.metadata.trackid; prefetched.from_player = true;
+            prefetched.payload = update.lyrics; prefetched.timeline = parse_lyric_payload(update.lyrics);
+            engine.store_prefetched(std::move(prefetched));
+            state.ResumeTiming();
+        }
+        engine.on_player_update(update);
+        next = (next + 1) % queue.size();
+    }
+    const engine_metrics_t &metrics = engine.metrics();
+    state.counters["lyric_emit_us"] = metrics.track_change_lyric_emit.count ? static_cast<double>(metrics.track_change_lyric_emit.total_us) / metrics.track_change_lyric_emit.count : 0.0;
+    state.counters["prefetch_hits"] = static_cast<double>(metrics.prefetch_hits);
+}
+BENCHMARK(BM_TrackChange)->ArgNames({"lines", "prefetch"})->Args({60, 0})->Args({60, 1})->Args({1000, 0})->Args({1000, 1});
+
+BENCHMARK_MAIN();
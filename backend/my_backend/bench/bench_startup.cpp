@@ -0,0 +1,149 @@
+// 启动耗时基准：反复拉起 music-info-service，测 exec 到总线名出现、exec 到第一行歌词发出的时间。
+// 自带一个假的 musicfox（org.mpris.MediaPlayer2.musicfox.bench，正在播放、歌词从 0 秒开始），不需要真的播放器。
+// 须在独立的会话总线里跑，避免和桌面上正在运行的服务抢名字：
+//   dbus-run-session -- ./bench_startup ../music-info-service [次数]，默认 20 次
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <csignal>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <gio/gio.h>
+
+static const char *kServiceName = "org.amazzy24128.MusicInfoService";
+static const char *kPlayerName = "org.mpris.MediaPlayer2.musicfox.bench";
+static const char *kLyrics = "[00:00.00]故事的小黄花\n[00:04.00]从出生那年就飘着\n[05:00.00]";
+
+static const char *kPlayerXml =
+    "<node>"
+    "  <interface name='org.mpris.MediaPlayer2.Player'>"
+    "    <property name='PlaybackStatus' type='s' access='read'/>"
+    "    <property name='Metadata' type='a{sv}' access='read'/>"
+    "    <property name='Position' type='x' access='read'/>"
+    "    <property name='Rate' type='d' access='read'/>"
+    "  </interface>"
+    "</node>";
+
+typedef struct {
+    GDBusConnection *connection;
+    gint64 spawned_us;
+    gint64 name_us;
+    gint64 lyric_us;
+    bool service_present;
+    bool watch_settled;
+    bool timed_out;
+} run_state_t;
+
+static GVariant *player_get_property(GDBusConnection *connection, const gchar *sender, const gchar *path, const gchar *iface, const gchar *name, GError **error, gpointer user_data) {
+    if (g_strcmp0(name, "PlaybackStatus") == 0) return g_variant_new_string("Playing");
+    if (g_strcmp0(name, "Position") == 0) return g_variant_new_int64(1000000);
+    if (g_strcmp0(name, "Rate") == 0) return g_variant_new_double(1.0);
+    GVariantBuilder builder;
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+    const gchar *artists[] = {"周杰伦", nullptr};
+    g_variant_builder_add(&builder, "{sv}", "mpris:trackid", g_variant_new_object_path("/org/musicfox/bench/1"));
+    g_variant_builder_add(&builder, "{sv}", "xesam:title", g_variant_new_string("晴天"));
+    g_variant_builder_add(&builder, "{sv}", "xesam:artist", g_variant_new_strv(artists, -1));
+    g_variant_builder_add(&builder, "{sv}", "mpris:length", g_variant_new_int64(300000000));
+    g_variant_builder_add(&builder, "{sv}", "xesam:asText", g_variant_new_string(kLyrics));
+    return g_variant_builder_end(&builder);
+}
+
+static void on_state_changed(GDBusConnection *connection, const gchar *sender, const gchar *path, const gchar *iface, const gchar *signal, GVariant *params, gpointer user_data) {
+    run_state_t *run = static_cast<run_state_t*>(user_data);
+    if (run->lyric_us || !g_variant_is_of_type(params, G_VARIANT_TYPE("(ssbsdd)"))) return;
+    const gchar *lyric = nullptr;
+    g_variant_get(params, "(&s&sb&sdd)", nullptr, nullptr, nullptr, &lyric, nullptr, nullptr);
+    if (lyric && *lyric) run->lyric_us = g_get_monotonic_time();
+}
+
+static void on_service_appeared(GDBusConnection *connection, const gchar *name, const gchar *owner, gpointer user_data) {
+    run_state_t *run = static_cast<run_state_t*>(user_data);
+    run->service_present = true;
+    run->watch_settled = true;
+    if (!run->spawned_us || run->name_us) return;
+    run->name_us = g_get_monotonic_time();
+    // 和扩展一样：名字出现后登记 lyric 档位，服务才开始发信号
+    g_dbus_connection_call(connection, kServiceName, "/org/amazzy24128/MusicInfoService/Player", "org.amazzy24128.MusicInfoService.Player", "Subscribe", g_variant_new("(s)", "lyric"), nullptr, G_DBUS_CALL_FLAGS_NONE, -1, nullptr, nullptr, nullptr);
+}
+
+static void on_service_vanished(GDBusConnection *connection, const gchar *name, gpointer user_data) {
+    run_state_t *run = static_cast<run_state_t*>(user_data);
+    run->service_present = false;
+    run->watch_settled = true;
+}
+
+static gboolean on_run_timeout(gpointer user_data) {
+    static_cast<run_state_t*>(user_data)->timed_out = true;
+    return G_SOURCE_REMOVE;
+}
+
+static void print_stats(const char *label, std::vector<double> samples) {
+    if (samples.empty()) { std::cout << label << ": no samples" << std::endl; return; }
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    std::cout << label << " (ms): min " << samples.front() << ", median " << samples[n / 2] << ", p90 " << samples[std::min(n - 1, n * 9 / 10)] << ", max " << samples.back() << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) { std::cerr << "Usage: " << argv[0] << " SERVICE_BINARY [RUNS]" << std::endl; return 2; }
+    int runs = argc > 2 ? std::atoi(argv[2]) : 20;
+    GError *error = nullptr;
+    GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SESSION, nullptr, &error);
+    if (!connection) { std::cerr << "Failed to get session bus: " << (error ? error->message : "unknown error") << std::endl; g_clear_error(&error); return 1; }
+
+    GDBusNodeInfo *node = g_dbus_node_info_new_for_xml(kPlayerXml, nullptr);
+    GDBusInterfaceVTable vtable = {nullptr, player_get_property, nullptr};
+    g_dbus_connection_register_object(connection, "/org/mpris/MediaPlayer2", node->interfaces[0], &vtable, nullptr, nullptr, nullptr);
+    GVariant *reply = g_dbus_connection_call_sync(connection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "RequestName", g_variant_new("(su)", kPlayerName, 4u), G_VARIANT_TYPE("(u)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+    if (!reply) { std::cerr << "Failed to own " << kPlayerName << ": " << error->message << std::endl; g_clear_error(&error); return 1; }
+    g_variant_unref(reply);
+
+    run_state_t run = {connection, 0, 0, 0, false, false, false};
+    guint watch_id = g_bus_watch_name_on_connection(connection, kServiceName, G_BUS_NAME_WATCHER_FLAGS_NONE, on_service_appeared, on_service_vanished, &run, nullptr);
+    guint signal_id = g_dbus_connection_signal_subscribe(connection, kServiceName, "org.amazzy24128.MusicInfoService.Player", "StateChanged", nullptr, nullptr, G_DBUS_SIGNAL_FLAGS_NONE, on_state_changed, &run, nullptr);
+    // 等名字监视的初始结果，确认总线上没有别的服务实例
+    while (!run.watch_settled) g_main_context_iteration(nullptr, TRUE);
+    if (run.service_present) { std::cerr << kServiceName << " is already running on this bus; use dbus-run-session" << std::endl; return 1; }
+
+    gchar **envp = g_environ_setenv(g_get_environ(), "MUSICFOX_LRC_DIR", "", TRUE);
+    gchar *service_argv[] = {argv[1], nullptr};
+    std::vector<double> to_name, to_lyric;
+    for (int i = 0; i < runs; ++i) {
+        run.name_us = run.lyric_us = 0;
+        run.timed_out = false;
+        GPid pid;
+        run.spawned_us = g_get_monotonic_time();
+        if (!g_spawn_async(nullptr, service_argv, envp, static_cast<GSpawnFlags>(G_SPAWN_DO_NOT_REAP_CHILD | G_SPAWN_STDOUT_TO_DEV_NULL), nullptr, nullptr, &pid, &error)) {
+            std::cerr << "Failed to start " << argv[1] << ": " << error->message << std::endl;
+            g_clear_error(&error);
+            return 1;
+        }
+        guint timeout_id = g_timeout_add_seconds(5, on_run_timeout, &run);
+        while (!run.lyric_us && !run.timed_out) g_main_context_iteration(nullptr, TRUE);
+        if (!run.timed_out) g_source_remove(timeout_id);
+        kill(pid, SIGTERM);
+        waitpid(pid, nullptr, 0);
+        g_spawn_close_pid(pid);
+        if (run.timed_out) std::cerr << "run " << i << ": no lyric within 5 s" << std::endl;
+        else {
+            to_name.push_back((run.name_us - run.spawned_us) / 1000.0);
+            to_lyric.push_back((run.lyric_us - run.spawned_us) / 1000.0);
+        }
+        // 等总线确认旧实例的名字已释放，下一轮才不会把它算成新实例
+        run.spawned_us = 0;
+        while (run.service_present) g_main_context_iteration(nullptr, TRUE);
+    }
+    std::cout << "runs: " << runs << std::endl;
+    print_stats("exec -> name acquired", to_name);
+    print_stats("exec -> first lyric", to_lyric);
+
+    g_strfreev(envp);
+    g_dbus_connection_signal_unsubscribe(connection, signal_id);
+    g_bus_unwatch_name(watch_id);
+    g_dbus_node_info_unref(node);
+    g_object_unref(connection);
+    return to_lyric.empty() ? 1 : 0;
+}
@@ -0,0 +1,189 @@
+// 内嵌歌词读取的基准：对整个曲库逐个文件调用 read_embedded_lyrics，统计每个文件的耗时、缺页数和读入页缓存的页数。
+//   bench_tag_lyrics                 在临时目录生成 10000 个合成文件（MP3/FLAC/Ogg 混合，带封面，音频部分是空洞）
+//   bench_tag_lyrics DIR [--files N]  扫描真实曲库（.mp3 .flac .ogg .opus）
+// 每个文件读取前用 POSIX_FADV_DONTNEED 丢掉它的页缓存（脏页和其他进程映射着的页丢不掉，真实曲库上是近似的冷读），
+// 读取后用 mincore 看哪些页进了页缓存：驻留页只应在文件开头的标签区域，与音频大小无关
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <string>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "tag_lyrics.h"
+
+static std::string be32(uint32_t v) { return std::string{static_cast<char>(v >> 24), static_cast<char>(v >> 16), static_cast<char>(v >> 8), static_cast<char>(v)}; }
+static std::string le32(uint32_t v) { return std::string{static_cast<char>(v), static_cast<char>(v >> 8), static_cast<char>(v >> 16), static_cast<char>(v >> 24)}; }
+static std::string synchsafe(uint32_t v) { return std::string{static_cast<char>(v >> 21 & 0x7F), static_cast<char>(v >> 14 & 0x7F), static_cast<char>(v >> 7 & 0x7F), static_cast<char>(v & 0x7F)}; }
+
+static std::string synthetic_lrc(int index) {
+    std::string lrc;
+    char line[96];
+    for (int i = 0; i < 40; ++i) { snprintf(line, sizeof(line), "[%02d:%02d.00]第 %d 首歌的第 %d 行歌词\n", i * 5 / 60, i * 5 % 60, index, i + 1); lrc += line; }
+    return lrc;
+}
+
+// 四种布局轮换：ID3v2.3 封面 + USLT，ID3v2.4 SYLT，FLAC 封面 + VORBIS_COMMENT，Ogg Vorbis；每十个文件有一个没有歌词
+static std::string synthetic_tag(int index, std::string *extension) {
+    std::string lrc = index % 10 == 9 ? std::string() : synthetic_lrc(index);
+    std::string cover(64 << 10, '\x5A');
+    switch (index % 4) {
+    case 0: {
+        *extension = ".mp3";
+        std::string frames = "APIC" + be32(static_cast<uint32_t>(cover.size() + 14)) + std::string(2, '\0') + std::string("\x00image/jpeg\x00\x03\x00", 14) + cover;
+        if (!lrc.empty()) frames += "USLT" + be32(static_cast<uint32_t>(lrc.size() + 5)) + std::string(2, '\0') + std::string("\x03zho\x00", 5) + lrc;
+        return "ID3\x03" + std::string(2, '\0') + synchsafe(static_cast<uint32_t>(frames.size())) + frames;
+    }
+    case 1: {
+        *extension = ".mp3";
+        std::string sylt = std::string("\x03zho\x02\x01\x00", 7);
+        for (int i = 0; i < 40 && !lrc.empty(); ++i) sylt += "第 " + std::to_string(i + 1) + " 行" + '\0' + be32(static_cast<uint32_t>(i * 5000));
+        std::string frames = "TIT2" + synchsafe(7) + std::string(2, '\0') + std::string("\x03title", 6) + '\0';
+        if (!lrc.empty()) frames += "SYLT" + synchsafe(static_cast<uint32_t>(sylt.size())) + std::string(2, '\0') + sylt;
+        return "ID3\x04" + std::string(2, '\0') + synchsafe(static_cast<uint32_t>(frames.size())) + frames;
+    }
+    case 2: {
+        *extension = ".flac";
+        std::string comment = le32(9) + "reference" + le32(lrc.empty() ? 1 : 2) + le32(10) + "TITLE=test";
+        if (!lrc.empty()) comment += le32(static_cast<uint32_t>(lrc.size() + 7)) + "LYRICS=" + lrc;
+        return "fLaC" + std::string("\x00\x00\x00\x22", 4) + std::string(34, '\0') + '\x06' + be32(static_cast<uint32_t>(cover.size())).substr(1) + cover + '\x84' + be32(static_cast<uint32_t>(comment.size())).substr(1) + comment;
+    }
+    default: {
+        *extension = ".ogg";
+        std::string packets[] = {"\x01vorbis" + std::string(23, '\0'), "\x03vorbis" + le32(9) + "reference" + le32(lrc.empty() ? 0 : 1) + (lrc.empty() ? std::string() : le32(static_cast<uint32_t>(lrc.size() + 7)) + "LYRICS=" + lrc)};
+        std::string out;
+        for (int page = 0; page < 2; ++page) {
+            const std::string &packet = packets[page];
+            std::string lacing(packet.size() / 255, '\xFF');
+            lacing.push_back(static_cast<char>(packet.size() % 255));
+            out += std::string("OggS\0", 5) + static_cast<char>(page == 0 ? 2 : 0) + std::string(8, '\0') + le32(1) + le32(static_cast<uint32_t>(page)) + std::string(4, '\0') + static_cast<char>(lacing.size()) + lacing + packet;
+        }
+        return out;
+    }
+    }
+}
+
+static bool generate_library(const std::string &dir, int count, std::vector<std::string> *paths) {
+    for (int i = 0; i < count; ++i) {
+        std::string extension, tag = synthetic_tag(i, &extension);
+        std::string path = dir + "/" + std::to_string(i) + extension;
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        bool ok = write(fd, tag.data(), tag.size()) == static_cast<ssize_t>(tag.size()) && ftruncate(fd, static_cast<off_t>(tag.size()) + (8 << 20)) == 0;
+        close(fd);
+        if (!ok) return false;
+        paths->push_back(path);
+    }
+    // 写回脏页，之后 POSIX_FADV_DONTNEED 才能真正丢掉
+    sync();
+    return true;
+}
+
+static void scan_library(const std::string &dir, size_t limit, std::vector<std::string> *paths) {
+    DIR *d = opendir(dir.c_str());
+    if (!d) return;
+    while (struct dirent *entry = readdir(d)) {
+        if (paths->size() >= limit) break;
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") continue;
+        std::string path = dir + "/" + name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) { scan_library(path, limit, paths); continue; }
+        static const char *const kExtensions[] = {".mp3", ".flac", ".ogg", ".opus"};
+        for (const char *extension : kExtensions) {
+            size_t n = strlen(extension);
+            if (name.size() > n && strcasecmp(name.c_str() + name.size() - n, extension) == 0) { paths->push_back(path); break; }
+        }
+    }
+    closedir(d);
+}
+
+static void drop_cache(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+// 文件在页缓存里的页数（mmap 本身不读入页，mincore 只查询）
+static size_t resident_pages(const std::string &path, size_t *total_pages) {
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    size_t resident = 0;
+    *total_pages = 0;
+    if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0) {
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t pages = (static_cast<size_t>(st.st_size) + page - 1) / page;
+        void *addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        std::vector<unsigned char> vec(pages);
+        if (addr != MAP_FAILED) {
+            if (mincore(addr, static_cast<size_t>(st.st_size), vec.data()) == 0) for (unsigned char v : vec) resident += v & 1;
+            munmap(addr, static_cast<size_t>(st.st_size));
+        }
+        *total_pages = pages;
+    }
+    if (fd >= 0) close(fd);
+    return resident;
+}
+
+int main(int argc, char **argv) {
+    std::string dir;
+    size_t limit = 10000;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--files") == 0 && i + 1 < argc) limit = static_cast<size_t>(atol(argv[++i]));
+        else dir = argv[i];
+    }
+    std::vector<std::string> paths;
+    char tmp[] = "/tmp/bench_tag_lyrics.XXXXXX";
+    bool generated = dir.empty();
+    if (generated) {
+        if (!mkdtemp(tmp)) { perror("mkdtemp"); return 1; }
+        dir = tmp;
+        if (!generate_library(dir, static_cast<int>(limit), &paths)) { perror("generate"); return 1; }
+    } else {
+        scan_library(dir, limit, &paths);
+    }
+    if (paths.empty()) { fprintf(stderr, "no audio files under %s\n", dir.c_str()); return 1; }
+
+    size_t found = 0, synced = 0, resident = 0, total = 0, max_resident = 0;
+    int64_t elapsed_us = 0, max_us = 0;
+    long minflt = 0, majflt = 0;
+    for (const std::string &path : paths) {
+        drop_cache(path);
+        struct rusage before, after;
+        getrusage(RUSAGE_SELF, &before);
+        auto start = std::chrono::steady_clock::now();
+        provider_lyrics_t lyrics;
+        bool hit = read_embedded_lyrics(path, &lyrics);
+        int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        getrusage(RUSAGE_SELF, &after);
+        elapsed_us += us;
+        max_us = std::max(max_us, us);
+        minflt += after.ru_minflt - before.ru_minflt;
+        majflt += after.ru_majflt - before.ru_majflt;
+        found += hit;
+        synced += hit && !lyrics.timeline.empty();
+        size_t pages, r = resident_pages(path, &pages);
+        resident += r;
+        total += pages;
+        max_resident = std::max(max_resident, r);
+    }
+    double n = static_cast<double>(paths.size());
+    printf("files            %zu (%zu with lyrics, %zu synchronized)\n", paths.size(), found, synced);
+    printf("time             %.1f us/file avg, %lld us max, %.1f ms total\n", elapsed_us / n, static_cast<long long>(max_us), elapsed_us / 1000.0);
+    printf("page faults      %.2f minor + %.2f major per file\n", minflt / n, majflt / n);
+    printf("page cache       %.1f of %.1f pages resident per file after read (%.2f%%), %zu max\n", resident / n, total / n, total ? 100.0 * resident / total : 0.0, max_resident);
+    if (generated) {
+        for (const std::string &path : paths) unlink(path.c_str());
+        rmdir(dir.c_str());
+    }
+    return 0;
+}
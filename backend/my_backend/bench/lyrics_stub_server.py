@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+# 本地 HTTP 歌词桩服务器，用来手动测试 HTTP 歌词来源：
+#   bench/lyrics_stub_server.py [--port 8765] [--latency-ms 200] [--hit-rate 0.5] [--dir ~/Music]
+#   MUSICFOX_LYRICS_URL='http://127.0.0.1:8765/lyrics?artist={artist}&title={title}' music-info-service
+# 有 --dir 时按 "<歌手> - <标题>.lrc" 或 "<标题>.lrc" 找文件，否则按命中率返回一份合成歌词；找不到返回 404。
+# 每个请求打印一行日志，SIGUSR1 看服务端的 provider 统计即可对照命中率和耗时。
+import argparse
+import os
+import random
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+
+def synthetic_lyrics(title):
+    return "".join("[%02d:%02d.00]%s 第 %d 行\n" % (i * 4 // 60, i * 4 % 60, title, i + 1) for i in range(60))
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--latency-ms", type=int, default=0)
+    parser.add_argument("--hit-rate", type=float, default=1.0)
+    parser.add_argument("--dir")
+    args = parser.parse_args()
+
+    class Handler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.0"
+
+        def do_GET(self):
+            query = parse_qs(urlparse(self.path).query)
+            artist = query.get("artist", [""])[0]
+            title = query.get("title", [""])[0]
+            time.sleep(args.latency_ms / 1000.0)
+            body = None
+            if args.dir:
+                for name in ("%s - %s.lrc" % (artist, title), "%s.lrc" % title):
+                    path = os.path.join(os.path.expanduser(args.dir), name)
+                    if os.path.isfile(path):
+                        with open(path, "rb") as f:
+                            body = f.read()
+                        break
+            elif random.random() < args.hit_rate:
+                body = synthetic_lyrics(title).encode("utf-8")
+            self.send_response(200 if body is not None else 404)
+            body = body if body is not None else b"not found"
+            self.send_header("Content-Type", "text/plain; charset=utf-8")
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+    server = ThreadingHTTPServer(("127.0.0.1", args.port), Handler)
+    print("Serving lyrics on http://127.0.0.1:%d/lyrics?artist={artist}&title={title}" % args.port)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,82 @@
+#!/bin/sh
+# 多会话守护模式与多进程的资源对比。
+# 起 N 条私有会话总线，先给每条总线各起一个 music-info-service（N 个进程），
+# 再用一个 music-info-service --bus <地址> ... 服务全部总线，各自运行 DURATION 秒后汇总：
+#   rss_kib  VmRSS 之和（多进程时共享库页面被重复计算）
+#   pss_kib  Pss 之和（共享页面按进程数均摊，更接近真实占用）
+#   cpu_ms   utime + stime 之和
+# 用法: bench/multi_session.sh <music-info-service> [N=4] [DURATION=30]
+# 设置 PLAYER_CMD 时在每条总线上各启动一个播放器（例如 PLAYER_CMD=musicfox），测的是播放时的开销；
+# 不设置时服务只在等待 musicfox 出现，测的是空闲开销。需要 dbus-daemon。
+set -eu
+
+SERVICE=${1:?usage: $0 <music-info-service> [N] [DURATION]}
+N=${2:-4}
+DURATION=${3:-30}
+WORKDIR=$(mktemp -d)
+PIDS=""
+
+cleanup() {
+    for pid in $PIDS; do kill "$pid" 2>/dev/null || true; done
+    rm -rf "$WORKDIR"
+}
+trap cleanup EXIT INT TERM
+
+# 起 N 条总线，地址写到 $WORKDIR/bus.<i>
+i=1
+while [ "$i" -le "$N" ]; do
+    dbus-daemon --session --fork --address="unix:path=$WORKDIR/bus.$i.sock" --print-pid=1 > "$WORKDIR/daemon.$i"
+    PIDS="$PIDS $(cat "$WORKDIR/daemon.$i")"
+    echo "unix:path=$WORKDIR/bus.$i.sock" > "$WORKDIR/bus.$i"
+    if [ -n "${PLAYER_CMD:-}" ]; then
+        DBUS_SESSION_BUS_ADDRESS=$(cat "$WORKDIR/bus.$i") sh -c "$PLAYER_CMD" > /dev/null 2>&1 &
+        PIDS="$PIDS $!"
+    fi
+    i=$((i + 1))
+done
+
+# 对一组进程求和：VmRSS、Pss（kB）和 CPU 时间（时钟滴答）
+sample() {
+    rss=0; pss=0; ticks=0
+    for pid in "$@"; do
+        r=$(awk '/^VmRSS:/ { print $2 }' "/proc/$pid/status")
+        p=$(awk '/^Pss:/ { print $2 }' "/proc/$pid/smaps_rollup" 2>/dev/null || echo 0)
+        t=$(awk '{ print $14 + $15 }' "/proc/$pid/stat")
+        rss=$((rss + r)); pss=$((pss + ${p:-0})); ticks=$((ticks + t))
+    done
+    echo "$rss $pss $ticks"
+}
+
+# 启动完成后的 CPU 不计入：等 2 秒再取起点
+measure() {
+    label=$1; shift
+    sleep 2
+    start=$(sample "$@" | awk '{ print $3 }')
+    sleep "$DURATION"
+    set -- $(sample "$@") "$start"
+    hz=$(getconf CLK_TCK)
+    echo "$label: sessions=$N rss_kib=$1 pss_kib=$2 cpu_ms=$(( ($3 - $4) * 1000 / hz )) over ${DURATION}s"
+}
+
+# N 个独立进程
+SERVICE_PIDS=""
+i=1
+while [ "$i" -le "$N" ]; do
+    DBUS_SESSION_BUS_ADDRESS=$(cat "$WORKDIR/bus.$i") "$SERVICE" > /dev/null 2>&1 &
+    SERVICE_PIDS="$SERVICE_PIDS $!"
+    i=$((i + 1))
+done
+measure "separate" $SERVICE_PIDS
+for pid in $SERVICE_PIDS; do kill "$pid"; wait "$pid" 2>/dev/null || true; done
+
+# 一个进程服务全部总线
+ARGS=""
+i=1
+while [ "$i" -le "$N" ]; do
+    ARGS="$ARGS --bus $(cat "$WORKDIR/bus.$i")"
+    i=$((i + 1))
+done
+"$SERVICE" $ARGS > /dev/null 2>&1 &
+DAEMON_PID=$!
+PIDS="$PIDS $DAEMON_PID"
+measure "daemon" $DAEMON_PID
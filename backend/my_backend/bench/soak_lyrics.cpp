@@ -0,0 +1,311 @@
+// 虚拟时间长时间播放测试：用 ManualClock 驱动 LyricEngine 连续播放上万首合成曲目，
+// 期间随机跳转、暂停、变速和重复元数据风暴，统计内存、分配次数、换行误差、每模拟小时的 CPU 时间、
+// 发出次数，以及客户端按时钟锚点外推的位置与引擎预测的最大偏差，
+// 超出基线容差时返回非零。tick 与服务一样排在 next_line_time_us() 给出的换行时刻，
+// 每次喂给引擎输入后重新安排，另有 1 秒一次的兜底 tick。
+// 用法: soak_lyrics [--tracks N] [--seed S] [--baseline FILE] [--write-baseline FILE]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "lyric_engine.h"
+
+// --- 分配计数 ---
+static std::atomic<uint64_t> g_allocations{0};
+void *operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+static int64_t rss_kib() {
+    long pages = 0, resident = 0;
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    if (fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+    fclose(f);
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+static double cpu_seconds() {
+    struct rusage usage; getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// --- 模拟的播放器 ---
+struct SimTrack {
+    std::string trackid, artist, title, lrc;
+    int64_t duration_us;
+    std::vector<int64_t> stamps;  // 每行开始时间，与引擎解析出的时间轴一致
+};
+
+static SimTrack make_track(std::mt19937_64 &rng, int index) {
+    SimTrack track;
+    track.trackid = "/org/musicfox/track/" + std::to_string(index);
+    track.artist = "歌手" + std::to_string(index % 97);
+    track.title = "曲目" + std::to_string(index);
+    track.duration_us = std::uniform_int_distribution<int64_t>(120, 360)(rng) * 1000000;
+    // 约 8% 的曲目没有歌词
+    if (rng() % 100 < 8) return track;
+    std::uniform_int_distribution<int64_t> gap_cs(150, 600);
+    char stamp[32];
+    for (int64_t cs = gap_cs(rng); cs * 10000 < track.duration_us; cs += gap_cs(rng)) {
+        snprintf(stamp, sizeof(stamp), "[%02d:%02d.%02d]", static_cast<int>(cs / 6000), static_cast<int>(cs / 100 % 60), static_cast<int>(cs % 100));
+        track.lrc += stamp; track.lrc += "第" + std::to_string(track.stamps.size()) + "行 故事的小黄花\n";
+        track.stamps.push_back(cs * 10000);
+    }
+    return track;
+}
+
+static PlayerUpdate metadata_update(const SimTrack &track, bool is_playing) {
+    PlayerUpdate update;
+    update.has_status = true; update.is_playing = is_playing;
+    update.has_metadata = true;
+    update.metadata.trackid = track.trackid; update.metadata.artist = track.artist; update.metadata.title = track.title; update.metadata.duration_us = track.duration_us;
+    if (!track.lrc.empty()) { update.has_lyrics = true; update.lyrics = track.lrc; }
+    return update;
+}
+
+struct SoakResult {
+    int tracks = 0;
+    double simulated_hours = 0, wall_seconds = 0, cpu_ms_per_sim_hour = 0;
+    double allocations_per_sim_hour = 0;
+    int64_t rss_start_kib = 0, rss_end_kib = 0, rss_growth_kib = 0;
+    double switch_error_p50_ms = 0, switch_error_p99_ms = 0;
+    size_t switches_measured = 0;
+    double coalescing_ratio = 0;
+    double emits_per_sim_hour = 0;
+    double anchor_error_max_ms = 0;
+};
+
+static SoakResult run_soak(int track_count, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    ManualClock clock(1000000);
+    // 播放器端的真实状态
+    const SimTrack *track = nullptr;
+    int64_t true_position_us = 0;
+    bool playing = true;
+    double rate = 1.0;
+    // 换行误差：引擎自然前进到下一行的那一刻，播放器真实位置距该行起点多远（媒体时间）。
+    // 用 0.1ms 精度的定长直方图统计，最后一格收 100 秒以上，测试过程中不再分配
+    std::vector<uint64_t> error_histogram(1000001, 0);
+    uint64_t switches = 0;
+
+    // 位置查询的回复：播放器在请求后 1~10ms 读位置，再过 1~10ms 送达
+    struct PendingSample { int64_t deliver_at_us; int64_t position_us; uint64_t generation; };
+    std::vector<PendingSample> pending;
+    std::vector<uint64_t> requests;
+
+    EngineCallbacks callbacks;
+    callbacks.request_position = [&](uint64_t generation) { requests.push_back(generation); };
+    // 客户端视角：只保存最近一次收到的时钟锚点，每一步都用它外推位置，和引擎的预测对比
+    uint64_t emits = 0;
+    clock_model_t client_anchor = {};
+    bool client_playing = false;
+    int64_t anchor_error_max_us = 0;
+    callbacks.emit_state = [&](const EngineState &state) {
+        emits++;
+        client_anchor.anchor_time_us = state.anchor_time_us; client_anchor.anchor_position_us = state.anchor_position_us; client_anchor.rate = state.rate;
+        client_playing = state.is_playing;
+    };
+    LyricEngine engine(clock, std::move(callbacks));
+
+    std::uniform_int_distribution<int64_t> latency_us(1000, 10000);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    auto note_engine_line = [&](int previous_index) {
+        int k = engine.line_index();
+        if (!track || k < 0 || k != previous_index + 1) return;
+        int64_t bucket = std::abs(true_position_us - track->stamps[k]) / 100;
+        error_histogram[std::min<int64_t>(bucket, error_histogram.size() - 1)]++;
+        switches++;
+    };
+    auto advance_to = [&](int64_t t_us) {
+        int64_t t0 = clock.now_us();
+        if (t_us <= t0) return;
+        if (playing) true_position_us += static_cast<int64_t>((t_us - t0) * rate);
+        clock.set(t_us);
+    };
+
+    std::vector<SimTrack> recent;  // 只保留当前曲目，旧曲目释放
+    int64_t rss_start = 0;
+    double cpu_start = cpu_seconds();
+    uint64_t alloc_start = g_allocations.load();
+    int64_t sim_start_us = clock.now_us();
+    auto wall_start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < track_count; ++i) {
+        if (i == track_count / 10) rss_start = rss_kib();
+        recent.clear();
+        recent.push_back(make_track(rng, i));
+        track = &recent.back();
+        // 播放器换歌后自动开始播放
+        true_position_us = 0;
+        playing = true;
+        engine.on_player_update(metadata_update(*track, playing));
+
+        int64_t next_fallback = clock.now_us() + 1000000;
+        int64_t next_line = engine.next_line_time_us();
+        int64_t next_sync = clock.now_us() + 1000000;
+        int64_t next_event = clock.now_us() + std::uniform_int_distribution<int64_t>(5, 40)(rng) * 1000000;
+        while (true_position_us < track->duration_us) {
+            int64_t next_delivery = pending.empty() ? INT64_MAX : pending.front().deliver_at_us;
+            int64_t next_tick = next_line < 0 ? next_fallback : std::min(next_line, next_fallback);
+            int64_t t = std::min({next_tick, next_sync, next_event, next_delivery});
+            advance_to(t);
+            // 引擎发出的位置请求：按延迟安排回复
+            for (uint64_t generation : requests) {
+                int64_t read_at = clock.now_us() + latency_us(rng);
+                int64_t position = true_position_us + (playing ? static_cast<int64_t>((read_at - clock.now_us()) * rate) : 0);
+                pending.push_back({read_at + latency_us(rng), position, generation});
+            }
+            requests.clear();
+            std::sort(pending.begin(), pending.end(), [](const PendingSample &a, const PendingSample &b) { return a.deliver_at_us < b.deliver_at_us; });
+
+            int previous = engine.line_index();
+            if (t == next_delivery) {
+                PendingSample sample = pending.front();
+                pending.erase(pending.begin());
+                engine.on_position_sample(sample.position_us, sample.generation);
+            } else if (t == next_tick) {
+                engine.tick();
+                if (t == next_fallback) next_fallback += 1000000;
+            } else if (t == next_sync) {
+                requests.push_back(engine.generation());
+                next_sync += 1000000;
+            } else {
+                int roll = percent(rng);
+                if (roll < 35) {
+                    // 跳转
+                    true_position_us = std::uniform_int_distribution<int64_t>(0, track->duration_us - 1)(rng);
+                    engine.on_seek(true_position_us);
+                    previous = engine.line_index();  // 跳转造成的换行不计入
+                } else if (roll < 60) {
+                    // 暂停/继续
+                    playing = !playing;
+                    PlayerUpdate update; update.has_status = true; update.is_playing = playing;
+                    engine.on_player_update(update);
+                } else if (roll < 75) {
+                    // 变速
+                    static const double kRates[] = { 0.75, 1.0, 1.25, 1.5 };
+                    rate = kRates[rng() % 4];
+                    PlayerUpdate update; update.has_rate = true; update.rate = rate;
+                    engine.on_player_update(update);
+                } else {
+                    // 元数据风暴：同一首歌的完整元数据连发几十次，与服务一样在一轮主循环内合并
+                    int storm = std::uniform_int_distribution<int>(5, 50)(rng);
+                    for (int n = 0; n < storm; ++n) engine.queue_player_update(metadata_update(*track, playing));
+                    engine.flush_player_updates();
+                }
+                next_event = clock.now_us() + std::uniform_int_distribution<int64_t>(5, 40)(rng) * 1000000;
+            }
+            note_engine_line(previous);
+            int64_t anchor_error_us = std::abs(clock_predict_us(client_anchor, client_playing, clock.now_us()) - engine.predicted_position_us());
+            anchor_error_max_us = std::max(anchor_error_max_us, anchor_error_us);
+            // 与 schedule_line_boundary 一样，任何输入之后都重新安排换行 tick
+            next_line = engine.next_line_time_us();
+        }
+    }
+
+    SoakResult result;
+    result.tracks = track_count;
+    result.simulated_hours = (clock.now_us() - sim_start_us) / 3600e6;
+    result.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    result.cpu_ms_per_sim_hour = (cpu_seconds() - cpu_start) * 1000.0 / result.simulated_hours;
+    result.allocations_per_sim_hour = (g_allocations.load() - alloc_start) / result.simulated_hours;
+    result.rss_start_kib = rss_start;
+    result.rss_end_kib = rss_kib();
+    result.rss_growth_kib = result.rss_end_kib - result.rss_start_kib;
+    result.switches_measured = switches;
+    result.emits_per_sim_hour = emits / result.simulated_hours;
+    result.anchor_error_max_ms = anchor_error_max_us / 1000.0;
+    result.coalescing_ratio = static_cast<double>(engine.metrics().updates_received) / std::max<uint64_t>(engine.metrics().updates_applied, 1);
+    auto percentile_ms = [&](uint64_t rank) {
+        uint64_t seen = 0;
+        for (size_t i = 0; i < error_histogram.size(); ++i) {
+            seen += error_histogram[i];
+            if (seen > rank) return i / 10.0;
+        }
+        return (error_histogram.size() - 1) / 10.0;
+    };
+    if (switches) {
+        result.switch_error_p50_ms = percentile_ms(switches / 2);
+        result.switch_error_p99_ms = percentile_ms(switches * 99 / 100);
+    }
+    return result;
+}
+
+// --- 基线 ---
+static std::map<std::string, double> result_values(const SoakResult &r) {
+    return {
+        {"cpu_ms_per_sim_hour", r.cpu_ms_per_sim_hour},
+        {"allocations_per_sim_hour", r.allocations_per_sim_hour},
+        {"rss_growth_kib", static_cast<double>(r.rss_growth_kib)},
+        {"switch_error_p50_ms", r.switch_error_p50_ms},
+        {"switch_error_p99_ms", r.switch_error_p99_ms},
+        {"emits_per_sim_hour", r.emits_per_sim_hour},
+        {"anchor_error_max_ms", r.anchor_error_max_ms},
+    };
+}
+
+// 容差：CPU 受机器和负载影响大，给两倍；分配次数和换行误差是确定性的，给小余量；RSS 增长给绝对余量。
+// 换行误差只剩位置采样的延迟误差（p50 约 6ms），绝对余量 1ms，定时回退到粗粒度 tick 时立即报出
+static bool within_tolerance(const std::string &key, double value, double baseline) {
+    if (key == "cpu_ms_per_sim_hour") return value <= baseline * 2.0;
+    if (key == "allocations_per_sim_hour") return value <= baseline * 1.05 + 100;
+    if (key == "rss_growth_kib") return value <= baseline + 2048;
+    if (key == "switch_error_p50_ms" || key == "switch_error_p99_ms") return value <= baseline * 1.10 + 1.0;
+    // 锚点偏差有硬上限，与基线无关
+    if (key == "anchor_error_max_ms") return value <= LyricEngine::kAnchorToleranceUs / 1000.0;
+    return value <= baseline * 1.10 + 5.0;
+}
+
+int main(int argc, char *argv[]) {
+    int tracks = 10000;
+    uint64_t seed = 20240601;
+    std::string baseline_path, write_path;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--tracks") && i + 1 < argc) tracks = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--baseline") && i + 1 < argc) baseline_path = argv[++i];
+        else if (!strcmp(argv[i], "--write-baseline") && i + 1 < argc) write_path = argv[++i];
+        else { std::cerr << "usage: " << argv[0] << " [--tracks N] [--seed S] [--baseline FILE] [--write-baseline FILE]" << std::endl; return 2; }
+    }
+
+    SoakResult r = run_soak(tracks, seed);
+    std::cout << "tracks: " << r.tracks << ", simulated hours: " << r.simulated_hours << ", wall seconds: " << r.wall_seconds << std::endl;
+    std::cout << "rss_start_kib: " << r.rss_start_kib << ", rss_end_kib: " << r.rss_end_kib << ", switches measured: " << r.switches_measured << ", coalescing ratio: " << r.coalescing_ratio << std::endl;
+    std::map<std::string, double> values = result_values(r);
+    for (const auto &kv : values) std::cout << kv.first << ": " << kv.second << std::endl;
+
+    if (!write_path.empty()) {
+        std::ofstream out(write_path);
+        for (const auto &kv : values) out << kv.first << " " << kv.second << "\n";
+    }
+    if (baseline_path.empty()) return 0;
+
+    std::ifstream in(baseline_path);
+    if (!in) { std::cerr << "cannot read baseline " << baseline_path << std::endl; return 2; }
+    std::string key; double baseline; int regressions = 0;
+    while (in >> key >> baseline) {
+        auto it = values.find(key);
+        if (it == values.end() || within_tolerance(key, it->second, baseline)) continue;
+        std::cerr << "REGRESSION " << key << ": " << it->second << " (baseline " << baseline << ")" << std::endl;
+        regressions++;
+    }
+    return regressions ? 1 : 0;
+}
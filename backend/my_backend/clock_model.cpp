@@ -0,0 +1,24 @@
+#include "clock_model.h"
+
+#include <chrono>
+
+int64_t clock_now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void clock_sync(clock_model_t &clock, int64_t position_us, int64_t now_us) {
+    clock.anchor_position_us = position_us;
+    clock.anchor_time_us = now_us;
+}
+
+int64_t clock_predict_us(const clock_model_t &clock, bool is_playing, int64_t now_us) {
+    if (!is_playing) return clock.anchor_position_us;
+    int64_t elapsed_us = now_us - clock.anchor_time_us;
+    if (clock.rate == 1.0) return clock.anchor_position_us + elapsed_us;
+    return clock.anchor_position_us + static_cast<int64_t>(static_cast<double>(elapsed_us) * clock.rate);
+}
+
+void clock_set_rate(clock_model_t &clock, double rate, bool is_playing, int64_t now_us) {
+    clock_sync(clock, clock_predict_us(clock, is_playing, now_us), now_us);
+    clock.rate = rate;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+// 播放位置的时钟模型：记住最近一次从播放器同步到的位置（锚点）和同步时刻，
+// 播放中按经过的单调时间乘以播放速率外推，暂停时停在锚点。时间都由调用方传入，便于测试。
+
+typedef struct { int64_t anchor_position_us; int64_t anchor_time_us; double rate = 1.0; } clock_model_t;
+
+// 单调时钟（steady_clock），微秒
+int64_t clock_now_us();
+
+void clock_sync(clock_model_t &clock, int64_t position_us, int64_t now_us);
+int64_t clock_predict_us(const clock_model_t &clock, bool is_playing, int64_t now_us);
+// 改变播放速率：先在当前预测位置重新取锚点，之前经过的时间仍按旧速率计算
+void clock_set_rate(clock_model_t &clock, double rate, bool is_playing, int64_t now_us);
+
+// 可注入的时钟：引擎通过它取当前时间，测试和基准用 ManualClock 以虚拟时间驱动
+class EngineClock {
+public:
+    virtual ~EngineClock() = default;
+    virtual int64_t now_us() = 0;
+};
+
+class SteadyClock : public EngineClock {
+public:
+    int64_t now_us() override { return clock_now_us(); }
+};
+
+class ManualClock : public EngineClock {
+public:
+    explicit ManualClock(int64_t start_us = 0) : now_(start_us) {}
+    int64_t now_us() override { return now_; }
+    void advance(int64_t delta_us) { now_ += delta_us; }
+    void set(int64_t now_us) { now_ = now_us; }
+private:
+    int64_t now_;
+};
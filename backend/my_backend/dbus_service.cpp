@@ -1,234 +1,1070 @@
 #include <iostream>
 #include <gio/gio.h>
+#include <glib-unix.h>
+#include <pwd.h>
+#include <signal.h>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
 #include <string>
 #include <vector>
-#include <regex>
-#include <algorithm>
-#include <chrono>
 #include <unistd.h>
-#include <sstream> // 确保包含 sstream
-
-#include "music-info-service-generated.h"
-
-// --- 数据结构、全局变量 (与之前相同) ---
-struct LyricLine { gint64 timestamp_us; std::string text; };
-typedef struct { std::string trackid; std::string artist; std::string title; gint64 duration_us; bool is_playing; } music_t;
-typedef struct { GDBusConnection *connection; std::string bus_name; } AppContext;
-
-static music_t g_current_music = {};
-static std::vector<LyricLine> g_parsed_lyrics;
-static std::string g_current_lyric_text = "";
-static std::chrono::steady_clock::time_point g_last_sync_time;
-static gint64 g_last_sync_position_us = 0;
-static MusicInfoServicePlayer *g_player_skeleton = nullptr;
-static GDBusObjectManagerServer *g_object_manager = nullptr;
-
-// --- 函数声明 (与之前相同) ---
-static std::vector<LyricLine> parse_lrc(const std::string &lrc_text);
-static void update_and_emit_signal(gint64 display_position_us);
+
+#include "player_interface.h"
+#include "deadline_source.h"
+#include "lyric_engine.h"
+#include "lyric_layout.h"
+#include "lrc_index.h"
+#include "lyric_providers.h"
+#include "tag_lyrics.h"
+#include "audio_latency.h"
+#include "romanization.h"
+#include "timeline_snapshot.h"
+#include "trace_ring.h"
+
+// D-Bus 适配层：把 MPRIS 信号翻译成 LyricEngine 的输入事件，把引擎输出发布到 Player 接口。
+// 默认只服务当前用户的会话总线；守护模式（--bus <地址>，可重复；或 --all-users 服务 /run/user/*/bus）下
+// 一个进程服务多条会话总线，每条总线一个 Session：各自的引擎、导出对象、本地歌词库、定时器和输出设备，互不影响。
+// 时钟、后台线程池、罗马音词典（只读静态数据）和歌词解析结果（SharedLyricCache）在会话之间共用。
+
+// --- 数据结构、全局变量 ---
+// 消费者通过 Subscribe 登记的发送档位，越往后要求越高；会话按所有消费者里最高的一档工作
+typedef enum { TIER_OFF, TIER_LYRIC, TIER_PROGRESS_10HZ, TIER_PROGRESS_60HZ } emission_tier_t;
+static const char *const kTierNames[] = { "off", "lyric", "progress-10hz", "progress-60hz" };
+// sender 为调用方的唯一名，断开总线时由 watch_id 的回调取消
+typedef struct { std::string sender; emission_tier_t tier; guint watch_id; } subscriber_t;
+
+// 一条会话总线上的全部状态，只在主线程访问。异步调用、信号订阅和后台任务各持有一个引用，
+// session_close 之后等引用归零才释放引擎和歌词库
+typedef struct {
+    int refs;
+    bool closed;
+    GDBusConnection *connection;
+    std::string address;        // 总线地址；默认模式下为空
+    std::string label;          // 日志前缀，默认模式下为空
+    std::string bus_name;       // musicfox 的 MPRIS 名，找到之前为空
+    std::string home_dir, config_dir, runtime_dir, lrc_cache_path;
+    std::string pulse_server;   // 空表示默认的声音服务
+    PlayerInterface *player;
+    LyricEngine *engine;
+    LrcIndex *lrc_index;
+    // 播放器没给歌词时的来源流水线（本地歌词库、HTTP 歌词服务），lyric_request 是正在进行的查找
+    LyricPipeline *lyric_pipeline;
+    uint64_t lyric_request;
+    guint owner_id, discover_timer_id, sync_timer_id, fallback_timer_id, progress_timer_id, flush_source_id;
+    guint mpris_sub_id, seeked_sub_id, tracklist_sub_id, screensaver_sub_id;
+    gulong closed_handler_id;
+    bool discovering;
+    // 换行调度：在下一行开始的时刻用 timerfd 精确触发，锁屏时放宽余量
+    GSource *line_source;
+    bool screen_idle;
+    latency_stat_t line_lateness;
+    // 输出延迟补偿：全局偏移 + 当前 sink 的偏移，配置在该用户的 ~/.config/musicfox-lyric/latency.conf
+    LatencyTable latency_table;
+    std::string current_sink;
+    bool sink_probe_running;
+    bool prefetch_in_flight;
+    // 消费者为空时档位为 TIER_OFF：不同步位置、不排换行定时器、不发信号
+    std::vector<subscriber_t> subscribers;
+    emission_tier_t tier;
+} Session;
+
+static SteadyClock g_steady_clock;
+static GMainLoop *g_loop = nullptr;
+static int g_exit_code = 0;
+// main 开始的时刻（CLOCK_MONOTONIC 微秒），启动耗时日志用
+static gint64 g_start_us = 0;
+static std::vector<Session*> g_sessions;
+static bool g_daemon_mode = false;
+static bool g_all_users = false;
+// 守护模式下连不上或名字被占用的总线，之后扫描时跳过
+static std::vector<std::string> g_skipped_buses;
+// 守护模式下各会话共用的歌词解析结果
+static SharedLyricCache *g_shared_lyrics = nullptr;
+static GThreadPool *g_romanization_pool = nullptr;
+// 长行分段：顶栏标签能放下的列数（东亚宽字符 2 列），MUSICFOX_PANEL_COLUMNS 配置，0 关闭
+static const int kDefaultPanelColumns = 34;
+static int g_panel_columns = kDefaultPanelColumns;
+static GThreadPool *g_layout_pool = nullptr;
+// PropertiesChanged 合并窗口（毫秒），MUSICFOX_COALESCE_MS 配置；0 表示合并到本轮主循环空闲时
+static guint g_coalesce_window_ms = 0;
+static const gint64 kPreciseSlackUs = 50;
+static const gint64 kRelaxedSlackUs = 50000;
+// MUSICFOX_PRECISE_TIMING=0 始终宽松
+static bool g_precise_timing = true;
+// MUSICFOX_LYRIC_OFFSET_MS 覆盖各用户配置里的全局偏移
+static bool g_has_offset_override = false;
+static gint64 g_offset_override_us = 0;
+// HTTP 歌词来源：MUSICFOX_LYRICS_URL 是 URL 模板（{artist}、{title}、{duration} 等），不设则不用；
+// 期限由 MUSICFOX_LYRICS_TIMEOUT_MS 配置。本地歌词库的期限固定
+static std::string g_lyrics_url;
+static int64_t g_lyrics_timeout_us = 3000000;
+static const int64_t kLocalLyricsDeadlineUs = 200000;
+// 还没交回主线程的流水线查找，退出前等它们都回来
+static int g_lookups_in_flight = 0;
+// 播放队列预取：跟随 MPRIS TrackList，在后台解析接下来一两首的歌词。MUSICFOX_PREFETCH=0 关闭
+static GThreadPool *g_prefetch_pool = nullptr;
+
+// --- 函数声明 ---
 static gboolean sync_position_from_dbus(gpointer user_data);
-static gboolean predictive_update(gpointer user_data);
-std::string find_musicfox_bus_name();
-
-// (find_musicfox_bus_name, parse_lrc, update_and_emit_signal 函数与之前版本完全相同, 为简洁省略)
-std::string find_musicfox_bus_name() {
-    GError *error = nullptr; GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SESSION, nullptr, &error);
-    if (!connection) { return ""; }
-    GVariant *result = g_dbus_connection_call_sync(connection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "ListNames", nullptr, G_VARIANT_TYPE("(as)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
-    std::string bus_name;
-    if (result) {
-        GVariantIter *iter; g_variant_get(result, "(as)", &iter); gchar *name;
-        while (g_variant_iter_next(iter, "s", &name)) {
-            if (std::string(name).find("org.mpris.MediaPlayer2.musicfox") == 0) { bus_name = name; g_free(name); break; }
-            g_free(name);
-        }
-        g_variant_iter_free(iter); g_variant_unref(result);
+static gboolean line_fallback_tick(gpointer user_data);
+static void report_metrics(Session *session);
+static void prefetch_upcoming(Session *session);
+static void schedule_line_boundary(Session *session);
+static void set_subscriber(Session *session, const std::string &sender, emission_tier_t tier);
+static void session_close(Session *session);
+
+// --- 会话引用计数 ---
+static Session *session_ref(Session *session) {
+    session->refs++;
+    return session;
+}
+static void session_unref(Session *session) {
+    if (--session->refs > 0) return;
+    delete session->engine;
+    // 先停流水线：本地歌词来源在它的线程上查歌词库
+    delete session->lyric_pipeline;
+    delete session->lrc_index;
+    g_object_unref(session->connection);
+    delete session;
+}
+static void session_release(gpointer data) { session_unref(static_cast<Session*>(data)); }
+
+// 没有消费者时不发；快照停在最后一次发出的状态，有人登记时 apply_tier 补发
+static void publish_state(Session *session, const EngineState &engine_state) {
+    if (!session->player || session->tier == TIER_OFF) return;
+    PlayerState state;
+    state.artist = engine_state.artist; state.title = engine_state.title; state.is_playing = engine_state.is_playing;
+    state.current_lyric = engine_state.lyric; state.current_segment = engine_state.segment; state.current_romanization = engine_state.romanization;
+    state.duration = static_cast<double>(engine_state.duration_us) / 1000000.0; state.position = static_cast<double>(engine_state.position_us) / 1000000.0;
+    state.line_start_us = engine_state.line_start_us; state.line_end_us = engine_state.line_end_us; state.next_lyric = engine_state.next_lyric;
+    state.anchor_monotonic_us = engine_state.anchor_time_us; state.anchor_position_us = engine_state.anchor_position_us; state.rate = engine_state.rate;
+    player_interface_publish(session->player, state);
+}
+
+// 本地 .lrc 歌词库查找，命中才 mmap 文件；预取线程也会调用
+static std::string lookup_local_lyrics(const Session *session, const std::string &artist, const std::string &title) {
+    if (!session->lrc_index) return "";
+    std::string path = session->lrc_index->find(artist, title);
+    if (path.empty()) return "";
+    MappedLrc mapped = MappedLrc::open(path);
+    if (!mapped.valid()) return "";
+    return std::string(mapped.text());
+}
+
+// --- 歌词来源流水线 ---
+// 引擎每首歌请求一次；新请求取消上一首还没结束的查找。结果在流水线线程上产生，通过 idle 回到主线程，
+// 每次查找持有一个会话引用，取消时回调照样来，引用在主线程释放。文本结果在流水线线程上解析，主线程只装时间轴
+typedef struct { Session *session; std::string provider; PrefetchedLyrics found; } lyric_lookup_job_t;
+static gboolean lyric_lookup_done(gpointer data) {
+    lyric_lookup_job_t *job = static_cast<lyric_lookup_job_t*>(data);
+    g_lookups_in_flight--;
+    if (!job->session->closed) {
+        if (!job->provider.empty()) std::cout << job->session->label << "Lyrics for " << job->found.trackid << " from " << job->provider << std::endl;
+        job->session->engine->on_lyrics_found(std::move(job->found));
+        schedule_line_boundary(job->session);
     }
-    g_object_unref(connection); return bus_name;
+    session_unref(job->session);
+    delete job;
+    return G_SOURCE_REMOVE;
 }
-std::vector<LyricLine> parse_lrc(const std::string &lrc_text) {
-    std::vector<LyricLine> lyrics; std::regex lrc_regex(R"(\[(\d{2}):(\d{2})\.(\d{2,3})\](.*))"); std::smatch match; std::stringstream ss(lrc_text); std::string line;
-    while (std::getline(ss, line)) {
-        if (std::regex_match(line, match, lrc_regex)) {
-            gint64 minutes = std::stoll(match[1].str()); gint64 seconds = std::stoll(match[2].str()); gint64 milliseconds = (match[3].str().length() == 2) ? std::stoll(match[3].str()) * 10 : std::stoll(match[3].str());
-            gint64 total_microseconds = (minutes * 60 + seconds) * 1000000 + milliseconds * 1000;
-            std::string text = match[4].str(); text.erase(0, text.find_first_not_of(" \t\r\n")); text.erase(text.find_last_not_of(" \t\r\n") + 1);
-            if (!text.empty()) { lyrics.push_back({total_microseconds, text}); }
-        }
+static void request_lyrics(Session *session, const music_t &music) {
+    if (!session->lyric_pipeline) return;
+    if (session->lyric_request) session->lyric_pipeline->cancel(session->lyric_request);
+    Session *ref = session_ref(session);
+    std::string trackid = music.trackid;
+    g_lookups_in_flight++;
+    session->lyric_request = session->lyric_pipeline->lookup(lyric_query_t{music.trackid, music.artist, music.title, music.url, music.duration_us}, [ref, trackid](lyric_result_t result) {
+        lyric_lookup_job_t *job = new lyric_lookup_job_t{ref, std::move(result.provider), PrefetchedLyrics()};
+        job->found.trackid = trackid;
+        job->found.payload = std::move(result.lyrics.text);
+        job->found.timeline = result.lyrics.timeline.empty() && !job->found.payload.empty() ? parse_lyric_payload(job->found.payload) : std::move(result.lyrics.timeline);
+        g_idle_add(lyric_lookup_done, job);
+    });
+}
+static LyricPipeline *lyric_pipeline_new(Session *session) {
+    std::vector<LyricProvider> providers;
+    LyricProvider local;
+    local.name = "lrc-dir";
+    local.deadline_us = kLocalLyricsDeadlineUs;
+    local.fetch = [session](const lyric_query_t &query, const std::atomic<bool> &) { return provider_lyrics_t{lookup_local_lyrics(session, query.artist, query.title), {}}; };
+    providers.push_back(std::move(local));
+    providers.push_back(tag_lyric_provider(kLocalLyricsDeadlineUs));
+    if (!g_lyrics_url.empty()) providers.push_back(http_lyric_provider(g_lyrics_url, g_lyrics_timeout_us));
+    return new LyricPipeline(std::move(providers));
+}
+
+// --- 罗马音后处理（可选，MUSICFOX_ROMANIZATION=1 开启）---
+// 时间轴就绪后把整份歌词交给后台线程，结果通过 idle 回到主线程交给引擎，由引擎按序号丢弃过期结果
+typedef struct { Session *session; guint64 serial; std::vector<std::string> lines; std::vector<std::string> romanized; } romanization_job_t;
+static gboolean romanization_done(gpointer data) {
+    romanization_job_t *job = static_cast<romanization_job_t*>(data);
+    if (!job->session->closed) job->session->engine->on_romanization_ready(job->serial, std::move(job->romanized));
+    session_unref(job->session);
+    delete job;
+    return G_SOURCE_REMOVE;
+}
+static void romanization_worker(gpointer data, gpointer user_data) {
+    romanization_job_t *job = static_cast<romanization_job_t*>(data);
+    job->romanized.reserve(job->lines.size());
+    {
+        TraceScope trace(TraceEvent::Romanization, static_cast<int64_t>(job->lines.size()));
+        for (const std::string &line : job->lines) job->romanized.push_back(romanize_line(line));
     }
-    std::sort(lyrics.begin(), lyrics.end(), [](const LyricLine& a, const LyricLine& b){ return a.timestamp_us < b.timestamp_us; });
-    return lyrics;
+    g_idle_add(romanization_done, job);
 }
-void update_and_emit_signal(gint64 display_position_us) {
-    if (!g_player_skeleton) return;
-    music_info_service_player_set_artist(g_player_skeleton, g_current_music.artist.c_str());
-    music_info_service_player_set_title(g_player_skeleton, g_current_music.title.c_str());
-    music_info_service_player_set_is_playing(g_player_skeleton, g_current_music.is_playing);
-    music_info_service_player_set_current_lyric(g_player_skeleton, g_current_lyric_text.c_str());
-    music_info_service_player_set_duration(g_player_skeleton, static_cast<double>(g_current_music.duration_us) / 1000000.0);
-    music_info_service_player_set_position(g_player_skeleton, static_cast<double>(display_position_us) / 1000000.0);
-    music_info_service_player_emit_state_changed(g_player_skeleton, g_current_music.artist.c_str(), g_current_music.title.c_str(), g_current_music.is_playing, g_current_lyric_text.c_str(), static_cast<double>(g_current_music.duration_us) / 1000000.0, static_cast<double>(display_position_us) / 1000000.0);
+
+// --- 长行分段 ---
+// 与罗马音相同：后台线程按列宽切段，结果回到主线程交给引擎；段边界也是换行定时器的触发点，交回后重新排定
+typedef struct { Session *session; guint64 serial; std::vector<LyricLine> timeline; std::vector<std::vector<LyricSegment>> layout; } layout_job_t;
+static gboolean layout_done(gpointer data) {
+    layout_job_t *job = static_cast<layout_job_t*>(data);
+    if (!job->session->closed) {
+        job->session->engine->on_layout_ready(job->serial, std::move(job->layout));
+        schedule_line_boundary(job->session);
+    }
+    session_unref(job->session);
+    delete job;
+    return G_SOURCE_REMOVE;
+}
+static void layout_worker(gpointer data, gpointer user_data) {
+    layout_job_t *job = static_cast<layout_job_t*>(data);
+    {
+        TraceScope trace(TraceEvent::Layout, static_cast<int64_t>(job->timeline.size()));
+        job->layout = layout_timeline(job->timeline, g_panel_columns);
+    }
+    g_idle_add(layout_done, job);
 }
 
+static void on_timeline_changed(Session *session, uint64_t serial, const std::vector<LyricLine> &timeline) {
+    if (serial != 0 && g_layout_pool) g_thread_pool_push(g_layout_pool, new layout_job_t{session_ref(session), serial, timeline, {}}, nullptr);
+    if (serial == 0 || !g_romanization_pool) return;
+    romanization_job_t *job = new romanization_job_t{session_ref(session), serial, {}, {}};
+    job->lines.reserve(timeline.size());
+    for (const LyricLine &line : timeline) job->lines.push_back(line.text);
+    g_thread_pool_push(g_romanization_pool, job, nullptr);
+}
 
-// --- 关键修正：移植自 mpris_listener.cpp 的健壮逻辑 ---
-extern "C" void on_any_signal(GDBusConnection *connection, const gchar *sender, const gchar *path, const gchar *iface_name, const gchar *signal, GVariant *params, gpointer data) {
-    if (g_strcmp0(signal, "PropertiesChanged") != 0 || !params) return;
+// 引擎状态每次可能改变（换歌、跳转、位置同步、暂停）后重新计算下一行的触发时刻
+static void schedule_line_boundary(Session *session) {
+    if (!session->line_source) return;
+    gint64 deadline_us = session->tier == TIER_OFF ? -1 : session->engine->next_line_time_us();
+    if (deadline_us < 0) { deadline_source_clear(session->line_source); return; }
+    deadline_source_set(session->line_source, deadline_us, (g_precise_timing && !session->screen_idle) ? kPreciseSlackUs : kRelaxedSlackUs);
+}
+static gboolean on_line_boundary(gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    gint64 lateness_us = clock_now_us() - deadline_source_target(session->line_source);
+    trace_instant(TraceEvent::LineBoundary, lateness_us);
+    record_latency(session->line_lateness, lateness_us);
+    session->engine->tick();
+    schedule_line_boundary(session);
+    return G_SOURCE_CONTINUE;
+}
+extern "C" void on_screensaver_signal(GDBusConnection *connection, const gchar *sender, const gchar *path, const gchar *iface_name, const gchar *signal, GVariant *params, gpointer data) {
+    Session *session = static_cast<Session*>(data);
+    if (session->closed || !params || !g_variant_is_of_type(params, G_VARIANT_TYPE("(b)"))) return;
+    gboolean active = FALSE;
+    g_variant_get(params, "(b)", &active);
+    session->screen_idle = active;
+    schedule_line_boundary(session);
+}
 
-    const char *prop_iface = nullptr;
-    GVariant *changed_props = nullptr;
-    g_variant_get(params, "(&s@a{sv}@as)", &prop_iface, &changed_props, nullptr);
+// --- 输出设备探测 ---
+// pactl 要起子进程，放到一次性线程里跑，结果回到主线程后更新引擎的偏移
+typedef struct { Session *session; std::string server; std::string sink; } sink_probe_t;
+static gboolean sink_probe_done(gpointer data) {
+    sink_probe_t *probe = static_cast<sink_probe_t*>(data);
+    Session *session = probe->session;
+    session->sink_probe_running = false;
+    if (!session->closed) {
+        if (probe->sink != session->current_sink) std::cout << session->label << "Audio output: " << (probe->sink.empty() ? "(unknown)" : probe->sink) << ", lyric offset " << session->latency_table.offset_for(probe->sink) / 1000 << " ms" << std::endl;
+        session->current_sink = probe->sink;
+        session->engine->set_output_offset_us(session->latency_table.offset_for(session->current_sink));
+        schedule_line_boundary(session);
+    }
+    session_unref(session);
+    delete probe;
+    return G_SOURCE_REMOVE;
+}
+static gpointer sink_probe_thread(gpointer data) {
+    sink_probe_t *probe = static_cast<sink_probe_t*>(data);
+    PactlSinkProbe pactl(probe->server);
+    gint64 latency_us = 0;
+    if (!pactl.probe(probe->sink, latency_us)) probe->sink.clear();
+    g_idle_add(sink_probe_done, probe);
+    return nullptr;
+}
+static void probe_output_sink(Session *session) {
+    if (session->sink_probe_running) return;
+    session->sink_probe_running = true;
+    g_thread_unref(g_thread_new("sink-probe", sink_probe_thread, new sink_probe_t{session_ref(session), session->pulse_server, std::string()}));
+}
+static std::string latency_config_path(const std::string &config_dir) {
+    gchar *path = g_build_filename(config_dir.c_str(), "musicfox-lyric", "latency.conf", nullptr);
+    std::string result = path;
+    g_free(path);
+    return result;
+}
+// --calibrate-latency：多次查询当前 sink 的延迟取中位数，写入配置后退出
+static int run_latency_calibration() {
+    std::string path = latency_config_path(g_get_user_config_dir());
+    LatencyTable table;
+    table.load(path);
+    PactlSinkProbe probe;
+    std::string sink; gint64 latency_us = 0;
+    if (!calibrate_sink_latency(probe, table, 9, &sink, &latency_us)) {
+        std::cerr << "Calibration failed: cannot query the default sink latency via pactl." << std::endl;
+        return 1;
+    }
+    gchar *dir = g_path_get_dirname(path.c_str());
+    g_mkdir_with_parents(dir, 0700);
+    g_free(dir);
+    if (!table.save(path)) { std::cerr << "Failed to write " << path << std::endl; return 1; }
+    std::cout << "Sink " << sink << ": latency " << latency_us / 1000 << " ms, saved to " << path << std::endl;
+    return 0;
+}
+
+// --dump-timeline FILE：向正在运行的服务要当前曲目的时间轴快照，二进制写入 FILE，JSON 打印到标准输出
+static int run_dump_timeline(const char *path) {
+    GError *error = nullptr;
+    GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SESSION, nullptr, &error);
+    GVariant *reply = connection ? g_dbus_connection_call_sync(connection, "org.amazzy24128.MusicInfoService", "/org/amazzy24128/MusicInfoService/Player", "org.amazzy24128.MusicInfoService.Player", "ExportTimeline", nullptr, G_VARIANT_TYPE("(ay)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error) : nullptr;
+    if (connection) g_object_unref(connection);
+    if (!reply) { std::cerr << "ExportTimeline failed: " << error->message << std::endl; g_error_free(error); return 1; }
+    GVariant *bytes = g_variant_get_child_value(reply, 0);
+    gsize size = 0;
+    const gchar *data = static_cast<const gchar*>(g_variant_get_fixed_array(bytes, &size, 1));
+    TimelineSnapshotView view;
+    bool ok = TimelineSnapshotView::parse(std::string_view(data, size), &view) && g_file_set_contents(path, data, static_cast<gssize>(size), &error);
+    if (ok) std::cout << timeline_snapshot_json(view);
+    else if (error) { std::cerr << "Failed to write " << path << ": " << error->message << std::endl; g_clear_error(&error); }
+    else std::cerr << "Malformed snapshot from the service" << std::endl;
+    g_variant_unref(bytes);
+    g_variant_unref(reply);
+    return ok ? 0 : 1;
+}
 
-    // 1. 创建全新的、干净的临时变量
-    music_t temp_music = {};
-    std::vector<LyricLine> temp_lyrics;
+// --load-timeline FILE：文件 mmap 后就地读取，每份快照用虚拟时钟在一个新引擎里从导出时刻播到最后一行，
+// 打印每次发出的位置、行号和显示的段，用来对照用户看到的换行时刻
+static int run_load_timeline(const char *path) {
+    MappedLrc mapped = MappedLrc::open(path);
+    if (!mapped.valid()) { std::cerr << "Cannot read " << path << std::endl; return 1; }
+    std::string_view rest = mapped.text();
+    int count = 0;
+    TimelineSnapshotView view;
+    while (!rest.empty() && TimelineSnapshotView::parse(rest, &view)) {
+        rest.remove_prefix(view.size());
+        TimelineSnapshot snapshot = view.materialize();
+        std::cout << "# " << snapshot.artist << " - " << snapshot.title << " (" << snapshot.trackid << "), " << snapshot.timeline.size() << " lines, offset "
+                  << snapshot.output_offset_us / 1000 << " ms, rate " << snapshot.rate << (snapshot.is_playing ? "" : ", paused when captured") << std::endl;
+        // 暂停时导出的也从锚点接着播，才能看到之后的换行
+        snapshot.is_playing = true;
+        ManualClock clock(snapshot.captured_us);
+        LyricEngine *engine = nullptr;
+        uint64_t serial = 0;
+        EngineCallbacks callbacks;
+        callbacks.emit_state = [&](const EngineState &state) { std::cout << "  " << state.position_us / 1000 << " ms  line " << engine->line_index() << "  " << state.segment << std::endl; };
+        callbacks.timeline_changed = [&](uint64_t timeline_serial, const std::vector<LyricLine> &) { serial = timeline_serial; };
+        engine = new LyricEngine(clock, callbacks);
+        engine->load_snapshot(snapshot);
+        // 分段与服务里一样，只是在这里同步生成
+        if (serial != 0 && g_panel_columns > 0) engine->on_layout_ready(serial, layout_timeline(engine->timeline(), g_panel_columns));
+        for (gint64 deadline_us = engine->next_line_time_us(); deadline_us >= 0; deadline_us = engine->next_line_time_us()) {
+            clock.set(deadline_us);
+            engine->tick();
+        }
+        delete engine;
+        count++;
+    }
+    if (count == 0) { std::cerr << path << " is not a timeline snapshot" << std::endl; return 1; }
+    if (!rest.empty()) std::cerr << "Ignored " << rest.size() << " trailing bytes" << std::endl;
+    return 0;
+}
 
-    // 2. 用信号中的新数据填充临时变量
+// 一批 PropertiesChanged 合并后只交给引擎一次：一次解析、一次发出
+static gboolean flush_player_updates(gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    session->flush_source_id = 0;
+    trace_instant(TraceEvent::Flush);
+    std::string previous_track = session->engine->music().trackid;
+    session->engine->flush_player_updates();
+    // 换歌时顺便确认输出设备（蓝牙耳机通常在两首歌之间连上或断开），并预取队列里接下来的歌词
+    if (session->engine->music().trackid != previous_track) { probe_output_sink(session); prefetch_upcoming(session); }
+    schedule_line_boundary(session);
+    return G_SOURCE_REMOVE;
+}
+
+// 解析一份 MPRIS Metadata（a{sv}），PropertiesChanged 和 TrackList 共用
+static void read_metadata(GVariant *meta_variant, PlayerUpdate &update) {
+    GVariantIter miter; gchar *mkey; GVariant *mval;
+    g_variant_iter_init(&miter, meta_variant);
+    while (g_variant_iter_next(&miter, "{sv}", &mkey, &mval)) {
+        if (g_strcmp0(mkey, "mpris:trackid") == 0) update.metadata.trackid = g_variant_get_string(mval, nullptr);
+        else if (g_strcmp0(mkey, "xesam:title") == 0) update.metadata.title = g_variant_get_string(mval, nullptr);
+        else if (g_strcmp0(mkey, "xesam:artist") == 0 && g_variant_is_of_type(mval, G_VARIANT_TYPE("as")) && g_variant_n_children(mval) > 0) {
+            GVariant *first_artist = g_variant_get_child_value(mval, 0);
+            update.metadata.artist = g_variant_get_string(first_artist, nullptr);
+            g_variant_unref(first_artist);
+        }
+        else if (g_strcmp0(mkey, "mpris:length") == 0) update.metadata.duration_us = g_variant_get_int64(mval);
+        else if (g_strcmp0(mkey, "xesam:url") == 0 && g_variant_is_of_type(mval, G_VARIANT_TYPE_STRING)) update.metadata.url = g_variant_get_string(mval, nullptr);
+        else if (g_strcmp0(mkey, "xesam:asText") == 0) {
+            // 只拷贝原文，解析由引擎推迟到标题/歌手发出之后
+            const char* lrc = g_variant_get_string(mval, nullptr);
+            if (lrc) { update.lyrics = lrc; update.has_lyrics = true; }
+        }
+        g_free(mkey); g_variant_unref(mval);
+    }
+}
+
+// --- 播放队列预取 ---
+// 换歌或队列被替换后，向播放器要 TrackList 的 Tracks，找到当前曲目之后的 kPrefetchDepth 首，
+// 再用 GetTracksMetadata 取它们的元数据，交给后台线程解码、解析（没有 asText 时查本地歌词库），
+// 结果回到主线程存进引擎。播放器没开 TrackList 时两次调用都会失败，直接忽略。
+typedef struct { Session *session; PlayerUpdate track; PrefetchedLyrics result; } prefetch_job_t;
+static gboolean prefetch_done(gpointer data) {
+    prefetch_job_t *job = static_cast<prefetch_job_t*>(data);
+    if (!job->session->closed) job->session->engine->store_prefetched(std::move(job->result));
+    session_unref(job->session);
+    delete job;
+    return G_SOURCE_REMOVE;
+}
+static void prefetch_worker(gpointer data, gpointer user_data) {
+    prefetch_job_t *job = static_cast<prefetch_job_t*>(data);
+    TraceScope trace(TraceEvent::Prefetch);
+    job->result.trackid = job->track.metadata.trackid;
+    if (job->track.has_lyrics) {
+        job->result.from_player = true;
+        job->result.timeline = parse_lyric_payload(job->track.lyrics);
+        job->result.payload = std::move(job->track.lyrics);
+    }
+    // 与引擎的回退顺序一致：播放器的歌词解析不出内容时查本地歌词库
+    if (job->result.timeline.empty() && !job->track.metadata.title.empty()) {
+        job->result.from_player = false;
+        job->result.payload = lookup_local_lyrics(job->session, job->track.metadata.artist, job->track.metadata.title);
+        job->result.timeline = job->result.payload.empty() ? std::vector<LyricLine>() : parse_lyric_payload(job->result.payload);
+    }
+    g_idle_add(prefetch_done, job);
+}
+static void on_tracks_metadata_reply(GObject *source, GAsyncResult *res, gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    session->prefetch_in_flight = false;
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, nullptr);
+    if (result && !session->closed) {
+        GVariant *tracks = g_variant_get_child_value(result, 0);
+        GVariantIter iter; GVariant *meta_variant;
+        g_variant_iter_init(&iter, tracks);
+        while ((meta_variant = g_variant_iter_next_value(&iter))) {
+            prefetch_job_t *job = new prefetch_job_t();
+            read_metadata(meta_variant, job->track);
+            g_variant_unref(meta_variant);
+            if (job->track.metadata.trackid.empty() || session->engine->has_prefetched(job->track.metadata.trackid)) { delete job; continue; }
+            job->session = session_ref(session);
+            g_thread_pool_push(g_prefetch_pool, job, nullptr);
+        }
+        g_variant_unref(tracks);
+    }
+    if (result) g_variant_unref(result);
+    session_unref(session);
+}
+static void on_tracks_reply(GObject *source, GAsyncResult *res, gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, nullptr);
+    if (!result || session->closed) { session->prefetch_in_flight = false; if (result) g_variant_unref(result); session_unref(session); return; }
+    GVariant *tracks = nullptr; g_variant_get(result, "(v)", &tracks);
+    const std::string &current = session->engine->music().trackid;
+    GVariantBuilder upcoming; g_variant_builder_init(&upcoming, G_VARIANT_TYPE("ao"));
+    size_t wanted = 0; bool found = false;
+    if (g_variant_is_of_type(tracks, G_VARIANT_TYPE("ao"))) {
+        GVariantIter iter; const gchar *trackid;
+        g_variant_iter_init(&iter, tracks);
+        while (wanted < LyricEngine::kPrefetchDepth && g_variant_iter_next(&iter, "&o", &trackid)) {
+            if (found && !session->engine->has_prefetched(trackid)) { g_variant_builder_add(&upcoming, "o", trackid); wanted++; }
+            else if (current == trackid) found = true;
+        }
+    }
+    g_variant_unref(tracks);
+    g_variant_unref(result);
+    if (wanted == 0) { g_variant_builder_clear(&upcoming); session->prefetch_in_flight = false; session_unref(session); return; }
+    // 引用转交给下一次调用
+    g_dbus_connection_call(session->connection, session->bus_name.c_str(), "/org/mpris/MediaPlayer2", "org.mpris.MediaPlayer2.TrackList", "GetTracksMetadata", g_variant_new("(ao)", &upcoming), G_VARIANT_TYPE("(aa{sv})"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, on_tracks_metadata_reply, session);
+}
+static void prefetch_upcoming(Session *session) {
+    if (!g_prefetch_pool || session->prefetch_in_flight || session->bus_name.empty() || session->engine->music().trackid.empty()) return;
+    session->prefetch_in_flight = true;
+    g_dbus_connection_call(session->connection, session->bus_name.c_str(), "/org/mpris/MediaPlayer2", "org.freedesktop.DBus.Properties", "Get", g_variant_new("(ss)", "org.mpris.MediaPlayer2.TrackList", "Tracks"), G_VARIANT_TYPE("(v)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, on_tracks_reply, session_ref(session));
+}
+// 队列变化（替换、增删）后重新预取
+extern "C" void on_tracklist_signal(GDBusConnection *connection, const gchar *sender, const gchar *path, const gchar *iface_name, const gchar *signal, GVariant *params, gpointer data) {
+    Session *session = static_cast<Session*>(data);
+    if (!session->closed) prefetch_upcoming(session);
+}
+
+// PropertiesChanged 的 changed_properties 和 GetAll 的结果格式相同（a{sv}），都合并后交给引擎
+static void queue_player_properties(Session *session, GVariant *changed_props) {
+    PlayerUpdate update;
     GVariant *status_variant = g_variant_lookup_value(changed_props, "PlaybackStatus", G_VARIANT_TYPE_STRING);
     if (status_variant) {
-        temp_music.is_playing = (g_strcmp0(g_variant_get_string(status_variant, nullptr), "Playing") == 0);
+        update.has_status = true;
+        update.is_playing = (g_strcmp0(g_variant_get_string(status_variant, nullptr), "Playing") == 0);
         g_variant_unref(status_variant);
-    } else {
-        temp_music.is_playing = g_current_music.is_playing; // 如果信号没给，继承旧值
+    }
+
+    GVariant *rate_variant = g_variant_lookup_value(changed_props, "Rate", G_VARIANT_TYPE_DOUBLE);
+    if (rate_variant) {
+        update.has_rate = true;
+        update.rate = g_variant_get_double(rate_variant);
+        g_variant_unref(rate_variant);
     }
 
     GVariant *meta_variant = g_variant_lookup_value(changed_props, "Metadata", G_VARIANT_TYPE("a{sv}"));
     if (meta_variant) {
-        GVariantIter miter; gchar *mkey; GVariant *mval;
-        g_variant_iter_init(&miter, meta_variant);
-        while (g_variant_iter_next(&miter, "{sv}", &mkey, &mval)) {
-            if (g_strcmp0(mkey, "mpris:trackid") == 0) temp_music.trackid = g_variant_get_string(mval, nullptr);
-            else if (g_strcmp0(mkey, "xesam:title") == 0) temp_music.title = g_variant_get_string(mval, nullptr);
-            else if (g_strcmp0(mkey, "xesam:artist") == 0 && g_variant_is_of_type(mval, G_VARIANT_TYPE("as")) && g_variant_n_children(mval) > 0) temp_music.artist = g_variant_get_string(g_variant_get_child_value(mval, 0), nullptr);
-            else if (g_strcmp0(mkey, "mpris:length") == 0) temp_music.duration_us = g_variant_get_int64(mval);
-            else if (g_strcmp0(mkey, "xesam:asText") == 0) {
-                const char* lrc = g_variant_get_string(mval, nullptr);
-                if (lrc) temp_lyrics = parse_lrc(lrc);
-            }
-            g_free(mkey); g_variant_unref(mval);
-        }
+        update.has_metadata = true;
+        read_metadata(meta_variant, update);
         g_variant_unref(meta_variant);
-    } else {
-        // 如果信号没给元数据，继承旧的元数据和歌词
-        temp_music.trackid = g_current_music.trackid;
-        temp_music.artist = g_current_music.artist;
-        temp_music.title = g_current_music.title;
-        temp_music.duration_us = g_current_music.duration_us;
-        temp_lyrics = g_parsed_lyrics;
     }
 
-    // 3. 判断是否是新歌
-    bool is_new_track = (!temp_music.trackid.empty() && temp_music.trackid != g_current_music.trackid);
+    session->engine->queue_player_update(std::move(update));
+    if (session->flush_source_id == 0) {
+        session->flush_source_id = g_coalesce_window_ms ? g_timeout_add(g_coalesce_window_ms, flush_player_updates, session) : g_idle_add(flush_player_updates, session);
+    }
+}
 
-    // 4. 无条件用临时数据整体覆盖全局数据，保证状态原子性更新
-    g_current_music = temp_music;
-    g_parsed_lyrics = temp_lyrics;
+// --- 关键修正：移植自 mpris_listener.cpp 的健壮逻辑 ---
+extern "C" void on_any_signal(GDBusConnection *connection, const gchar *sender, const gchar *path, const gchar *iface_name, const gchar *signal, GVariant *params, gpointer data) {
+    Session *session = static_cast<Session*>(data);
+    if (g_strcmp0(signal, "PropertiesChanged") != 0 || !params || session->closed) return;
+    trace_instant(TraceEvent::SignalReceived);
 
-    // 5. 如果是新歌，重置当前歌词文本并立即同步时间
-    if (is_new_track) {
-        g_current_lyric_text = "";
-        sync_position_from_dbus(data);
-    } else {
-        // 如果不是新歌，但播放状态变了（例如从暂停到播放），也同步一次时间
-        bool playback_state_changed = temp_music.is_playing != g_current_music.is_playing;
-        if(playback_state_changed) {
-             sync_position_from_dbus(data);
-        }
-    }
-    
+    const char *prop_iface = nullptr;
+    GVariant *changed_props = nullptr;
+    g_variant_get(params, "(&s@a{sv}@as)", &prop_iface, &changed_props, nullptr);
+    queue_player_properties(session, changed_props);
     if (changed_props) g_variant_unref(changed_props);
 }
+extern "C" void on_seeked_signal(GDBusConnection *connection, const gchar *sender, const gchar *path, const gchar *iface_name, const gchar *signal, GVariant *params, gpointer data) {
+    Session *session = static_cast<Session*>(data);
+    if (session->closed || !params || !g_variant_is_of_type(params, G_VARIANT_TYPE("(x)"))) return;
+    gint64 position_us = 0;
+    g_variant_get(params, "(x)", &position_us);
+    session->engine->on_seek(position_us);
+    schedule_line_boundary(session);
+}
 
 
+// 回复时带回发出请求时的换歌代数
+typedef struct { Session *session; guint64 generation; } position_request_t;
+static void on_position_reply(GObject *source, GAsyncResult *res, gpointer user_data) {
+    position_request_t *request = static_cast<position_request_t*>(user_data);
+    Session *session = request->session;
+    GError *error = nullptr;
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &error);
+    if (!result) {
+        if (error) g_error_free(error);
+    } else {
+        if (!session->closed) {
+            GVariant *inner_variant; g_variant_get(result, "(v)", &inner_variant);
+            session->engine->on_position_sample(g_variant_get_int64(inner_variant), request->generation);
+            g_variant_unref(inner_variant);
+            schedule_line_boundary(session);
+        }
+        g_variant_unref(result);
+    }
+    session_unref(session);
+    delete request;
+}
+static void request_position(Session *session, guint64 generation) {
+    if (session->bus_name.empty()) return;
+    trace_instant(TraceEvent::SyncRequest, static_cast<gint64>(generation));
+    g_dbus_connection_call(session->connection, session->bus_name.c_str(), "/org/mpris/MediaPlayer2", "org.freedesktop.DBus.Properties", "Get", g_variant_new("(ss)", "org.mpris.MediaPlayer2.Player", "Position"), G_VARIANT_TYPE("(v)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, on_position_reply, new position_request_t{session_ref(session), generation});
+}
 static gboolean sync_position_from_dbus(gpointer user_data) {
-    AppContext* context = static_cast<AppContext*>(user_data);
+    Session *session = static_cast<Session*>(user_data);
+    request_position(session, session->engine->generation());
+    return G_SOURCE_CONTINUE;
+}
+// 换行兜底：换行本由 schedule_line_boundary 在行边界精确触发，某条输入路径漏了重新安排时，
+// 最多晚 1 秒由这里补上。tick 只在行或段变化时发出，没漏的时候什么也不发；顺带重新安排边界定时器
+static gboolean line_fallback_tick(gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    session->engine->tick();
+    schedule_line_boundary(session);
+    return G_SOURCE_CONTINUE;
+}
+static void print_latency(const char *name, const latency_stat_t &stat) {
+    std::cout << "  " << name << ": count=" << stat.count;
+    if (stat.count > 0) std::cout << " avg_us=" << stat.total_us / (gint64)stat.count << " max_us=" << stat.max_us << " last_us=" << stat.last_us;
+    std::cout << std::endl;
+}
+// 指标不再定期打印（前端会把 stdout 逐行转发进系统日志），只在导出追踪和会话结束时输出一次
+static void report_metrics(Session *session) {
+    std::cout << session->label << "Metrics:" << std::endl;
+    const engine_metrics_t &metrics = session->engine->metrics();
+    print_latency("track_change_first_emit", metrics.track_change_first_emit);
+    print_latency("track_change_lyric_emit", metrics.track_change_lyric_emit);
+    print_latency("line_switch_lateness", session->line_lateness);
+    std::cout << "  properties_changed: received=" << metrics.updates_received << " applied=" << metrics.updates_applied;
+    if (metrics.updates_applied > 0) std::cout << " coalescing_ratio=" << static_cast<double>(metrics.updates_received) / static_cast<double>(metrics.updates_applied);
+    std::cout << std::endl;
+    std::cout << "  prefetch_hits: " << metrics.prefetch_hits << " of " << metrics.track_change_lyric_emit.count << " track changes" << std::endl;
+    std::cout << "  incremental_parses: " << metrics.incremental_parses << std::endl;
+    if (g_shared_lyrics) std::cout << "  shared_cache_hits: " << metrics.shared_cache_hits << std::endl;
+    LyricPipeline *pipeline = session->lyric_pipeline;
+    for (size_t i = 0; pipeline && i < pipeline->provider_count(); ++i) {
+        provider_metrics_t m = pipeline->metrics(i);
+        uint64_t answered = m.hits + m.misses;
+        std::cout << "  provider " << pipeline->provider_name(i) << ": requests=" << m.requests << " hits=" << m.hits << " misses=" << m.misses
+                  << " timeouts=" << m.timeouts << " cancelled=" << m.cancelled << " wins=" << m.wins;
+        if (m.requests > 0) std::cout << " hit_rate=" << 100.0 * static_cast<double>(m.hits) / static_cast<double>(m.requests) << "%";
+        if (answered > 0) std::cout << " avg=" << m.total_latency_us / static_cast<int64_t>(answered) / 1000.0 << "ms max=" << m.max_latency_us / 1000.0 << "ms";
+        std::cout << std::endl;
+    }
+}
+
+// --- 事件追踪导出：D-Bus 方法 DumpTrace 或 SIGUSR1 ---
+// 追踪环是整个进程共用的；通过 D-Bus 导出时写到调用方那条会话的运行时目录
+static std::string dump_trace(const std::string &runtime_dir) {
+    gchar *path = g_strdup_printf("%s/musicfox-lyric-trace-%d.json", runtime_dir.c_str(), static_cast<int>(getpid()));
+    std::string result = trace_dump_to_file(path) ? path : "";
+    g_free(path);
+    return result;
+}
+static gboolean on_sigusr1(gpointer user_data) {
+    std::string path = dump_trace(g_get_user_runtime_dir());
+    if (path.empty()) std::cerr << "Failed to write trace" << std::endl;
+    else std::cout << "Trace written to " << path << std::endl;
+    for (Session *session : g_sessions) report_metrics(session);
+    return G_SOURCE_CONTINUE;
+}
+// --- 歌词检索和按行跳转 ---
+static void on_set_position_reply(GObject *source, GAsyncResult *res, gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
     GError *error = nullptr;
-    GVariant *result = g_dbus_connection_call_sync(context->connection, context->bus_name.c_str(), "/org/mpris/MediaPlayer2", "org.freedesktop.DBus.Properties", "Get", g_variant_new("(ss)", "org.mpris.MediaPlayer2.Player", "Position"), G_VARIANT_TYPE("(v)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &error);
+    if (result) g_variant_unref(result);
+    if (error) { std::cerr << session->label << "SetPosition failed: " << error->message << std::endl; g_error_free(error); }
+    session_unref(session);
+}
+// 引擎先按目标位置重新锚定并发出，再让播放器跳过去；播放器随后的 Seeked 只是把锚点再校准一次。
+// trackid 不是合法对象路径时 SetPosition 用不了，改用相对跳转 Seek
+static bool seek_to_line(Session *session, gint64 index, GError **error) {
+    if (session->bus_name.empty()) { g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_FAILED, "musicfox is not running"); return false; }
+    gint64 from_us = session->engine->predicted_position_us();
+    gint64 position_us = (index < 0 || index > INT_MAX) ? -1 : session->engine->seek_to_line(static_cast<int>(index));
+    if (position_us < 0) { g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "No lyric line %lld", static_cast<long long>(index)); return false; }
+    schedule_line_boundary(session);
+    const std::string &trackid = session->engine->music().trackid;
+    GVariant *args = g_variant_is_object_path(trackid.c_str()) ? g_variant_new("(ox)", trackid.c_str(), position_us) : g_variant_new("(x)", position_us - from_us);
+    const char *method = g_variant_is_object_path(trackid.c_str()) ? "SetPosition" : "Seek";
+    g_dbus_connection_call(session->connection, session->bus_name.c_str(), "/org/mpris/MediaPlayer2", "org.mpris.MediaPlayer2.Player", method, args, nullptr, G_DBUS_CALL_FLAGS_NONE, -1, nullptr, on_set_position_reply, session_ref(session));
+    return true;
+}
+static GVariant *find_lyric(Session *session, const gchar *query) {
+    GVariantBuilder matches;
+    g_variant_builder_init(&matches, G_VARIANT_TYPE("a(xs)"));
+    const std::vector<LyricLine> &timeline = session->engine->timeline();
+    for (int index : session->engine->find_lines(query)) g_variant_builder_add(&matches, "(xs)", static_cast<gint64>(index), timeline[index].text.c_str());
+    GVariant *children[1] = { g_variant_builder_end(&matches) };
+    return g_variant_new_tuple(children, 1);
+}
+
+static GVariant *handle_player_method(const gchar *sender, const gchar *method_name, GVariant *parameters, gpointer user_data, GError **error) {
+    Session *session = static_cast<Session*>(user_data);
+    if (g_strcmp0(method_name, "Subscribe") == 0) {
+        const gchar *name = nullptr;
+        g_variant_get(parameters, "(&s)", &name);
+        for (int tier = TIER_OFF; tier <= TIER_PROGRESS_60HZ; ++tier) {
+            if (g_strcmp0(name, kTierNames[tier]) != 0) continue;
+            if (!sender) { g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_FAILED, "Subscribe needs a message bus"); return nullptr; }
+            set_subscriber(session, sender, static_cast<emission_tier_t>(tier));
+            return g_variant_new_tuple(nullptr, 0);
+        }
+        g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "Unknown tier %s", name);
+        return nullptr;
+    }
+    if (g_strcmp0(method_name, "FindLyric") == 0) {
+        const gchar *query = nullptr;
+        g_variant_get(parameters, "(&s)", &query);
+        return find_lyric(session, query);
+    }
+    if (g_strcmp0(method_name, "SeekToLine") == 0) {
+        gint64 index = 0;
+        g_variant_get(parameters, "(x)", &index);
+        return seek_to_line(session, index, error) ? g_variant_new_tuple(nullptr, 0) : nullptr;
+    }
+    if (g_strcmp0(method_name, "ExportTimeline") == 0) {
+        std::string data = timeline_snapshot_encode(session->engine->snapshot());
+        GVariant *children[1] = { g_variant_new_fixed_array(G_VARIANT_TYPE_BYTE, data.data(), data.size(), 1) };
+        return g_variant_new_tuple(children, 1);
+    }
+    if (g_strcmp0(method_name, "DumpTrace") == 0) {
+        std::string path = dump_trace(session->runtime_dir);
+        if (path.empty()) { g_set_error(error, G_IO_ERROR, G_IO_ERROR_FAILED, "Failed to write trace"); return nullptr; }
+        return g_variant_new("(s)", path.c_str());
+    }
+    return nullptr;
+}
+
+// --- 消费者和发送档位 ---
+static gboolean emit_progress(gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    if (session->engine->music().is_playing) player_interface_emit_progress(session->player, session->engine->predicted_position_us());
+    return G_SOURCE_CONTINUE;
+}
+// 位置同步、换行兜底和 Progress 定时器只在找到 musicfox 且档位需要时运行
+static void update_player_timers(Session *session) {
+    bool attached = !session->bus_name.empty();
+    if (attached && session->tier != TIER_OFF && !session->sync_timer_id) {
+        session->sync_timer_id = g_timeout_add_seconds(1, sync_position_from_dbus, session);
+        session->fallback_timer_id = g_timeout_add_seconds(1, line_fallback_tick, session);
+        sync_position_from_dbus(session);
+    } else if (session->tier == TIER_OFF && session->sync_timer_id) {
+        g_source_remove(session->sync_timer_id);
+        g_source_remove(session->fallback_timer_id);
+        session->sync_timer_id = session->fallback_timer_id = 0;
+    }
+    if (session->progress_timer_id) g_source_remove(session->progress_timer_id);
+    session->progress_timer_id = 0;
+    guint interval_ms = session->tier == TIER_PROGRESS_60HZ ? 16 : session->tier == TIER_PROGRESS_10HZ ? 100 : 0;
+    if (attached && interval_ms) session->progress_timer_id = g_timeout_add(interval_ms, emit_progress, session);
+}
+static void apply_tier(Session *session) {
+    emission_tier_t tier = TIER_OFF;
+    for (const subscriber_t &subscriber : session->subscribers) tier = std::max(tier, subscriber.tier);
+    if (tier == session->tier) return;
+    emission_tier_t previous = session->tier;
+    session->tier = tier;
+    std::cout << session->label << "Emission tier: " << kTierNames[tier] << " (" << session->subscribers.size() << " subscribers)" << std::endl;
+    update_player_timers(session);
+    // 停发期间快照没有更新，先按当前位置重选行，再把完整状态发一次
+    if (previous == TIER_OFF) {
+        session->engine->tick();
+        publish_state(session, session->engine->state());
+    }
+    schedule_line_boundary(session);
+}
+static void on_subscriber_vanished(GDBusConnection *connection, const gchar *name, gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    if (!session->closed) set_subscriber(session, name, TIER_OFF);
+}
+static void set_subscriber(Session *session, const std::string &sender, emission_tier_t tier) {
+    auto it = std::find_if(session->subscribers.begin(), session->subscribers.end(), [&](const subscriber_t &subscriber) { return subscriber.sender == sender; });
+    if (it != session->subscribers.end() && tier != TIER_OFF) {
+        it->tier = tier;
+    } else if (it != session->subscribers.end()) {
+        g_bus_unwatch_name(it->watch_id);
+        session->subscribers.erase(it);
+    } else if (tier != TIER_OFF) {
+        guint watch_id = g_bus_watch_name_on_connection(session->connection, sender.c_str(), G_BUS_NAME_WATCHER_FLAGS_NONE, nullptr, on_subscriber_vanished, session_ref(session), session_release);
+        session->subscribers.push_back(subscriber_t{sender, tier, watch_id});
+    }
+    apply_tier(session);
+}
+
+// --- 寻找 musicfox ---
+// 每 500ms 异步列一次总线上的名字，找到后才订阅它的信号、开始位置同步
+// 服务晚于 musicfox 启动时（登录后 Shell 才拉起服务）不等下一条 PropertiesChanged，先把播放器当前的属性取一次
+static void on_player_properties_reply(GObject *source, GAsyncResult *res, gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, nullptr);
+    if (result && !session->closed) {
+        GVariant *props = g_variant_get_child_value(result, 0);
+        queue_player_properties(session, props);
+        g_variant_unref(props);
+    }
+    if (result) g_variant_unref(result);
+    session_unref(session);
+}
+static void attach_player(Session *session, const std::string &bus_name) {
+    session->bus_name = bus_name;
+    std::cout << session->label << "Found musicfox at: " << bus_name << std::endl;
+    session->mpris_sub_id = g_dbus_connection_signal_subscribe(session->connection, bus_name.c_str(), "org.freedesktop.DBus.Properties", "PropertiesChanged", "/org/mpris/MediaPlayer2", nullptr, G_DBUS_SIGNAL_FLAGS_NONE, on_any_signal, session_ref(session), session_release);
+    session->seeked_sub_id = g_dbus_connection_signal_subscribe(session->connection, bus_name.c_str(), "org.mpris.MediaPlayer2.Player", "Seeked", "/org/mpris/MediaPlayer2", nullptr, G_DBUS_SIGNAL_FLAGS_NONE, on_seeked_signal, session_ref(session), session_release);
+    session->tracklist_sub_id = g_dbus_connection_signal_subscribe(session->connection, bus_name.c_str(), "org.mpris.MediaPlayer2.TrackList", nullptr, "/org/mpris/MediaPlayer2", nullptr, G_DBUS_SIGNAL_FLAGS_NONE, on_tracklist_signal, session_ref(session), session_release);
+    g_dbus_connection_call(session->connection, bus_name.c_str(), "/org/mpris/MediaPlayer2", "org.freedesktop.DBus.Properties", "GetAll", g_variant_new("(s)", "org.mpris.MediaPlayer2.Player"), G_VARIANT_TYPE("(a{sv})"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, on_player_properties_reply, session_ref(session));
+    update_player_timers(session);
+}
+static void on_list_names_reply(GObject *source, GAsyncResult *res, gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    session->discovering = false;
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, nullptr);
+    std::string bus_name;
     if (result) {
-        GVariant *inner_variant; g_variant_get(result, "(v)", &inner_variant);
-        g_last_sync_position_us = g_variant_get_int64(inner_variant);
-        g_last_sync_time = std::chrono::steady_clock::now();
-        g_variant_unref(inner_variant); g_variant_unref(result);
-    } else if (error) { g_error_free(error); }
-    return G_SOURCE_CONTINUE; 
-}
-static gboolean predictive_update(gpointer user_data) {
-    gint64 predicted_position_us = g_last_sync_position_us;
-    if (g_current_music.is_playing) {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(now - g_last_sync_time).count();
-        predicted_position_us += elapsed_us;
-    }
-    std::string new_lyric = "";
-    if (!g_parsed_lyrics.empty()) {
-        int lyric_index = -1;
-        for (size_t i = 0; i < g_parsed_lyrics.size(); ++i) {
-            if (predicted_position_us >= g_parsed_lyrics[i].timestamp_us) { lyric_index = i; } 
-            else { break; }
+        GVariantIter *iter; g_variant_get(result, "(as)", &iter); gchar *name;
+        while (g_variant_iter_next(iter, "s", &name)) {
+            if (std::string(name).find("org.mpris.MediaPlayer2.musicfox") == 0) { bus_name = name; g_free(name); break; }
+            g_free(name);
         }
-        if (lyric_index != -1) { new_lyric = g_parsed_lyrics[lyric_index].text; }
+        g_variant_iter_free(iter); g_variant_unref(result);
+    }
+    if (!bus_name.empty() && !session->closed && session->bus_name.empty()) {
+        if (session->discover_timer_id) g_source_remove(session->discover_timer_id);
+        session->discover_timer_id = 0;
+        attach_player(session, bus_name);
     }
-    g_current_lyric_text = new_lyric;
-    update_and_emit_signal(predicted_position_us);
-    return G_SOURCE_CONTINUE; 
+    session_unref(session);
 }
+static gboolean discover_player(gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    if (session->discovering) return G_SOURCE_CONTINUE;
+    session->discovering = true;
+    g_dbus_connection_call(session->connection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "ListNames", nullptr, G_VARIANT_TYPE("(as)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, on_list_names_reply, session_ref(session));
+    return G_SOURCE_CONTINUE;
+}
+
+// --- 会话的建立和关闭 ---
 static void on_name_acquired(GDBusConnection *connection, const gchar *name, gpointer user_data) {
-    std::cout << "D-Bus service name acquired: " << name << std::endl;
+    Session *session = static_cast<Session*>(user_data);
+    std::cout << session->label << "D-Bus service name acquired: " << name << " (" << (g_get_monotonic_time() - g_start_us) / 1000 << " ms after start)" << std::endl;
 }
+// 默认模式下名字丢了就退出；守护模式下只关闭这条总线（通常是该用户自己起了服务），之后不再接管
 static void on_name_lost(GDBusConnection *connection, const gchar *name, gpointer user_data) {
-    std::cerr << "D-Bus service name lost: " << name << std::endl;
-    GMainLoop *loop = (GMainLoop*)user_data;
-    g_main_loop_quit(loop);
+    Session *session = static_cast<Session*>(user_data);
+    std::cerr << session->label << "D-Bus service name lost: " << name << std::endl;
+    if (g_daemon_mode && !g_dbus_connection_is_closed(session->connection)) g_skipped_buses.push_back(session->address);
+    session_close(session);
+}
+static void on_connection_closed(GDBusConnection *connection, gboolean remote_peer_vanished, GError *error, gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    std::cerr << session->label << "Session bus closed" << std::endl;
+    session_close(session);
 }
 
+// 启动后第一批只做不需要等待的事：导出对象、建引擎、请求总线名（异步），几毫秒内就能被客户端找到；
+// 读配置、起歌词库扫描线程、探测输出设备和寻找 musicfox 放到主循环空闲时再做
+static gboolean session_start_deferred(gpointer user_data) {
+    Session *session = static_cast<Session*>(user_data);
+    if (session->closed) return G_SOURCE_REMOVE;
+    // 本地歌词库：MUSICFOX_LRC_DIR 指定目录（默认 ~/Music，相对路径相对于该用户的主目录），设为空字符串则关闭
+    const char *lrc_dir_env = g_getenv("MUSICFOX_LRC_DIR");
+    std::string lrc_dir = lrc_dir_env ? lrc_dir_env : "Music";
+    if (!lrc_dir.empty() && !g_path_is_absolute(lrc_dir.c_str())) lrc_dir = session->home_dir + "/" + lrc_dir;
+    if (!lrc_dir.empty()) {
+        session->lrc_index = new LrcIndex(lrc_dir, session->lrc_cache_path);
+        session->lrc_index->start();
+    }
+    // 歌词库就绪后才建流水线，之后才开始寻找 musicfox，第一首歌的查找不会落空
+    session->lyric_pipeline = lyric_pipeline_new(session);
+    session->latency_table.load(latency_config_path(session->config_dir));
+    if (g_has_offset_override) session->latency_table.set_global_offset_us(g_offset_override_us);
+    session->engine->set_output_offset_us(session->latency_table.global_offset_us());
+    session->screensaver_sub_id = g_dbus_connection_signal_subscribe(session->connection, "org.gnome.ScreenSaver", "org.gnome.ScreenSaver", "ActiveChanged", "/org/gnome/ScreenSaver", nullptr, G_DBUS_SIGNAL_FLAGS_NONE, on_screensaver_signal, session_ref(session), session_release);
+    probe_output_sink(session);
+    session->discover_timer_id = g_timeout_add(500, discover_player, session);
+    discover_player(session);
+    return G_SOURCE_REMOVE;
+}
 
-int main()
-{
-    std::cout << "Starting Music Info D-Bus Service..." << std::endl;
-    std::string mpris_bus_name = "";
-    while (mpris_bus_name.empty()) {
-        mpris_bus_name = find_musicfox_bus_name();
-        if (mpris_bus_name.empty()) { struct timespec ts = {0, 500000000L}; nanosleep(&ts, nullptr); }
+// 连接已建好、目录已填好的会话：导出对象、起引擎、请求总线名，其余的推迟到 session_start_deferred
+static bool session_start(Session *session) {
+    GError *error = nullptr;
+    const char* object_path = "/org/amazzy24128/MusicInfoService/Player";
+    session->player = player_interface_register(session->connection, object_path, handle_player_method, session, &error);
+    if (!session->player) {
+        std::cerr << session->label << "Failed to export " << object_path << ": " << (error ? error->message : "unknown error") << std::endl;
+        g_clear_error(&error);
+        return false;
     }
-    std::cout << "Found musicfox at: " << mpris_bus_name << std::endl;
 
+    // 引擎先建好：名字一出现客户端就可能调用方法；歌词库和延迟偏移就绪之前查不到本地歌词、偏移为 0
+    EngineCallbacks callbacks;
+    callbacks.emit_state = [session](const EngineState &state) { publish_state(session, state); };
+    callbacks.request_position = [session](uint64_t generation) { request_position(session, generation); };
+    callbacks.timeline_changed = [session](uint64_t serial, const std::vector<LyricLine> &timeline) { on_timeline_changed(session, serial, timeline); };
+    callbacks.request_lyrics = [session](const music_t &music) { request_lyrics(session, music); };
+    session->engine = new LyricEngine(g_steady_clock, std::move(callbacks));
+    session->engine->set_shared_cache(g_shared_lyrics);
+
+    session->line_source = deadline_source_new(on_line_boundary, session);
+    g_source_attach(session->line_source, nullptr);
+    session->closed_handler_id = g_signal_connect(session->connection, "closed", G_CALLBACK(on_connection_closed), session);
+    GBusNameOwnerFlags owner_flags = g_daemon_mode ? G_BUS_NAME_OWNER_FLAGS_DO_NOT_QUEUE : G_BUS_NAME_OWNER_FLAGS_NONE;
+    session->owner_id = g_bus_own_name_on_connection(session->connection, "org.amazzy24128.MusicInfoService", owner_flags, on_name_acquired, on_name_lost, session_ref(session), session_release);
+    g_sessions.push_back(session);
+    g_idle_add_full(G_PRIORITY_LOW, session_start_deferred, session_ref(session), session_release);
+    return true;
+}
+
+static void session_close(Session *session) {
+    if (session->closed) return;
+    session->closed = true;
+    g_sessions.erase(std::remove(g_sessions.begin(), g_sessions.end(), session), g_sessions.end());
+    if (session->engine) report_metrics(session);
+    if (session->lyric_pipeline) session->lyric_pipeline->cancel_all();
+    for (const subscriber_t &subscriber : session->subscribers) g_bus_unwatch_name(subscriber.watch_id);
+    session->subscribers.clear();
+    for (guint *source_id : { &session->flush_source_id, &session->discover_timer_id, &session->sync_timer_id, &session->fallback_timer_id, &session->progress_timer_id }) {
+        if (*source_id) g_source_remove(*source_id);
+        *source_id = 0;
+    }
+    for (guint *sub_id : { &session->mpris_sub_id, &session->seeked_sub_id, &session->tracklist_sub_id, &session->screensaver_sub_id }) {
+        if (*sub_id) g_dbus_connection_signal_unsubscribe(session->connection, *sub_id);
+        *sub_id = 0;
+    }
+    if (session->owner_id) g_bus_unown_name(session->owner_id);
+    session->owner_id = 0;
+    if (session->closed_handler_id) g_signal_handler_disconnect(session->connection, session->closed_handler_id);
+    session->closed_handler_id = 0;
+    if (session->line_source) { g_source_destroy(session->line_source); g_source_unref(session->line_source); }
+    session->line_source = nullptr;
+    player_interface_unregister(session->player);
+    session->player = nullptr;
+    session_unref(session);
+    // 默认模式下、或者守护模式已经没有要服务的总线又不再扫描时退出
+    if (g_sessions.empty() && !g_all_users && g_loop) g_main_loop_quit(g_loop);
+}
+
+static Session *session_new(GDBusConnection *connection, const std::string &address) {
+    Session *session = new Session();
+    session->refs = 1;
+    session->connection = connection;
+    session->address = address;
+    if (!address.empty()) session->label = "[" + address + "] ";
+    return session;
+}
+// 本进程用户的目录，遵循 XDG_* 环境变量
+static void fill_own_dirs(Session *session, const char *lrc_cache_name) {
+    session->home_dir = g_get_home_dir();
+    session->config_dir = g_get_user_config_dir();
+    session->runtime_dir = g_get_user_runtime_dir();
+    gchar *cache_path = g_build_filename(g_get_user_cache_dir(), "musicfox-lyric", lrc_cache_name, nullptr);
+    session->lrc_cache_path = cache_path;
+    g_free(cache_path);
+}
+
+// 守护模式：unix:path=/run/user/<uid>/bus 属于 uid 这个用户，配置和歌词库从其主目录读，
+// pactl 连其 pulse/native 套接字；歌词库索引缓存写在守护进程自己的缓存目录并按 uid 区分，不往别人的主目录里写
+static bool open_bus_session(const std::string &address) {
+    if (std::find(g_skipped_buses.begin(), g_skipped_buses.end(), address) != g_skipped_buses.end()) return false;
+    for (Session *session : g_sessions) if (session->address == address) return true;
     GError *error = nullptr;
-    GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SESSION, nullptr, &error);
-    if (!connection) { std::cerr << "Failed to get session bus." << std::endl; return 1; }
-    
-    AppContext context = { connection, mpris_bus_name };
-    GMainLoop *loop = g_main_loop_new(nullptr, FALSE);
+    GDBusConnection *connection = g_dbus_connection_new_for_address_sync(address.c_str(), static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION), nullptr, nullptr, &error);
+    if (!connection) {
+        std::cerr << "Failed to connect to " << address << ": " << (error ? error->message : "unknown error") << std::endl;
+        g_clear_error(&error);
+        g_skipped_buses.push_back(address);
+        return false;
+    }
+    Session *session = session_new(connection, address);
+    unsigned uid = 0; char tail[8] = {};
+    bool other_user = sscanf(address.c_str(), "unix:path=/run/user/%u/%7s", &uid, tail) == 2 && g_strcmp0(tail, "bus") == 0 && uid != getuid();
+    struct passwd *pw = other_user ? getpwuid(uid) : nullptr;
+    if (pw) {
+        gchar *cache_name = g_strdup_printf("lrc_index.%u.v1", uid);
+        fill_own_dirs(session, cache_name);
+        g_free(cache_name);
+        session->home_dir = pw->pw_dir;
+        session->config_dir = session->home_dir + "/.config";
+        session->runtime_dir = "/run/user/" + std::to_string(uid);
+        session->pulse_server = "unix:" + session->runtime_dir + "/pulse/native";
+    } else {
+        fill_own_dirs(session, "lrc_index.v1");
+    }
+    if (!session_start(session)) { g_skipped_buses.push_back(address); session_close(session); return false; }
+    return true;
+}
+// --all-users：每 10 秒扫描一次 /run/user/*/bus，新登录的用户自动接上
+static gboolean scan_user_buses(gpointer user_data) {
+    GDir *dir = g_dir_open("/run/user", 0, nullptr);
+    if (!dir) return G_SOURCE_CONTINUE;
+    const gchar *entry;
+    while ((entry = g_dir_read_name(dir))) {
+        std::string socket = std::string("/run/user/") + entry + "/bus";
+        if (g_file_test(socket.c_str(), G_FILE_TEST_EXISTS)) open_bus_session("unix:path=" + socket);
+    }
+    g_dir_close(dir);
+    return G_SOURCE_CONTINUE;
+}
 
-    const char* object_manager_path = "/org/amazzy24128/MusicInfoService";
-    const char* object_path = "/org/amazzy24128/MusicInfoService/Player";
 
-    g_object_manager = g_dbus_object_manager_server_new(object_manager_path);
-    GDBusObjectSkeleton *object_skeleton = g_dbus_object_skeleton_new(object_path);
-    g_player_skeleton = music_info_service_player_skeleton_new();
-    g_dbus_object_skeleton_add_interface(object_skeleton, G_DBUS_INTERFACE_SKELETON(g_player_skeleton));
-    g_object_unref(g_player_skeleton);
-    g_dbus_object_manager_server_export(g_object_manager, object_skeleton);
-    g_object_unref(object_skeleton);
-    g_dbus_object_manager_server_set_connection(g_object_manager, connection);
-    
-    g_bus_own_name(G_BUS_TYPE_SESSION, "org.amazzy24128.MusicInfoService", G_BUS_NAME_OWNER_FLAGS_NONE, nullptr, on_name_acquired, on_name_lost, loop, nullptr);
+// 默认模式：会话总线连上后才建会话；连不上就退出
+static void on_session_bus_ready(GObject *source, GAsyncResult *res, gpointer user_data) {
+    GError *error = nullptr;
+    GDBusConnection *connection = g_bus_get_finish(res, &error);
+    if (!connection) {
+        std::cerr << "Failed to get session bus: " << (error ? error->message : "unknown error") << std::endl;
+        g_clear_error(&error);
+        g_exit_code = 1;
+        g_main_loop_quit(g_loop);
+        return;
+    }
+    Session *session = session_new(connection, "");
+    fill_own_dirs(session, "lrc_index.v1");
+    if (!session_start(session)) { g_exit_code = 1; session_close(session); }
+}
+
+int main(int argc, char *argv[])
+{
+    g_start_us = g_get_monotonic_time();
+    const char *columns_env = g_getenv("MUSICFOX_PANEL_COLUMNS");
+    if (columns_env) g_panel_columns = static_cast<int>(g_ascii_strtoll(columns_env, nullptr, 10));
+    if (argc > 1 && g_strcmp0(argv[1], "--calibrate-latency") == 0) return run_latency_calibration();
+    if (argc > 2 && g_strcmp0(argv[1], "--dump-timeline") == 0) return run_dump_timeline(argv[2]);
+    if (argc > 2 && g_strcmp0(argv[1], "--load-timeline") == 0) return run_load_timeline(argv[2]);
+    std::vector<std::string> bus_addresses;
+    for (int i = 1; i < argc; ++i) {
+        if (g_strcmp0(argv[i], "--bus") == 0 && i + 1 < argc) bus_addresses.push_back(argv[++i]);
+        else if (g_strcmp0(argv[i], "--all-users") == 0) g_all_users = true;
+        else { std::cerr << "Usage: " << argv[0] << " [--calibrate-latency | --dump-timeline FILE | --load-timeline FILE | [--bus ADDRESS]... [--all-users]]" << std::endl; return 2; }
+    }
+    g_daemon_mode = g_all_users || !bus_addresses.empty();
+    std::cout << "Starting Music Info D-Bus Service..." << std::endl;
 
-    guint mpris_sub_id = g_dbus_connection_signal_subscribe(connection, mpris_bus_name.c_str(), "org.freedesktop.DBus.Properties", "PropertiesChanged", "/org/mpris/MediaPlayer2", nullptr, G_DBUS_SIGNAL_FLAGS_NONE, on_any_signal, &context, nullptr);
-    guint sync_timer_id = g_timeout_add_seconds(1, sync_position_from_dbus, &context);
-    guint display_timer_id = g_timeout_add(100, predictive_update, &context);
+    const char *coalesce_env = g_getenv("MUSICFOX_COALESCE_MS");
+    if (coalesce_env) g_coalesce_window_ms = static_cast<guint>(g_ascii_strtoull(coalesce_env, nullptr, 10));
+    const char *offset_env = g_getenv("MUSICFOX_LYRIC_OFFSET_MS");
+    if (offset_env) { g_has_offset_override = true; g_offset_override_us = g_ascii_strtoll(offset_env, nullptr, 10) * 1000; }
+    const char *precise_env = g_getenv("MUSICFOX_PRECISE_TIMING");
+    g_precise_timing = !(precise_env && g_strcmp0(precise_env, "0") == 0);
+    const char *romanization_env = g_getenv("MUSICFOX_ROMANIZATION");
+    if (romanization_env && g_strcmp0(romanization_env, "0") != 0) {
+        g_romanization_pool = g_thread_pool_new(romanization_worker, nullptr, 1, FALSE, nullptr);
+    }
+    if (g_panel_columns > 0) g_layout_pool = g_thread_pool_new(layout_worker, nullptr, 1, FALSE, nullptr);
+    const char *lyrics_url_env = g_getenv("MUSICFOX_LYRICS_URL");
+    if (lyrics_url_env) g_lyrics_url = lyrics_url_env;
+    const char *lyrics_timeout_env = g_getenv("MUSICFOX_LYRICS_TIMEOUT_MS");
+    if (lyrics_timeout_env) g_lyrics_timeout_us = g_ascii_strtoll(lyrics_timeout_env, nullptr, 10) * 1000;
+    const char *trace_env = g_getenv("MUSICFOX_TRACE");
+    if (trace_env && g_strcmp0(trace_env, "0") == 0) trace_set_enabled(false);
+    const char *prefetch_env = g_getenv("MUSICFOX_PREFETCH");
+    if (!(prefetch_env && g_strcmp0(prefetch_env, "0") == 0)) {
+        g_prefetch_pool = g_thread_pool_new(prefetch_worker, nullptr, 1, FALSE, nullptr);
+    }
+    g_loop = g_main_loop_new(nullptr, FALSE);
 
-    sync_position_from_dbus(&context);
+    guint scan_timer_id = 0;
+    if (!g_daemon_mode) {
+        // 连接和 Hello 在主循环里异步完成，exec 之后不做任何阻塞调用
+        g_bus_get(G_BUS_TYPE_SESSION, nullptr, on_session_bus_ready, nullptr);
+    } else {
+        // 同一首歌在几个用户那里只解析一次
+        g_shared_lyrics = new SharedLyricCache();
+        for (const std::string &address : bus_addresses) open_bus_session(address);
+        if (g_all_users) {
+            scan_user_buses(nullptr);
+            scan_timer_id = g_timeout_add_seconds(10, scan_user_buses, nullptr);
+        }
+        if (g_sessions.empty() && !g_all_users) { std::cerr << "No session bus to serve." << std::endl; return 1; }
+    }
+    guint sigusr1_id = g_unix_signal_add(SIGUSR1, on_sigusr1, nullptr);
 
     std::cout << "Service is running. Waiting for events..." << std::endl;
-    g_main_loop_run(loop);
-
-    g_source_remove(display_timer_id);
-    g_source_remove(sync_timer_id);
-    g_dbus_connection_signal_unsubscribe(connection, mpris_sub_id);
-    g_main_loop_unref(loop);
-    g_object_unref(g_object_manager);
-    g_object_unref(connection);
-    
+    g_main_loop_run(g_loop);
+
+    if (scan_timer_id) g_source_remove(scan_timer_id);
+    g_source_remove(sigusr1_id);
+    while (!g_sessions.empty()) session_close(g_sessions.back());
+    // 预取线程会查本地歌词库：先等后台任务做完，再把它们投递回主线程的结果处理掉，会话随最后一个引用释放
+    if (g_prefetch_pool) g_thread_pool_free(g_prefetch_pool, TRUE, TRUE);
+    if (g_romanization_pool) g_thread_pool_free(g_romanization_pool, TRUE, TRUE);
+    if (g_layout_pool) g_thread_pool_free(g_layout_pool, TRUE, TRUE);
+    while (g_lookups_in_flight > 0) g_main_context_iteration(nullptr, TRUE);
+    while (g_main_context_iteration(nullptr, FALSE)) {}
+    g_main_loop_unref(g_loop);
+    g_loop = nullptr;
+    delete g_shared_lyrics;
     std::cout << "Service stopped." << std::endl;
-    return 0;
-}
\ No newline at end of file
+    return g_exit_code;
+}
@@ -0,0 +1,81 @@
+#include "deadline_source.h"
+
+#include <sys/prctl.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+typedef struct {
+    GSource base;
+    int fd;
+    gpointer tag;
+    int64_t target_us;
+} deadline_source_t;
+
+// 当前线程已设置的余量，避免每次都调用 prctl
+static int64_t g_thread_slack_us = -1;
+
+static void set_thread_slack(int64_t slack_us) {
+    if (slack_us == g_thread_slack_us) return;
+    g_thread_slack_us = slack_us;
+    // 0 会恢复为进程默认值，精确模式至少给 1ns
+    prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(slack_us > 0 ? slack_us * 1000 : 1), 0, 0, 0);
+}
+
+static void arm(deadline_source_t *source, int64_t fire_us) {
+    struct itimerspec spec = {};
+    if (fire_us > 0) { spec.it_value.tv_sec = fire_us / 1000000; spec.it_value.tv_nsec = (fire_us % 1000000) * 1000; }
+    timerfd_settime(source->fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+static gboolean deadline_check(GSource *base) {
+    deadline_source_t *source = reinterpret_cast<deadline_source_t*>(base);
+    return (g_source_query_unix_fd(base, source->tag) & G_IO_IN) != 0;
+}
+
+static gboolean deadline_dispatch(GSource *base, GSourceFunc callback, gpointer user_data) {
+    deadline_source_t *source = reinterpret_cast<deadline_source_t*>(base);
+    uint64_t expirations = 0;
+    if (read(source->fd, &expirations, sizeof(expirations)) != sizeof(expirations)) return G_SOURCE_CONTINUE;
+    if (callback) callback(user_data);
+    // 回调决定下一次时刻，源本身一直保留
+    return G_SOURCE_CONTINUE;
+}
+
+static void deadline_finalize(GSource *base) {
+    deadline_source_t *source = reinterpret_cast<deadline_source_t*>(base);
+    if (source->fd >= 0) close(source->fd);
+}
+
+static GSourceFuncs kDeadlineFuncs = { nullptr, deadline_check, deadline_dispatch, deadline_finalize, nullptr, nullptr };
+
+GSource *deadline_source_new(GSourceFunc callback, gpointer user_data) {
+    GSource *base = g_source_new(&kDeadlineFuncs, sizeof(deadline_source_t));
+    deadline_source_t *source = reinterpret_cast<deadline_source_t*>(base);
+    source->fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    source->target_us = 0;
+    source->tag = source->fd >= 0 ? g_source_add_unix_fd(base, source->fd, G_IO_IN) : nullptr;
+    g_source_set_callback(base, callback, user_data, nullptr);
+    g_source_set_name(base, "lyric-deadline");
+    return base;
+}
+
+void deadline_source_set(GSource *base, int64_t deadline_us, int64_t slack_us) {
+    deadline_source_t *source = reinterpret_cast<deadline_source_t*>(base);
+    if (source->fd < 0) return;
+    set_thread_slack(slack_us);
+    source->target_us = deadline_us;
+    int64_t fire_us = deadline_us;
+    if (slack_us > 1000) fire_us = (deadline_us + slack_us - 1) / slack_us * slack_us;
+    arm(source, fire_us > 0 ? fire_us : 1);
+}
+
+void deadline_source_clear(GSource *base) {
+    deadline_source_t *source = reinterpret_cast<deadline_source_t*>(base);
+    if (source->fd < 0) return;
+    source->target_us = 0;
+    arm(source, 0);
+}
+
+int64_t deadline_source_target(GSource *base) {
+    return reinterpret_cast<deadline_source_t*>(base)->target_us;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <glib.h>
+#include <cstdint>
+
+// 基于 timerfd 的 GSource：按 CLOCK_MONOTONIC 绝对时刻触发，不受 g_timeout_add 的合并和漂移影响。
+// 时刻与 steady_clock / clock_now_us 同源（微秒）。
+// slack_us 通过 prctl(PR_SET_TIMERSLACK) 设置主线程的定时器余量，同时影响 GLib 自身的 poll 超时：
+// 精确模式下余量很小，歌词换行的延迟约在 1ms 以内；宽松模式（如锁屏）下余量放大，
+// 触发时刻也向上对齐到余量的整数倍，让唤醒和其他定时器合并。
+
+GSource *deadline_source_new(GSourceFunc callback, gpointer user_data);
+// 设定下一次触发时刻；重复调用会覆盖之前的时刻，只触发一次
+void deadline_source_set(GSource *source, int64_t deadline_us, int64_t slack_us);
+void deadline_source_clear(GSource *source);
+// 最近一次触发对应的目标时刻，用于统计延迟
+int64_t deadline_source_target(GSource *source);
@@ -0,0 +1,19 @@
+// libFuzzer 入口：任意字节先过编码预处理再解析，检查输出是合法 UTF-8 且时间轴有序
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include "lyric_timeline.h"
+#include "text_encoding.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    std::string decoded = decode_lyric_text(std::string_view(reinterpret_cast<const char *>(data), size));
+    if (!utf8_validate_scalar(decoded.data(), decoded.size())) abort();
+    std::vector<LyricLine> timeline = parse_lrc(decoded);
+    for (size_t i = 1; i < timeline.size(); ++i) {
+        if (timeline[i - 1].timestamp_us > timeline[i].timestamp_us) abort();
+    }
+    if (!timeline.empty() && timeline_index_at(timeline, timeline.back().timestamp_us) != static_cast<int>(timeline.size()) - 1) abort();
+    return 0;
+}
@@ -0,0 +1,421 @@
+#include "lrc_index.h"
+#include "text_encoding.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char *kCacheMagic = "musicfox-lrc-index";
+constexpr int kCacheVersion = 1;
+// 模糊匹配的最低 Jaccard 相似度
+constexpr double kFuzzyThreshold = 0.6;
+// 只读取文件头部来提取 [ar:] / [ti:] 标签
+constexpr size_t kTagProbeBytes = 4096;
+// inotify 事件平静后多久把索引写回磁盘
+constexpr int kSaveDelayMs = 2000;
+constexpr uint32_t kWatchMask = IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_DELETE_SELF | IN_ONLYDIR;
+
+bool has_lrc_extension(const std::string &path) {
+    if (path.size() < 4) return false;
+    std::string ext = path.substr(path.size() - 4);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c){ return std::tolower(c); });
+    return ext == ".lrc";
+}
+
+// 持久化格式按行、以制表符分隔，字段里出现的控制字符统一替换成空格
+std::string sanitize_field(std::string s) {
+    for (char &c : s) if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+    s.erase(0, s.find_first_not_of(' '));
+    s.erase(s.find_last_not_of(' ') + 1);
+    return s;
+}
+
+std::string tag_value(const std::string &head, const char *tag) {
+    size_t pos = head.find(tag);
+    if (pos == std::string::npos) return "";
+    pos += std::strlen(tag);
+    size_t end = head.find(']', pos);
+    if (end == std::string::npos) return "";
+    return sanitize_field(head.substr(pos, end - pos));
+}
+
+// 把规范化后的字符串按码点切成三元组，哈希成 32 位指纹
+std::vector<uint32_t> trigrams(const std::string &normalized) {
+    std::vector<uint32_t> cps;
+    for (size_t i = 0; i < normalized.size();) {
+        unsigned char c = normalized[i];
+        size_t len = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : (c >> 3) == 0x1E ? 4 : 1;
+        uint32_t cp = 0;
+        for (size_t k = 0; k < len && i + k < normalized.size(); ++k) cp = (cp << 8) | static_cast<unsigned char>(normalized[i + k]);
+        cps.push_back(cp);
+        i += len;
+    }
+    std::vector<uint32_t> grams;
+    auto hash = [](const uint32_t *p, size_t n) {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 16777619u; }
+        return h;
+    };
+    if (cps.empty()) return grams;
+    if (cps.size() < 3) { grams.push_back(hash(cps.data(), cps.size())); return grams; }
+    for (size_t i = 0; i + 3 <= cps.size(); ++i) grams.push_back(hash(&cps[i], 3));
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+std::string make_key(const std::string &artist, const std::string &title) {
+    return LrcIndex::normalize(artist) + '\x1f' + LrcIndex::normalize(title);
+}
+
+} // namespace
+
+// --- MappedLrc ---
+
+MappedLrc::MappedLrc(MappedLrc &&other) noexcept : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr; other.size_ = 0;
+}
+MappedLrc &MappedLrc::operator=(MappedLrc &&other) noexcept {
+    if (this != &other) {
+        if (data_) munmap(data_, size_);
+        data_ = other.data_; size_ = other.size_;
+        other.data_ = nullptr; other.size_ = 0;
+    }
+    return *this;
+}
+MappedLrc::~MappedLrc() {
+    if (data_) munmap(data_, size_);
+}
+MappedLrc MappedLrc::open(const std::string &path) {
+    MappedLrc mapped;
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return mapped;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+            mapped.data_ = data; mapped.size_ = st.st_size;
+        }
+    }
+    close(fd);
+    return mapped;
+}
+
+// --- LrcIndex ---
+
+LrcIndex::LrcIndex(std::string root, std::string cache_path) : root_(std::move(root)), cache_path_(std::move(cache_path)) {}
+
+LrcIndex::~LrcIndex() { stop(); }
+
+void LrcIndex::start() {
+    if (worker_.joinable()) return;
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    stop_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    worker_ = std::thread(&LrcIndex::run, this);
+}
+
+void LrcIndex::stop() {
+    if (!worker_.joinable()) return;
+    uint64_t one = 1;
+    if (write(stop_fd_, &one, sizeof(one)) < 0) { /* eventfd 写失败时线程仍会在下次超时后退出 */ }
+    worker_.join();
+    if (inotify_fd_ >= 0) close(inotify_fd_);
+    if (stop_fd_ >= 0) close(stop_fd_);
+    inotify_fd_ = stop_fd_ = -1;
+    watch_dirs_.clear();
+}
+
+std::string LrcIndex::normalize(std::string_view s) {
+    std::string out;
+    out.reserve(s.size());
+    int depth = 0;
+    for (unsigned char c : s) {
+        // 括号里通常是 "(Live)"、"(Remastered 2011)" 之类的版本说明，不参与匹配
+        if (c == '(' || c == '[') { depth++; continue; }
+        if ((c == ')' || c == ']') && depth > 0) { depth--; continue; }
+        if (depth > 0) continue;
+        if (c >= 0x80) out.push_back(static_cast<char>(c));
+        else if (std::isalnum(c)) out.push_back(static_cast<char>(std::tolower(c)));
+    }
+    return out;
+}
+
+std::string LrcIndex::find(const std::string &artist, const std::string &title, bool *exact) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (exact) *exact = false;
+    if (live_count_ == 0) return "";
+    std::string key = make_key(artist, title);
+    auto match = by_key_.find(key);
+    if (match != by_key_.end()) {
+        if (exact) *exact = true;
+        return slots_[match->second].entry.path;
+    }
+
+    // 精确匹配失败：按共享三元组数量给候选打分
+    std::vector<uint32_t> grams = trigrams(key);
+    if (grams.empty()) return "";
+    std::unordered_map<size_t, uint32_t> shared;
+    for (uint32_t g : grams) {
+        auto it = by_gram_.find(g);
+        if (it == by_gram_.end()) continue;
+        for (size_t id : it->second) shared[id]++;
+    }
+    double best_score = kFuzzyThreshold;
+    size_t best_id = SIZE_MAX;
+    for (const auto &[id, count] : shared) {
+        double score = static_cast<double>(count) / (grams.size() + slots_[id].grams.size() - count);
+        if (score >= best_score) { best_score = score; best_id = id; }
+    }
+    return best_id == SIZE_MAX ? "" : slots_[best_id].entry.path;
+}
+
+size_t LrcIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return live_count_;
+}
+
+void LrcIndex::insert_locked(Entry entry) {
+    erase_locked(entry.path);
+    size_t id;
+    if (!free_slots_.empty()) { id = free_slots_.back(); free_slots_.pop_back(); }
+    else { id = slots_.size(); slots_.emplace_back(); }
+    Slot &slot = slots_[id];
+    slot.key = make_key(entry.artist, entry.title);
+    slot.grams = trigrams(slot.key);
+    slot.entry = std::move(entry);
+    slot.live = true;
+    by_path_[slot.entry.path] = id;
+    by_key_.emplace(slot.key, id);
+    for (uint32_t g : slot.grams) by_gram_[g].push_back(id);
+    live_count_++;
+    dirty_ = true;
+}
+
+void LrcIndex::erase_locked(const std::string &path) {
+    auto it = by_path_.find(path);
+    if (it == by_path_.end()) return;
+    size_t id = it->second;
+    by_path_.erase(it);
+    Slot &slot = slots_[id];
+    auto key_it = by_key_.find(slot.key);
+    if (key_it != by_key_.end() && key_it->second == id) {
+        // 同键的其他文件三元组完全相同，从第一个三元组的倒排表里找
+        by_key_.erase(key_it);
+        for (size_t other : by_gram_[slot.grams.front()]) {
+            if (other != id && slots_[other].key == slot.key) { by_key_.emplace(slot.key, other); break; }
+        }
+    }
+    for (uint32_t g : slot.grams) {
+        auto &postings = by_gram_[g];
+        auto pos = std::find(postings.begin(), postings.end(), id);
+        if (pos != postings.end()) { *pos = postings.back(); postings.pop_back(); }
+        if (postings.empty()) by_gram_.erase(g);
+    }
+    slot = Slot();
+    free_slots_.push_back(id);
+    live_count_--;
+    dirty_ = true;
+}
+
+// 以下函数只在后台线程运行；后台线程是唯一的写者，所以读取自身数据不必加锁
+
+void LrcIndex::run() {
+    load_cache();
+    std::unordered_set<std::string> seen;
+    scan_tree(root_, &seen);
+    std::vector<std::string> vanished;
+    for (const auto &[path, id] : by_path_) if (!seen.count(path)) vanished.push_back(path);
+    for (const auto &path : vanished) remove_file(path);
+    if (dirty_) save_cache();
+    watch_events();
+    if (dirty_) save_cache();
+}
+
+void LrcIndex::add_watch(const std::string &dir) {
+    if (inotify_fd_ < 0) return;
+    int wd = inotify_add_watch(inotify_fd_, dir.c_str(), kWatchMask);
+    if (wd >= 0) watch_dirs_[wd] = dir;
+}
+
+void LrcIndex::scan_tree(const std::string &dir, std::unordered_set<std::string> *seen) {
+    std::error_code ec;
+    if (!fs::is_directory(dir, ec)) return;
+    add_watch(dir);
+    fs::recursive_directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec), end;
+    for (; !ec && it != end; it.increment(ec)) {
+        const std::string path = it->path().string();
+        if (it->is_directory(ec)) { add_watch(path); continue; }
+        if (!has_lrc_extension(path) || path.find_first_of("\t\n") != std::string::npos) continue;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+        if (seen) seen->insert(path);
+        auto known = by_path_.find(path);
+        if (known != by_path_.end()) {
+            const Entry &entry = slots_[known->second].entry;
+            if (entry.mtime == st.st_mtime && entry.size == st.st_size) continue;
+        }
+        index_file(path, st.st_mtime, st.st_size);
+    }
+}
+
+void LrcIndex::index_file(const std::string &path, int64_t mtime, int64_t size) {
+    Entry entry;
+    entry.path = path; entry.mtime = mtime; entry.size = size;
+
+    std::string head(kTagProbeBytes, '\0');
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    ssize_t n = pread(fd, head.data(), head.size(), 0);
+    close(fd);
+    head.resize(n > 0 ? n : 0);
+    // 读满时截到最后一个换行，避免切断多字节字符而误判编码
+    if (head.size() == kTagProbeBytes) {
+        size_t last_newline = head.rfind('\n');
+        head.resize(last_newline == std::string::npos ? 0 : last_newline + 1);
+    }
+    head = decode_lyric_text(head);
+    entry.artist = tag_value(head, "[ar:");
+    entry.title = tag_value(head, "[ti:");
+
+    // 没有标签时从文件名 "Artist - Title.lrc" 推断
+    if (entry.title.empty()) {
+        std::string stem = fs::path(path).stem().string();
+        size_t sep = stem.find(" - ");
+        if (sep != std::string::npos) {
+            if (entry.artist.empty()) entry.artist = sanitize_field(stem.substr(0, sep));
+            entry.title = sanitize_field(stem.substr(sep + 3));
+        } else {
+            entry.title = sanitize_field(stem);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    insert_locked(std::move(entry));
+}
+
+void LrcIndex::remove_file(const std::string &path) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    erase_locked(path);
+}
+
+void LrcIndex::remove_tree(const std::string &dir) {
+    std::string prefix = dir + "/";
+    std::vector<std::string> doomed;
+    for (const auto &[path, id] : by_path_) if (path.compare(0, prefix.size(), prefix) == 0) doomed.push_back(path);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (const auto &path : doomed) erase_locked(path);
+}
+
+void LrcIndex::unwatch_tree(const std::string &dir) {
+    std::string prefix = dir + "/";
+    for (auto it = watch_dirs_.begin(); it != watch_dirs_.end();) {
+        if (it->second == dir || it->second.compare(0, prefix.size(), prefix) == 0) {
+            inotify_rm_watch(inotify_fd_, it->first);
+            it = watch_dirs_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void LrcIndex::watch_events() {
+    alignas(struct inotify_event) char buf[16 * 1024];
+    struct pollfd fds[2] = { { stop_fd_, POLLIN, 0 }, { inotify_fd_, POLLIN, 0 } };
+    nfds_t nfds = inotify_fd_ >= 0 ? 2 : 1;
+    while (true) {
+        int ready = poll(fds, nfds, dirty_ ? kSaveDelayMs : -1);
+        if (ready < 0) { if (errno == EINTR) continue; return; }
+        if (ready == 0) { save_cache(); continue; }
+        if (fds[0].revents) return;
+        if (!(fds[1].revents & POLLIN)) continue;
+
+        ssize_t len;
+        while ((len = read(inotify_fd_, buf, sizeof(buf))) > 0) {
+            for (char *p = buf; p < buf + len;) {
+                auto *ev = reinterpret_cast<struct inotify_event *>(p);
+                p += sizeof(struct inotify_event) + ev->len;
+                auto dir_it = watch_dirs_.find(ev->wd);
+                if (dir_it == watch_dirs_.end()) continue;
+                if (ev->mask & IN_IGNORED) { watch_dirs_.erase(dir_it); continue; }
+                if (ev->len == 0) continue;
+                std::string path = dir_it->second + "/" + ev->name;
+
+                if (ev->mask & IN_ISDIR) {
+                    if (ev->mask & (IN_CREATE | IN_MOVED_TO)) scan_tree(path, nullptr);
+                    else if (ev->mask & IN_DELETE) remove_tree(path);
+                    // 移出去的目录 watch 还在，之后的事件会按旧路径报上来，连同子目录一起取消
+                    else if (ev->mask & IN_MOVED_FROM) { unwatch_tree(path); remove_tree(path); }
+                    continue;
+                }
+                if (!has_lrc_extension(path)) continue;
+                if (ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                    struct stat st;
+                    if (stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode)) index_file(path, st.st_mtime, st.st_size);
+                } else if (ev->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    remove_file(path);
+                }
+            }
+        }
+    }
+}
+
+bool LrcIndex::load_cache() {
+    std::ifstream in(cache_path_);
+    if (!in) return false;
+    std::string line;
+    if (!std::getline(in, line)) return false;
+    std::stringstream header(line);
+    std::string magic, version, root;
+    std::getline(header, magic, '\t'); std::getline(header, version, '\t'); std::getline(header, root);
+    // 目录或格式版本变了就丢弃旧索引，全量重建
+    if (magic != kCacheMagic || version != std::to_string(kCacheVersion) || root != root_) return false;
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    while (std::getline(in, line)) {
+        std::stringstream fields(line);
+        std::string mtime, size;
+        Entry entry;
+        if (!std::getline(fields, mtime, '\t') || !std::getline(fields, size, '\t') || !std::getline(fields, entry.artist, '\t') || !std::getline(fields, entry.title, '\t') || !std::getline(fields, entry.path)) continue;
+        entry.mtime = std::strtoll(mtime.c_str(), nullptr, 10);
+        entry.size = std::strtoll(size.c_str(), nullptr, 10);
+        insert_locked(std::move(entry));
+    }
+    dirty_ = false;
+    return true;
+}
+
+void LrcIndex::save_cache() {
+    dirty_ = false;
+    if (cache_path_.empty()) return;
+    std::error_code ec;
+    fs::create_directories(fs::path(cache_path_).parent_path(), ec);
+    std::string tmp_path = cache_path_ + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        if (!out) return;
+        out << kCacheMagic << '\t' << kCacheVersion << '\t' << root_ << '\n';
+        for (const Slot &slot : slots_) {
+            if (!slot.live) continue;
+            const Entry &e = slot.entry;
+            out << e.mtime << '\t' << e.size << '\t' << e.artist << '\t' << e.title << '\t' << e.path << '\n';
+        }
+        if (!out) return;
+    }
+    fs::rename(tmp_path, cache_path_, ec);
+}
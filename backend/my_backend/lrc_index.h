@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// 本地 .lrc 歌词库索引
+// 后台线程增量扫描目录树，并用 inotify 保持更新；
+// 按规范化的 (artist, title) 精确匹配，失败时用三元组指纹做模糊匹配。
+// 索引持久化到磁盘，启动时先加载旧索引，只重新读取 mtime/size 变化的文件。
+
+// 命中后才 mmap 的歌词文件，析构时自动 munmap
+class MappedLrc {
+public:
+    MappedLrc() = default;
+    MappedLrc(const MappedLrc &) = delete;
+    MappedLrc &operator=(const MappedLrc &) = delete;
+    MappedLrc(MappedLrc &&other) noexcept;
+    MappedLrc &operator=(MappedLrc &&other) noexcept;
+    ~MappedLrc();
+
+    static MappedLrc open(const std::string &path);
+    bool valid() const { return data_ != nullptr; }
+    std::string_view text() const { return std::string_view(static_cast<const char *>(data_), size_); }
+
+private:
+    void *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+class LrcIndex {
+public:
+    struct Entry {
+        std::string path;
+        std::string artist;
+        std::string title;
+        int64_t mtime = 0;
+        int64_t size = 0;
+    };
+
+    // root: 歌词目录；cache_path: 持久化索引文件
+    LrcIndex(std::string root, std::string cache_path);
+    ~LrcIndex();
+
+    // 加载磁盘上的旧索引并启动后台扫描/监听线程
+    void start();
+    void stop();
+
+    // 返回匹配文件的路径，未找到返回空字符串；exact 非空时写入是否为精确匹配。主线程调用，只持有读锁
+    std::string find(const std::string &artist, const std::string &title, bool *exact = nullptr) const;
+    size_t size() const;
+
+    // 规范化：ASCII 转小写，去掉空白、标点和括号内的版本说明，多字节 UTF-8 原样保留
+    static std::string normalize(std::string_view s);
+
+private:
+    struct Slot {
+        Entry entry;
+        std::string key;
+        std::vector<uint32_t> grams;
+        bool live = false;
+    };
+
+    void run();
+    void scan_tree(const std::string &dir, std::unordered_set<std::string> *seen);
+    void watch_events();
+    void index_file(const std::string &path, int64_t mtime, int64_t size);
+    void remove_file(const std::string &path);
+    void remove_tree(const std::string &dir);
+    void add_watch(const std::string &dir);
+    void unwatch_tree(const std::string &dir);
+    bool load_cache();
+    void save_cache();
+
+    // 以下函数要求调用者已持有写锁
+    void insert_locked(Entry entry);
+    void erase_locked(const std::string &path);
+
+    std::string root_;
+    std::string cache_path_;
+
+    mutable std::shared_mutex mutex_;
+    std::vector<Slot> slots_;
+    std::vector<size_t> free_slots_;
+    std::unordered_map<std::string, size_t> by_path_;
+    // 多个文件规范化后同键时指向其中一个；删掉它时改指向剩下的
+    std::unordered_map<std::string, size_t> by_key_;
+    std::unordered_map<uint32_t, std::vector<size_t>> by_gram_;
+    size_t live_count_ = 0;
+    bool dirty_ = false;
+
+    int inotify_fd_ = -1;
+    int stop_fd_ = -1;
+    std::unordered_map<int, std::string> watch_dirs_;
+    std::thread worker_;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// LRC 时间标签解码：按字段宽度特化，不分配、不依赖 locale，全部 constexpr，
+// 正确性由 tests/test_lrc_timestamp.cpp 里的 static_assert 在编译期验证。
+// 支持的形状（方括号之内）：mm:ss.xx、mm:ss.xxx、mmm:ss
+
+constexpr bool lrc_is_digit(char c) { return c >= '0' && c <= '9'; }
+
+// 从 p 开始的 N 位十进制数，有非数字返回 -1
+template <int N>
+constexpr int64_t lrc_decode_digits(const char *p) {
+    int64_t value = 0;
+    for (int i = 0; i < N; ++i) {
+        if (!lrc_is_digit(p[i])) return -1;
+        value = value * 10 + (p[i] - '0');
+    }
+    return value;
+}
+
+// p 指向 '[' 之后，要求调用方保证至少有 MinuteDigits + 3 + (FractionDigits ? FractionDigits + 1 : 0) + 1 个字节可读。
+// 形状不符（分隔符、位数或结尾的 ']'）返回 -1，否则返回微秒
+template <int MinuteDigits, int FractionDigits>
+constexpr int64_t lrc_decode_timestamp(const char *p) {
+    static_assert(FractionDigits == 0 || FractionDigits == 2 || FractionDigits == 3, "fraction is centiseconds or milliseconds");
+    constexpr int kSeconds = MinuteDigits + 1;
+    constexpr int kClose = FractionDigits ? kSeconds + 3 + FractionDigits : kSeconds + 2;
+    if (p[MinuteDigits] != ':' || p[kClose] != ']') return -1;
+    if (FractionDigits && p[kSeconds + 2] != '.') return -1;
+    int64_t minutes = lrc_decode_digits<MinuteDigits>(p);
+    int64_t seconds = lrc_decode_digits<2>(p + kSeconds);
+    int64_t fraction = FractionDigits ? lrc_decode_digits<FractionDigits>(p + kSeconds + 3) : 0;
+    if (minutes < 0 || seconds < 0 || fraction < 0) return -1;
+    int64_t fraction_us = FractionDigits == 2 ? fraction * 10000 : fraction * 1000;
+    return (minutes * 60 + seconds) * 1000000 + fraction_us;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// 最常见的 "dd:dd.dd" 一次读 8 字节：校验分隔符和 6 个数字，再用一次乘法把相邻两位合成两位数。
+// 结果与 lrc_decode_timestamp<2, 2> 相同（不检查结尾的 ']'）
+inline int64_t lrc_decode_timestamp_swar(const char *p) {
+    uint64_t v; std::memcpy(&v, p, 8);
+    const uint64_t kSeparatorMask = 0x0000FF0000FF0000ULL, kSeparators = 0x00002E00003A0000ULL;  // 第 2 字节 ':'，第 5 字节 '.'
+    if ((v & kSeparatorMask) != kSeparators) return -1;
+    // 分隔符换成 '0' 后要求 8 个字节都是数字：高半字节为 3，且加 6 后不进位到 0x40
+    uint64_t w = (v & ~kSeparatorMask) | 0x0000300000300000ULL;
+    if ((((w & 0xF0F0F0F0F0F0F0F0ULL) | (((w + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))) != 0x3333333333333333ULL) return -1;
+    uint64_t d = w - 0x3030303030303030ULL;
+    // 每个字节乘 10 不超过 90，加上后一位不超过 99，字节之间不会进位；第 0、3、6 字节即分、秒、百分秒
+    uint64_t pairs = d * 10 + (d >> 8);
+    int64_t minutes = static_cast<int64_t>(pairs & 0xFF), seconds = static_cast<int64_t>((pairs >> 24) & 0xFF), centis = static_cast<int64_t>((pairs >> 48) & 0xFF);
+    return (minutes * 60 + seconds) * 1000000 + centis * 10000;
+}
+#else
+inline int64_t lrc_decode_timestamp_swar(const char *p) { return lrc_decode_timestamp<2, 2>(p); }
+#endif
+
+// 解析一行开头的时间标签：line 以 '[' 开头，len 为行长度。按 ']' 的位置区分形状，
+// 成功返回微秒并把 *text_begin 设为标签之后的位置，否则返回 -1
+inline int64_t lrc_parse_line_timestamp(const char *line, size_t len, size_t *text_begin) {
+    if (len < 8 || line[0] != '[') return -1;
+    if (line[7] == ']') { *text_begin = 8; return lrc_decode_timestamp<3, 0>(line + 1); }
+    if (len >= 10 && line[9] == ']') { *text_begin = 10; return lrc_decode_timestamp_swar(line + 1); }
+    if (len >= 11 && line[10] == ']') { *text_begin = 11; return lrc_decode_timestamp<2, 3>(line + 1); }
+    return -1;
+}
@@ -0,0 +1,445 @@
+#include "lyric_engine.h"
+
+#include <algorithm>
+
+#include "text_encoding.h"
+#include "trace_ring.h"
+
+void record_latency(latency_stat_t &stat, int64_t latency_us) {
+    stat.count++; stat.total_us += latency_us; stat.last_us = latency_us;
+    if (latency_us > stat.max_us) stat.max_us = latency_us;
+}
+
+std::vector<LyricLine> parse_lyric_payload(const std::string &payload) {
+    return parse_lrc(decode_lyric_text(payload));
+}
+
+SharedLyricCache::timeline_ptr SharedLyricCache::find(const std::string &text) {
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->text != text) continue;
+        std::rotate(it, it + 1, entries_.end());
+        return entries_.back().timeline;
+    }
+    return nullptr;
+}
+
+void SharedLyricCache::insert(const std::string &text, timeline_ptr timeline) {
+    for (entry_t &entry : entries_) if (entry.text == text) { entry.timeline = std::move(timeline); return; }
+    if (capacity_ == 0) return;
+    if (entries_.size() >= capacity_) entries_.erase(entries_.begin());
+    entries_.push_back(entry_t{text, std::move(timeline)});
+}
+
+LyricEngine::LyricEngine(EngineClock &clock, EngineCallbacks callbacks) : clock_(clock), callbacks_(std::move(callbacks)) {}
+
+// 根据上次同步的位置和经过的时间推算当前播放位置
+int64_t LyricEngine::predicted_position_us() {
+    return clock_predict_us(clock_model_, music_.is_playing, clock_.now_us());
+}
+
+int64_t LyricEngine::next_line_time_us() {
+    if (!music_.is_playing || clock_model_.rate <= 0.0) return -1;
+    int64_t now_us = clock_.now_us();
+    int64_t position_us = clock_predict_us(clock_model_, true, now_us);
+    int index = timeline_index_at(timeline_, position_us);
+    size_t next = static_cast<size_t>(index + 1);
+    int64_t boundary_us = next < timeline_.size() ? timeline_[next].timestamp_us : -1;
+    if (index >= 0 && static_cast<size_t>(index) < layout_.size()) {
+        const std::vector<LyricSegment> &segments = layout_[index];
+        size_t segment = static_cast<size_t>(segment_at(index, position_us) + 1);
+        if (segment < segments.size()) {
+            int64_t segment_us = timeline_[index].timestamp_us + segments[segment].offset_us;
+            if (boundary_us < 0 || segment_us < boundary_us) boundary_us = segment_us;
+        }
+    }
+    if (boundary_us < 0) return -1;
+    double remaining_us = static_cast<double>(boundary_us - position_us) / clock_model_.rate;
+    // 向上取整，保证到点时预测位置已越过该行
+    return now_us + static_cast<int64_t>(remaining_us) + 1;
+}
+
+// 播放器逐步发送歌词（空 → 截断 → 完整）时，新文本以上一份为前缀，只解析追加的行。
+// 不是延续时先看其他会话有没有解析过同一份文本；采用共享结果后 stream 清空，之后的延续按全文重新解析
+const LyricEngine::lyric_cache_t *LyricEngine::timeline_for_payload(const std::string &payload) {
+    if (cache_.serial == 0 || cache_.payload != payload) {
+        TraceScope trace(TraceEvent::Parse, static_cast<int64_t>(payload.size()));
+        cache_.payload = payload;
+        cache_.serial++;
+        std::string text = decode_lyric_text(payload);
+        if (!cache_.stream.text.empty() && lrc_stream_append(cache_.stream, text)) {
+            metrics_.incremental_parses++;
+        } else if (SharedLyricCache::timeline_ptr shared = shared_cache_ ? shared_cache_->find(text) : nullptr) {
+            cache_.stream = lrc_stream_t();
+            cache_.timeline = std::move(shared);
+            metrics_.shared_cache_hits++;
+            return cache_entry();
+        } else {
+            lrc_stream_reset(cache_.stream, text);
+        }
+        cache_.timeline = std::make_shared<const std::vector<LyricLine>>(lrc_stream_timeline(cache_.stream));
+        if (shared_cache_) shared_cache_->insert(text, cache_.timeline);
+    }
+    return cache_entry();
+}
+
+void LyricEngine::store_prefetched(PrefetchedLyrics prefetched) {
+    for (PrefetchedLyrics &slot : prefetched_) {
+        if (slot.trackid == prefetched.trackid) { slot = std::move(prefetched); return; }
+    }
+    if (prefetched_.size() >= kPrefetchDepth) prefetched_.erase(prefetched_.begin());
+    prefetched_.push_back(std::move(prefetched));
+}
+
+bool LyricEngine::has_prefetched(const std::string &trackid) const {
+    for (const PrefetchedLyrics &slot : prefetched_) if (slot.trackid == trackid) return true;
+    return false;
+}
+
+// 命中时把预取的时间轴搬进缓存，*entry 为空表示预取时确认过没有歌词；没有命中返回 false
+bool LyricEngine::take_prefetched(bool from_player, const std::string &payload, const lyric_cache_t **entry) {
+    for (auto it = prefetched_.begin(); it != prefetched_.end(); ++it) {
+        if (it->trackid != music_.trackid || it->from_player != from_player || (from_player && it->payload != payload)) continue;
+        cache_.payload = std::move(it->payload);
+        cache_.timeline = std::make_shared<const std::vector<LyricLine>>(std::move(it->timeline));
+        cache_.stream = lrc_stream_t();
+        cache_.serial++;
+        prefetched_.erase(it);
+        metrics_.prefetch_hits++;
+        *entry = cache_entry();
+        return true;
+    }
+    return false;
+}
+
+// 播放器没给歌词（本地文件、歌词获取失败）时，先看预取时在本地歌词库查到的结果，再不行交给异步的来源流水线
+const LyricEngine::lyric_cache_t *LyricEngine::resolve_lyrics(const PlayerUpdate &update) {
+    const lyric_cache_t *entry = nullptr;
+    if (update.has_lyrics) {
+        if (!take_prefetched(true, update.lyrics, &entry)) entry = timeline_for_payload(update.lyrics);
+        if (entry) return entry;
+    }
+    // 预取时确认本地没有歌词的仍交给流水线（还有别的来源）
+    take_prefetched(false, std::string(), &entry);
+    if (entry) return entry;
+    if (music_.title.empty()) return nullptr;
+    if (requested_trackid_ == music_.trackid) return adopt_found();
+    if (callbacks_.request_lyrics) {
+        requested_trackid_ = music_.trackid;
+        found_payload_.clear();
+        found_timeline_.reset();
+        callbacks_.request_lyrics(music_);
+    }
+    return nullptr;
+}
+
+// 流水线查到的时间轴直接装进缓存（SYLT 这类来源没有文本，不经过 timeline_for_payload）；已经装过的沿用，罗马音和分段得以保留
+const LyricEngine::lyric_cache_t *LyricEngine::adopt_found() {
+    if (!found_timeline_ || found_timeline_->empty()) return nullptr;
+    if (cache_.timeline != found_timeline_) {
+        cache_.payload = found_payload_;
+        cache_.timeline = found_timeline_;
+        cache_.stream = lrc_stream_t();
+        cache_.serial++;
+    }
+    return cache_entry();
+}
+
+// 替换当前时间轴；同一份缓存的时间轴不重复替换，已经算好的罗马音得以保留。
+// 歌词只是追加了新行时，开头文本相同的行的罗马音仍然有效，保留到后台生成完新结果为止；
+// 分段还要求行长不变
+void LyricEngine::set_timeline(const lyric_cache_t *entry) {
+    uint64_t serial = entry ? entry->serial : 0;
+    if (serial == timeline_serial_) return;
+    timeline_serial_ = serial;
+    size_t keep = 0, keep_layout = 0;
+    if (entry) {
+        const std::vector<LyricLine> &timeline = *entry->timeline;
+        while (keep < romanization_.size() && keep < timeline.size() && timeline[keep].text == timeline_[keep].text) keep++;
+        while (keep_layout < layout_.size() && keep_layout < timeline.size() && timeline[keep_layout].text == timeline_[keep_layout].text &&
+               timeline[keep_layout].end_us - timeline[keep_layout].timestamp_us == timeline_[keep_layout].end_us - timeline_[keep_layout].timestamp_us)
+            keep_layout++;
+        timeline_ = timeline;
+    } else {
+        timeline_.clear();
+    }
+    if (output_offset_us_ != 0) shift_timeline(output_offset_us_);
+    romanization_.resize(keep);
+    layout_.resize(keep_layout);
+    if (callbacks_.timeline_changed) callbacks_.timeline_changed(serial, timeline_);
+}
+
+// 最后一行没有下一行可用时 end_us 为 -1，保持不动，选中时再用曲目时长补上
+void LyricEngine::shift_timeline(int64_t delta_us) {
+    for (size_t i = 0; i < timeline_.size(); ++i) {
+        timeline_[i].timestamp_us += delta_us;
+        if (timeline_[i].end_us != -1 || i + 1 < timeline_.size()) timeline_[i].end_us += delta_us;
+    }
+}
+
+// 行内最后一个已开始的段，没有分段时为 0
+int LyricEngine::segment_at(int index, int64_t position_us) const {
+    if (index < 0 || static_cast<size_t>(index) >= layout_.size()) return 0;
+    const std::vector<LyricSegment> &segments = layout_[index];
+    int segment = 0;
+    while (static_cast<size_t>(segment + 1) < segments.size() && timeline_[index].timestamp_us + segments[segment + 1].offset_us <= position_us) segment++;
+    return segment;
+}
+
+// 切换当前行（和行内的段）：歌词、分段、罗马音和行起止都只是查表，不做任何计算
+void LyricEngine::select_line(int index, int64_t position_us) {
+    line_index_ = index;
+    segment_index_ = segment_at(index, position_us);
+    if (index >= 0) state_.lyric = timeline_[index].text; else state_.lyric.clear();
+    if (index >= 0 && static_cast<size_t>(index) < layout_.size() && !layout_[index].empty()) state_.segment = layout_[index][segment_index_].text; else state_.segment = state_.lyric;
+    if (index >= 0 && static_cast<size_t>(index) < romanization_.size()) state_.romanization = romanization_[index]; else state_.romanization.clear();
+    size_t next = static_cast<size_t>(index + 1);
+    if (next < timeline_.size()) state_.next_lyric = timeline_[next].text; else state_.next_lyric.clear();
+    if (index >= 0) {
+        state_.line_start_us = timeline_[index].timestamp_us;
+        state_.line_end_us = timeline_[index].end_us;
+        if (state_.line_end_us == -1 && music_.duration_us > 0) state_.line_end_us = music_.duration_us + output_offset_us_;
+    } else {
+        state_.line_start_us = -1;
+        state_.line_end_us = timeline_.empty() ? -1 : timeline_[0].timestamp_us;
+    }
+}
+
+// 按已发布的锚点外推出的位置与引擎自己的预测比较；跳转、换歌、播放状态或速率变化一律重新发布
+bool LyricEngine::anchor_stale(int64_t now_us) const {
+    if (published_generation_ != generation_ || published_playing_ != music_.is_playing || published_anchor_.rate != clock_model_.rate) return true;
+    int64_t drift_us = clock_predict_us(published_anchor_, music_.is_playing, now_us) - clock_predict_us(clock_model_, music_.is_playing, now_us);
+    return drift_us > kAnchorToleranceUs || drift_us < -kAnchorToleranceUs;
+}
+
+void LyricEngine::emit(int64_t position_us) {
+    state_.artist = music_.artist; state_.title = music_.title; state_.is_playing = music_.is_playing;
+    state_.duration_us = music_.duration_us; state_.position_us = position_us;
+    if (anchor_stale(clock_.now_us())) {
+        published_anchor_ = clock_model_; published_playing_ = music_.is_playing; published_generation_ = generation_;
+        state_.anchor_time_us = clock_model_.anchor_time_us; state_.anchor_position_us = clock_model_.anchor_position_us; state_.rate = clock_model_.rate;
+    }
+    trace_instant(TraceEvent::Emit, line_index_);
+    if (callbacks_.emit_state) callbacks_.emit_state(state_);
+}
+
+// 后到的字段覆盖先到的；Metadata 在 MPRIS 里总是整体发送，歌词跟随最后一份元数据
+void LyricEngine::queue_player_update(PlayerUpdate update) {
+    metrics_.updates_received++;
+    if (!has_pending_) { pending_ = std::move(update); pending_received_us_ = clock_.now_us(); has_pending_ = true; return; }
+    if (update.has_status) { pending_.has_status = true; pending_.is_playing = update.is_playing; }
+    if (update.has_rate) { pending_.has_rate = true; pending_.rate = update.rate; }
+    if (update.has_metadata) {
+        pending_.has_metadata = true;
+        pending_.metadata = std::move(update.metadata);
+        pending_.has_lyrics = update.has_lyrics;
+        pending_.lyrics = std::move(update.lyrics);
+    }
+}
+
+void LyricEngine::flush_player_updates() {
+    if (!has_pending_) return;
+    has_pending_ = false;
+    PlayerUpdate update = std::move(pending_);
+    pending_ = PlayerUpdate();
+    apply_player_update(update, pending_received_us_);
+}
+
+void LyricEngine::on_player_update(const PlayerUpdate &update) {
+    metrics_.updates_received++;
+    apply_player_update(update, clock_.now_us());
+}
+
+// received_us 是这批变化中第一条信号到达的时间，换歌延迟包含合并窗口
+void LyricEngine::apply_player_update(const PlayerUpdate &update, int64_t received_us) {
+    metrics_.updates_applied++;
+
+    // 1. 用新数据填充临时变量，没给的字段继承旧值
+    music_t next = {};
+    next.is_playing = update.has_status ? update.is_playing : music_.is_playing;
+    if (update.has_metadata) {
+        next.trackid = update.metadata.trackid;
+        next.artist = update.metadata.artist;
+        next.title = update.metadata.title;
+        next.duration_us = update.metadata.duration_us;
+        next.url = update.metadata.url;
+    } else {
+        next.trackid = music_.trackid;
+        next.artist = music_.artist;
+        next.title = music_.title;
+        next.duration_us = music_.duration_us;
+        next.url = music_.url;
+    }
+
+    // 2. 判断是否是新歌、播放状态是否改变（必须在覆盖旧数据之前比较）
+    bool is_new_track = (!next.trackid.empty() && next.trackid != music_.trackid);
+    bool playback_state_changed = next.is_playing != music_.is_playing;
+    bool info_changed = next.artist != music_.artist || next.title != music_.title || next.duration_us != music_.duration_us;
+
+    if (is_new_track) {
+        // --- 换歌快速路径 ---
+        // a. 先假定位置为 0，立即发出标题/歌手，不等待解析和位置查询
+        generation_++;
+        trace_instant(TraceEvent::TrackChange, static_cast<int64_t>(generation_));
+        music_ = next;
+        set_timeline(nullptr);
+        select_line(-1, 0);
+        clock_sync(clock_model_, 0, clock_.now_us());
+        if (update.has_rate && update.rate > 0.0) clock_model_.rate = update.rate;
+        emit(0);
+        record_latency(metrics_.track_change_first_emit, clock_.now_us() - received_us);
+
+        // b. 请求真实位置，回复到达后由 on_position_sample 重新对齐
+        if (callbacks_.request_position) callbacks_.request_position(generation_);
+
+        // c. 解析歌词，时间轴一就绪就发出当前行
+        set_timeline(resolve_lyrics(update));
+        int64_t position_us = predicted_position_us();
+        select_line(timeline_index_at(timeline_, position_us), position_us);
+        emit(position_us);
+        record_latency(metrics_.track_change_lyric_emit, clock_.now_us() - received_us);
+        return;
+    }
+
+    // 3. 不是新歌：整体覆盖，保证状态原子性更新。
+    // 播放状态或速率变化前先在当前预测位置重新取锚点，暂停时不会退回到上次同步的位置
+    int64_t now_us = clock_.now_us();
+    if (playback_state_changed) clock_sync(clock_model_, predicted_position_us(), now_us);
+    bool rate_changed = update.has_rate && update.rate > 0.0 && update.rate != clock_model_.rate;
+    if (rate_changed) clock_set_rate(clock_model_, update.rate, music_.is_playing, now_us);
+    music_ = next;
+    bool timeline_changed = false;
+    if (update.has_metadata) {
+        uint64_t serial = timeline_serial_;
+        set_timeline(resolve_lyrics(update));
+        timeline_changed = timeline_serial_ != serial;
+    }
+    // 同一首歌的歌词更新了（逐步到达）时按当前位置立即重选行，不等下一个 tick，也不会先闪回空白；
+    // 暂停/继续、变速和标题等变化也立即发出，时钟锚点随之更新
+    if (timeline_changed || playback_state_changed || rate_changed || info_changed) {
+        int64_t position_us = predicted_position_us();
+        select_line(timeline_index_at(timeline_, position_us), position_us);
+        emit(position_us);
+    }
+
+    // 4. 播放状态变了（例如从暂停到播放），同步一次时间
+    if (playback_state_changed && callbacks_.request_position) callbacks_.request_position(generation_);
+}
+
+void LyricEngine::on_position_sample(int64_t position_us, uint64_t generation) {
+    trace_instant(TraceEvent::SyncReply, position_us);
+    if (generation != generation_) return;
+    clock_sync(clock_model_, position_us, clock_.now_us());
+    // 位置跳变可能导致换行，外推偏差超出容差时也要重新发布锚点，都立即刷新而不是等下一个 tick
+    int index = timeline_index_at(timeline_, position_us);
+    if (index != line_index_ || segment_at(index, position_us) != segment_index_ || anchor_stale(clock_.now_us())) {
+        select_line(index, position_us);
+        emit(position_us);
+    }
+}
+
+void LyricEngine::on_seek(int64_t position_us) {
+    // 跳转前发出的位置查询可能在跳转后才回复，带回的是旧位置，一并作废
+    generation_++;
+    trace_instant(TraceEvent::Seek, position_us);
+    clock_sync(clock_model_, position_us, clock_.now_us());
+    select_line(timeline_index_at(timeline_, position_us), position_us);
+    emit(position_us);
+}
+
+std::vector<int> LyricEngine::find_lines(const std::string &query) {
+    if (!search_built_ || search_serial_ != timeline_serial_) {
+        search_index_ = LyricSearchIndex(timeline_);
+        search_serial_ = timeline_serial_;
+        search_built_ = true;
+    }
+    return search_index_.find(query);
+}
+
+// 时间轴已加上输出延迟偏移，播放器位置要扣回去：播放器到这个位置时，这一行的声音正好开始
+int64_t LyricEngine::seek_to_line(int index) {
+    if (index < 0 || static_cast<size_t>(index) >= timeline_.size()) return -1;
+    int64_t position_us = std::max<int64_t>(0, timeline_[index].timestamp_us - output_offset_us_);
+    on_seek(position_us);
+    return position_us;
+}
+
+// timeline_serial_ 非 0 时当前时间轴一定来自 cache_，那里存的是未平移的原始时间
+TimelineSnapshot LyricEngine::snapshot() {
+    TimelineSnapshot snapshot;
+    snapshot.trackid = music_.trackid; snapshot.artist = music_.artist; snapshot.title = music_.title;
+    snapshot.duration_us = music_.duration_us; snapshot.is_playing = music_.is_playing;
+    snapshot.captured_us = clock_.now_us();
+    snapshot.anchor_time_us = clock_model_.anchor_time_us; snapshot.anchor_position_us = clock_model_.anchor_position_us; snapshot.rate = clock_model_.rate;
+    snapshot.output_offset_us = output_offset_us_;
+    if (timeline_serial_ != 0 && timeline_serial_ == cache_.serial && cache_.timeline) snapshot.timeline = *cache_.timeline;
+    return snapshot;
+}
+
+void LyricEngine::load_snapshot(const TimelineSnapshot &snapshot) {
+    generation_++;
+    trace_instant(TraceEvent::TrackChange, static_cast<int64_t>(generation_));
+    music_ = music_t{snapshot.trackid, snapshot.artist, snapshot.title, snapshot.duration_us, snapshot.is_playing};
+    cache_.payload.clear();
+    cache_.stream = lrc_stream_t();
+    cache_.timeline = std::make_shared<const std::vector<LyricLine>>(snapshot.timeline);
+    cache_.serial++;
+    // 先换偏移再换时间轴，set_timeline 按新偏移平移一次
+    output_offset_us_ = snapshot.output_offset_us;
+    set_timeline(cache_entry());
+    clock_model_ = clock_model_t{snapshot.anchor_position_us, snapshot.anchor_time_us, snapshot.rate};
+    int64_t position_us = predicted_position_us();
+    select_line(timeline_index_at(timeline_, position_us), position_us);
+    emit(position_us);
+}
+
+// 位置由客户端按时钟锚点自行外推，tick 只在换行时发出
+void LyricEngine::tick() {
+    int64_t position_us = predicted_position_us();
+    int index = timeline_index_at(timeline_, position_us);
+    if (index == line_index_ && segment_at(index, position_us) == segment_index_) { state_.position_us = position_us; return; }
+    select_line(index, position_us);
+    emit(position_us);
+}
+
+// 序号不匹配说明时间轴已经换了，直接丢弃
+void LyricEngine::on_romanization_ready(uint64_t serial, std::vector<std::string> romanized) {
+    if (serial != timeline_serial_) return;
+    romanization_ = std::move(romanized);
+    std::string previous = state_.romanization, previous_segment = state_.segment;
+    int64_t position_us = predicted_position_us();
+    select_line(line_index_, position_us);
+    if (state_.romanization != previous || state_.segment != previous_segment) emit(position_us);
+}
+
+void LyricEngine::on_layout_ready(uint64_t serial, std::vector<std::vector<LyricSegment>> layout) {
+    if (serial != timeline_serial_) return;
+    layout_ = std::move(layout);
+    std::string previous = state_.segment;
+    // 排版就绪时当前行可能已经播到后面的段
+    int64_t position_us = predicted_position_us();
+    select_line(line_index_, position_us);
+    if (state_.segment != previous) emit(position_us);
+}
+
+void LyricEngine::on_lyrics_found(PrefetchedLyrics found) {
+    if (found.trackid != requested_trackid_ || found.trackid != music_.trackid) return;
+    found_payload_ = std::move(found.payload);
+    found_timeline_ = std::make_shared<const std::vector<LyricLine>>(std::move(found.timeline));
+    if (found_timeline_->empty() || timeline_serial_ != 0) return;
+    set_timeline(adopt_found());
+    if (timeline_serial_ == 0) return;
+    int64_t position_us = predicted_position_us();
+    select_line(timeline_index_at(timeline_, position_us), position_us);
+    emit(position_us);
+}
+
+void LyricEngine::set_output_offset_us(int64_t offset_us) {
+    int64_t delta_us = offset_us - output_offset_us_;
+    if (delta_us == 0) return;
+    output_offset_us_ = offset_us;
+    shift_timeline(delta_us);
+    // 行起止时间都变了，即使当前行不变也重新发出
+    int64_t position_us = predicted_position_us();
+    select_line(timeline_index_at(timeline_, position_us), position_us);
+    emit(position_us);
+}
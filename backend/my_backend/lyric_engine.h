@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "clock_model.h"
+#include "lyric_layout.h"
+#include "lyric_search.h"
+#include "lyric_timeline.h"
+#include "timeline_snapshot.h"
+
+// 歌词引擎：曲目状态、时间轴、位置时钟和换歌逻辑，不依赖 GLib 和总线。
+// 输入是播放器事件（元数据/播放状态、位置采样、跳转、定时 tick），
+// 输出通过回调发出（显示状态、请求位置同步、时间轴更换）。
+// 时钟可注入，测试和基准可以用虚拟时间跑完数小时的播放。
+
+// url 是 xesam:url（本地文件时可用来读内嵌歌词），可能为空
+typedef struct { std::string trackid; std::string artist; std::string title; int64_t duration_us; bool is_playing; std::string url; } music_t;
+
+// 一条 MPRIS PropertiesChanged 带来的变化；没带的字段沿用旧值
+struct PlayerUpdate {
+    bool has_status = false;
+    bool is_playing = false;
+    bool has_rate = false;     // MPRIS Rate
+    double rate = 1.0;
+    bool has_metadata = false;
+    music_t metadata = {};     // is_playing 字段不使用
+    bool has_lyrics = false;   // xesam:asText
+    std::string lyrics;
+};
+
+// 预取的歌词：播放队列里即将播放的曲目，在工作线程上用 parse_lyric_payload 解析好后交给引擎，
+// 换到该曲目时直接采用，不再在主线程上解码和解析。
+// from_player 为 true 表示 payload 是播放器给的 xesam:asText，否则是本地歌词库查到的文本（可能为空）
+struct PrefetchedLyrics {
+    std::string trackid;
+    bool from_player = false;
+    std::string payload;
+    std::vector<LyricLine> timeline;
+};
+
+// 与引擎内部相同的解码和解析，可在任意线程调用
+std::vector<LyricLine> parse_lyric_payload(const std::string &payload);
+
+// 多个引擎（守护模式下每条会话总线一个）共用的解析结果：键为解码后的全文，值为只读时间轴。
+// 各引擎的歌词缓存直接持有同一份，只有平移输出延迟时才复制到自己的当前时间轴。
+// 按最近使用淘汰；只在主线程使用，不加锁
+class SharedLyricCache {
+public:
+    typedef std::shared_ptr<const std::vector<LyricLine>> timeline_ptr;
+    static constexpr size_t kDefaultCapacity = 32;
+    explicit SharedLyricCache(size_t capacity = kDefaultCapacity) : capacity_(capacity) {}
+    timeline_ptr find(const std::string &text);
+    void insert(const std::string &text, timeline_ptr timeline);
+    size_t size() const { return entries_.size(); }
+
+private:
+    typedef struct { std::string text; timeline_ptr timeline; } entry_t;
+    size_t capacity_;
+    // 最近用过的在末尾
+    std::vector<entry_t> entries_;
+};
+
+// 发给显示层的状态
+struct EngineState {
+    std::string artist;
+    std::string title;
+    bool is_playing = false;
+    std::string lyric;
+    // 当前该显示的一段：长行按顶栏宽度预先切段后随时间推进，不需要分段或排版未就绪时等于 lyric
+    std::string segment;
+    std::string romanization;
+    int64_t duration_us = 0;
+    int64_t position_us = 0;
+    // 当前行的起止（与 position_us 同一时间基准）和下一行文本，客户端据此自行计算行内进度和淡入淡出。
+    // 还没到第一行时 line_start_us 为 -1、line_end_us 为第一行开始；结束时间未知时为 -1
+    int64_t line_start_us = -1;
+    int64_t line_end_us = -1;
+    std::string next_lyric;
+    // 时钟锚点：客户端用 anchor_position_us + (now - anchor_time_us) * rate（暂停时不前进）自行外推位置，
+    // anchor_time_us 与引擎时钟同一基准（服务里是 CLOCK_MONOTONIC 微秒）。
+    // 只在跳转、换歌、暂停/继续、变速或外推偏差超过 kAnchorToleranceUs 时改变，平时不再推送位置
+    int64_t anchor_time_us = 0;
+    int64_t anchor_position_us = 0;
+    double rate = 1.0;
+};
+
+// 换歌延迟：从收到 PropertiesChanged 到发出第一条信号（标题/歌手）以及到时间轴就绪后的歌词信号
+typedef struct { uint64_t count; int64_t total_us; int64_t max_us; int64_t last_us; } latency_stat_t;
+void record_latency(latency_stat_t &stat, int64_t latency_us);
+// 合并比例 = updates_received / updates_applied；prefetch_hits 是直接采用预取时间轴的换歌次数；
+// incremental_parses 是歌词逐步到达时只解析了追加部分的次数；shared_cache_hits 是直接采用其他会话解析结果的次数
+typedef struct { latency_stat_t track_change_first_emit; latency_stat_t track_change_lyric_emit; uint64_t updates_received; uint64_t updates_applied; uint64_t prefetch_hits; uint64_t incremental_parses; uint64_t shared_cache_hits; } engine_metrics_t;
+
+struct EngineCallbacks {
+    std::function<void(const EngineState &)> emit_state;
+    // 需要向播放器查询真实位置；回复时把 generation 原样带回 on_position_sample
+    std::function<void(uint64_t generation)> request_position;
+    // 时间轴换了（serial 为 0 表示没有歌词），可在后台生成罗马音、排版后交回 on_romanization_ready、on_layout_ready
+    std::function<void(uint64_t serial, const std::vector<LyricLine> &timeline)> timeline_changed;
+    // 播放器没给歌词、也没有预取结果时异步查找（歌词来源流水线：本地歌词库、内嵌标签、HTTP……），
+    // 结果交回 on_lyrics_found；每首歌只请求一次
+    std::function<void(const music_t &music)> request_lyrics;
+};
+
+class LyricEngine {
+public:
+    LyricEngine(EngineClock &clock, EngineCallbacks callbacks);
+
+    void on_player_update(const PlayerUpdate &update);
+    // 合并突发的 PropertiesChanged：先并入待处理增量，由调用方在一次主循环迭代
+    // （或几毫秒的合并窗口）结束时调用 flush_player_updates，一串信号只解析和发出一次
+    void queue_player_update(PlayerUpdate update);
+    bool has_pending_update() const { return has_pending_; }
+    void flush_player_updates();
+    // 异步位置查询的回复；generation 与当前不符说明已经换歌或跳转，直接丢弃
+    void on_position_sample(int64_t position_us, uint64_t generation);
+    // 播放器的 Seeked 信号
+    void on_seek(int64_t position_us);
+    // 定时预测刷新
+    void tick();
+    void on_romanization_ready(uint64_t serial, std::vector<std::string> romanized);
+    // layout_timeline 的结果，与时间轴平行；序号不符时丢弃
+    void on_layout_ready(uint64_t serial, std::vector<std::vector<LyricSegment>> layout);
+    // request_lyrics 的结果，时间轴已在工作线程上解析好（为空表示没找到）；已换歌时丢弃，播放器这期间给了歌词时只保存不采用
+    void on_lyrics_found(PrefetchedLyrics found);
+    // 输出延迟补偿（正值表示歌词推迟），换设备或校准后设置；一次性平移时间轴，tick 里没有额外计算
+    void set_output_offset_us(int64_t offset_us);
+    int64_t output_offset_us() const { return output_offset_us_; }
+    // 保存一份预取结果，同一曲目覆盖旧的，最多保留 kPrefetchDepth 份
+    void store_prefetched(PrefetchedLyrics prefetched);
+    bool has_prefetched(const std::string &trackid) const;
+    // 在当前时间轴里找包含 query 的行（忽略大小写、空白和标点），返回行号；检索索引在换了时间轴后的第一次查找时建立
+    std::vector<int> find_lines(const std::string &query);
+    // 跳到第 index 行开头：立即按该位置重新锚定时钟并发出状态，不等下一次位置同步。
+    // 返回要发给播放器的位置（已扣除输出延迟偏移，不小于 0）；行号越界返回 -1，状态不变
+    int64_t seek_to_line(int index);
+    // 当前曲目的原始时间轴（未加偏移）、时钟锚点和偏移，用于导出排查
+    TimelineSnapshot snapshot();
+    // 离线重放：直接采用快照里的曲目、时间轴、偏移和锚点（算一次换歌），并发出当前行
+    void load_snapshot(const TimelineSnapshot &snapshot);
+    // 与其他引擎共用解析结果（可为 nullptr）；cache 须比引擎活得久
+    void set_shared_cache(SharedLyricCache *cache) { shared_cache_ = cache; }
+    static constexpr size_t kPrefetchDepth = 2;
+    static constexpr int64_t kAnchorToleranceUs = 20000;
+
+    uint64_t generation() const { return generation_; }
+    int64_t predicted_position_us();
+    // 按当前锚点和速率推算下一行（或当前行下一段）开始的时钟时刻；暂停、没有下一行时返回 -1
+    int64_t next_line_time_us();
+    const music_t &music() const { return music_; }
+    const EngineState &state() const { return state_; }
+    const engine_metrics_t &metrics() const { return metrics_; }
+    // 已加上输出延迟偏移的时间轴
+    const std::vector<LyricLine> &timeline() const { return timeline_; }
+    int line_index() const { return line_index_; }
+
+private:
+    // 歌词缓存：播放器会反复发送同一份歌词，编码转换和解析对每份原始歌词只做一次；
+    // stream 保存解码后的文本和已解析的行，下一份歌词是它的延续时只解析追加部分。
+    // timeline 只读，可能与其他引擎共用；没有歌词时为空指针或空表
+    typedef struct { std::string payload; SharedLyricCache::timeline_ptr timeline; uint64_t serial; lrc_stream_t stream; } lyric_cache_t;
+
+    const lyric_cache_t *timeline_for_payload(const std::string &payload);
+    bool take_prefetched(bool from_player, const std::string &payload, const lyric_cache_t **entry);
+    const lyric_cache_t *resolve_lyrics(const PlayerUpdate &update);
+    const lyric_cache_t *adopt_found();
+    const lyric_cache_t *cache_entry() const { return (cache_.timeline && !cache_.timeline->empty()) ? &cache_ : nullptr; }
+    void set_timeline(const lyric_cache_t *entry);
+    void apply_player_update(const PlayerUpdate &update, int64_t received_us);
+    void shift_timeline(int64_t delta_us);
+    void select_line(int index, int64_t position_us);
+    int segment_at(int index, int64_t position_us) const;
+    bool anchor_stale(int64_t now_us) const;
+    void emit(int64_t position_us);
+
+    EngineClock &clock_;
+    EngineCallbacks callbacks_;
+    music_t music_ = {};
+    std::vector<LyricLine> timeline_;
+    // 与 timeline_ 平行的罗马音数组，未就绪时为空
+    std::vector<std::string> romanization_;
+    // 与 timeline_ 平行的分段，未就绪时为空；段的时间相对行开始，平移输出延迟时不用改
+    std::vector<std::vector<LyricSegment>> layout_;
+    int line_index_ = -1;
+    int segment_index_ = 0;
+    int64_t output_offset_us_ = 0;
+    // 当前时间轴对应的歌词缓存序号，0 表示没有歌词
+    uint64_t timeline_serial_ = 0;
+    // 每次换歌或跳转递增
+    uint64_t generation_ = 0;
+    clock_model_t clock_model_ = {};
+    // 最近一次发布给客户端的锚点
+    clock_model_t published_anchor_ = {};
+    bool published_playing_ = false;
+    uint64_t published_generation_ = 0;
+    lyric_cache_t cache_ = {};
+    SharedLyricCache *shared_cache_ = nullptr;
+    LyricSearchIndex search_index_;
+    // 检索索引对应的 timeline_serial_
+    uint64_t search_serial_ = 0;
+    bool search_built_ = false;
+    std::vector<PrefetchedLyrics> prefetched_;
+    // 最近一次 request_lyrics 的曲目和查到的原始文本、时间轴，同一首歌之后的元数据更新直接沿用
+    std::string requested_trackid_;
+    std::string found_payload_;
+    SharedLyricCache::timeline_ptr found_timeline_;
+    EngineState state_;
+    engine_metrics_t metrics_ = {};
+    PlayerUpdate pending_;
+    bool has_pending_ = false;
+    int64_t pending_received_us_ = 0;
+};
@@ -0,0 +1,133 @@
+#include "lyric_layout.h"
+
+#include <cstdlib>
+
+namespace {
+
+typedef struct { char32_t c; size_t begin; size_t end; int columns; } glyph_t;
+
+std::vector<glyph_t> decode(std::string_view text) {
+    std::vector<glyph_t> glyphs;
+    glyphs.reserve(text.size());
+    const unsigned char *base = reinterpret_cast<const unsigned char *>(text.data()), *p = base, *end = base + text.size();
+    while (p < end) {
+        char32_t c; int len;
+        if (*p < 0x80) { c = *p; len = 1; }
+        else if ((*p & 0xE0) == 0xC0) { c = *p & 0x1F; len = 2; }
+        else if ((*p & 0xF0) == 0xE0) { c = *p & 0x0F; len = 3; }
+        else if ((*p & 0xF8) == 0xF0) { c = *p & 0x07; len = 4; }
+        else { c = 0xFFFD; len = 1; }
+        if (len > 1 && end - p < len) len = 1, c = 0xFFFD;
+        for (int i = 1; i < len; ++i) {
+            if ((p[i] & 0xC0) != 0x80) { c = 0xFFFD; len = 1; break; }
+            c = c << 6 | (p[i] & 0x3F);
+        }
+        size_t begin = static_cast<size_t>(p - base);
+        glyphs.push_back(glyph_t{c, begin, begin + len, display_columns(c)});
+        p += len;
+    }
+    return glyphs;
+}
+
+bool is_space(char32_t c) { return c == ' ' || c == '\t' || c == 0x3000; }
+
+// 之后适合断行的标点（逗号、句号、问号等，含全角）
+bool is_break_punct(char32_t c) {
+    switch (c) {
+    case ',': case '.': case '!': case '?': case ';': case ':': case ')':
+    case 0x3001: case 0x3002: case 0xFF0C: case 0xFF01: case 0xFF1F: case 0xFF1B: case 0xFF1A: case 0xFF09:
+    case 0x300D: case 0x300F: case 0x3011: case 0x2026: case 0x2014: case 0x301C: case 0xFF5E:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// 不能放在段首的（句读、闭括号、小假名长音等）和不能放在段尾的（开括号）
+bool no_line_start(char32_t c) { return is_break_punct(c) || c == 0x30FC || c == 0x3063 || c == 0x30C3; }
+bool no_line_end(char32_t c) { return c == '(' || c == 0x300C || c == 0x300E || c == 0x3010 || c == 0xFF08; }
+
+// glyphs[i - 1] 与 glyphs[i] 之间能否断开；*soft 表示在空格或标点处，优先选用
+bool can_break(const std::vector<glyph_t> &glyphs, size_t i, bool *soft) {
+    char32_t a = glyphs[i - 1].c, b = glyphs[i].c;
+    *soft = false;
+    if (is_space(b)) return false;
+    if (is_space(a) || (is_break_punct(a) && !no_line_start(b))) { *soft = true; return true; }
+    if (no_line_start(b) || no_line_end(a)) return false;
+    return glyphs[i - 1].columns == 2 || glyphs[i].columns == 2;
+}
+
+std::string trimmed(std::string_view text, const std::vector<glyph_t> &glyphs, size_t first, size_t last) {
+    while (first < last && is_space(glyphs[first].c)) ++first;
+    while (last > first && is_space(glyphs[last - 1].c)) --last;
+    if (first == last) return std::string();
+    return std::string(text.substr(glyphs[first].begin, glyphs[last - 1].end - glyphs[first].begin));
+}
+
+}  // namespace
+
+int display_columns(char32_t c) {
+    if (c < 0x20 || (c >= 0x7F && c < 0xA0)) return 0;
+    if ((c >= 0x0300 && c <= 0x036F) || (c >= 0x200B && c <= 0x200F) || (c >= 0xFE00 && c <= 0xFE0F) || c == 0x3099 || c == 0x309A) return 0;
+    if ((c >= 0x1100 && c <= 0x115F) || (c >= 0x2E80 && c <= 0x303E) || (c >= 0x3041 && c <= 0x33FF) || (c >= 0x3400 && c <= 0x4DBF) ||
+        (c >= 0x4E00 && c <= 0x9FFF) || (c >= 0xA000 && c <= 0xA4CF) || (c >= 0xAC00 && c <= 0xD7A3) || (c >= 0xF900 && c <= 0xFAFF) ||
+        (c >= 0xFE30 && c <= 0xFE4F) || (c >= 0xFF00 && c <= 0xFF60) || (c >= 0xFFE0 && c <= 0xFFE6) || (c >= 0x1F300 && c <= 0x1F64F) ||
+        (c >= 0x1F900 && c <= 0x1F9FF) || (c >= 0x20000 && c <= 0x3FFFD))
+        return 2;
+    return 1;
+}
+
+int display_columns(std::string_view text) {
+    int columns = 0;
+    for (const glyph_t &glyph : decode(text)) columns += glyph.columns;
+    return columns;
+}
+
+// 每段的目标宽度是剩余宽度按剩余段数平均；在放得下的断点里选离目标最近的，非空格/标点处的断点按多出 1/4 段宽计
+std::vector<LyricSegment> layout_lyric_line(const LyricLine &line, int max_columns) {
+    std::vector<LyricSegment> segments;
+    if (max_columns <= 0) return segments;
+    std::vector<glyph_t> glyphs = decode(line.text);
+    int total = 0;
+    for (const glyph_t &glyph : glyphs) total += glyph.columns;
+    if (total <= max_columns) return segments;
+
+    int64_t duration_us = line.end_us > line.timestamp_us ? line.end_us - line.timestamp_us : total * kColumnEstimateUs;
+    size_t first = 0;
+    int consumed = 0;
+    while (first < glyphs.size()) {
+        int remaining = total - consumed;
+        size_t last = glyphs.size();
+        if (remaining > max_columns) {
+            int pieces = (remaining + max_columns - 1) / max_columns;
+            int goal = (remaining + pieces - 1) / pieces;
+            size_t best = 0;
+            int best_cost = 0, width = glyphs[first].columns;
+            size_t hard = first + 1;
+            for (size_t i = first + 1; i < glyphs.size() && width + glyphs[i].columns <= max_columns; ++i) {
+                bool soft;
+                if (can_break(glyphs, i, &soft)) {
+                    int cost = std::abs(width - goal) + (soft ? 0 : max_columns / 4);
+                    if (best == 0 || cost <= best_cost) { best = i; best_cost = cost; }
+                }
+                width += glyphs[i].columns;
+                hard = i + 1;
+            }
+            last = best ? best : hard;
+        }
+        int width = 0;
+        for (size_t i = first; i < last; ++i) width += glyphs[i].columns;
+        std::string text = trimmed(line.text, glyphs, first, last);
+        if (!text.empty()) segments.push_back(LyricSegment{duration_us * consumed / total, std::move(text)});
+        consumed += width;
+        first = last;
+    }
+    return segments;
+}
+
+std::vector<std::vector<LyricSegment>> layout_timeline(const std::vector<LyricLine> &timeline, int max_columns) {
+    std::vector<std::vector<LyricSegment>> layout;
+    layout.reserve(timeline.size());
+    for (const LyricLine &line : timeline) layout.push_back(layout_lyric_line(line, max_columns));
+    return layout;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lyric_timeline.h"
+
+// 歌词排版：把放不进顶栏标签的长行预先切成几段，每段带行内开始时间，显示路径只按时间查表。
+// 宽度按终端列估算（东亚宽字符 2 列），不依赖字体；只在后台线程解析完时间轴后调用。
+
+// 汉字、假名、谚文、全角符号和 emoji 为 2 列，组合附加符号、零宽字符和控制字符为 0 列，其余 1 列
+int display_columns(char32_t codepoint);
+// 非法 UTF-8 字节按 1 列计
+int display_columns(std::string_view text);
+
+// offset_us 相对于行开始，第一段为 0
+struct LyricSegment { int64_t offset_us; std::string text; };
+
+// 行宽超过 max_columns 时切成若干段：段数尽量少，各段宽度尽量均匀，
+// 优先在空格和标点后断开，其次在两个宽字符之间，单词长于一段时硬切。
+// 行内时间按宽度比例分配；行结束时间未知时按每列 kColumnEstimateUs 估算。
+// 放得下（或 max_columns <= 0）时返回空表，显示整行
+static constexpr int64_t kColumnEstimateUs = 200000;
+std::vector<LyricSegment> layout_lyric_line(const LyricLine &line, int max_columns);
+
+// 与时间轴平行，不需要分段的行为空表
+std::vector<std::vector<LyricSegment>> layout_timeline(const std::vector<LyricLine> &timeline, int max_columns);
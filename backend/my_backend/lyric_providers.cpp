@@ -0,0 +1,312 @@
+#include "lyric_providers.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+typedef std::chrono::steady_clock steady;
+
+enum { kRunning, kHit, kMiss, kTimedOut, kCancelled };
+
+// 单次 poll 的上限：阻塞中的 HTTP 请求最多这么久就会发现被取消
+const int kPollSliceMs = 50;
+const size_t kMaxBodySize = 4 << 20;
+
+int64_t elapsed_us(steady::time_point since) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(steady::now() - since).count();
+}
+
+// 等 fd 就绪；超过 deadline、被取消或出错返回 false
+bool wait_fd(int fd, short events, steady::time_point deadline, const std::atomic<bool> &cancelled) {
+    while (!cancelled) {
+        int64_t remaining_ms = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - steady::now()).count();
+        if (remaining_ms <= 0) return false;
+        struct pollfd pfd = {fd, events, 0};
+        int ready = poll(&pfd, 1, static_cast<int>(std::min<int64_t>(remaining_ms, kPollSliceMs)));
+        if (ready < 0 && errno != EINTR) return false;
+        if (ready > 0) return (pfd.revents & (POLLERR | POLLNVAL)) == 0 || (pfd.revents & POLLIN);
+    }
+    return false;
+}
+
+// http://host[:port][/path]，host 可以是方括号里的 IPv6 地址
+bool split_url(const std::string &url, std::string *host, std::string *port, std::string *path) {
+    static const char kScheme[] = "http://";
+    if (url.compare(0, sizeof(kScheme) - 1, kScheme) != 0) return false;
+    size_t begin = sizeof(kScheme) - 1;
+    size_t slash = url.find('/', begin);
+    std::string authority = url.substr(begin, slash == std::string::npos ? std::string::npos : slash - begin);
+    *path = slash == std::string::npos ? "/" : url.substr(slash);
+    size_t colon = authority.rfind(':');
+    if (colon != std::string::npos && authority.find(']', colon) == std::string::npos) {
+        *host = authority.substr(0, colon);
+        *port = authority.substr(colon + 1);
+    } else {
+        *host = authority;
+        *port = "80";
+    }
+    if (host->size() >= 2 && host->front() == '[' && host->back() == ']') *host = host->substr(1, host->size() - 2);
+    return !host->empty() && !port->empty();
+}
+
+int connect_to(const std::string &host, const std::string &port, steady::time_point deadline, const std::atomic<bool> &cancelled) {
+    struct addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *addresses = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) return -1;
+    int fd = -1;
+    for (struct addrinfo *ai = addresses; ai && fd < 0 && !cancelled; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+        int error = 0;
+        socklen_t length = sizeof(error);
+        if (errno == EINPROGRESS && wait_fd(fd, POLLOUT, deadline, cancelled) && getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0) break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addresses);
+    return fd;
+}
+
+void append_percent_encoded(std::string &out, const std::string &value) {
+    static const char kHex[] = "0123456789ABCDEF";
+    for (unsigned char c : value) {
+        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '.' || c == '_' || c == '~') {
+            out.push_back(static_cast<char>(c));
+        } else {
+            out.push_back('%'); out.push_back(kHex[c >> 4]); out.push_back(kHex[c & 15]);
+        }
+    }
+}
+
+}  // namespace
+
+struct LyricPipeline::Request {
+    uint64_t id = 0;
+    lyric_query_t query;
+    done_fn done;
+    std::atomic<bool> cancelled{false};
+    // 协调线程已经做完所有事，可以 join
+    std::atomic<bool> finished{false};
+    std::thread coordinator;
+    // 以下由 mutex 保护
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<int> state;
+    int winner = -1;
+    lyric_result_t result;
+};
+
+LyricPipeline::LyricPipeline(std::vector<LyricProvider> providers) : providers_(std::move(providers)), metrics_(providers_.size(), provider_metrics_t{}) {}
+
+LyricPipeline::~LyricPipeline() {
+    cancel_all();
+    std::vector<std::shared_ptr<Request>> requests;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests.swap(requests_);
+    }
+    for (const std::shared_ptr<Request> &request : requests) request->coordinator.join();
+}
+
+uint64_t LyricPipeline::lookup(lyric_query_t query, done_fn done) {
+    std::shared_ptr<Request> request = std::make_shared<Request>();
+    request->query = std::move(query);
+    request->done = std::move(done);
+    request->state.assign(providers_.size(), kRunning);
+    std::lock_guard<std::mutex> lock(mutex_);
+    reap_locked();
+    request->id = next_id_++;
+    for (provider_metrics_t &metrics : metrics_) metrics.requests++;
+    request->coordinator = std::thread(&LyricPipeline::run, this, request);
+    requests_.push_back(request);
+    return request->id;
+}
+
+void LyricPipeline::cancel(uint64_t id) {
+    std::shared_ptr<Request> request;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const std::shared_ptr<Request> &r : requests_) if (r->id == id) request = r;
+    }
+    if (!request) return;
+    std::lock_guard<std::mutex> lock(request->mutex);
+    request->cancelled = true;
+    request->cv.notify_all();
+}
+
+void LyricPipeline::cancel_all() {
+    std::vector<std::shared_ptr<Request>> requests;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests = requests_;
+    }
+    for (const std::shared_ptr<Request> &request : requests) {
+        std::lock_guard<std::mutex> lock(request->mutex);
+        request->cancelled = true;
+        request->cv.notify_all();
+    }
+}
+
+provider_metrics_t LyricPipeline::metrics(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return metrics_[index];
+}
+
+void LyricPipeline::reap_locked() {
+    auto done = std::partition(requests_.begin(), requests_.end(), [](const std::shared_ptr<Request> &r) { return !r->finished; });
+    for (auto it = done; it != requests_.end(); ++it) (*it)->coordinator.join();
+    requests_.erase(done, requests_.end());
+}
+
+// 每个来源一个线程；协调线程等到有来源命中、全部结束、被取消，期间按最近的期限醒来把超时的来源记为超时。
+// 锁的顺序总是先 request->mutex 再 mutex_
+void LyricPipeline::run(std::shared_ptr<Request> request) {
+    steady::time_point start = steady::now();
+    std::vector<std::thread> workers;
+    workers.reserve(providers_.size());
+    for (size_t i = 0; i < providers_.size(); ++i) {
+        workers.emplace_back([this, request, i, start] {
+            provider_lyrics_t lyrics = providers_[i].fetch ? providers_[i].fetch(request->query, request->cancelled) : provider_lyrics_t();
+            bool found = !lyrics.text.empty() || !lyrics.timeline.empty();
+            int64_t latency_us = elapsed_us(start);
+            std::lock_guard<std::mutex> lock(request->mutex);
+            // 已超时，或整个查找已被取消（由协调线程记为取消）
+            if (request->state[i] != kRunning || request->cancelled) return;
+            request->state[i] = found ? kHit : kMiss;
+            if (found && request->winner < 0) { request->winner = static_cast<int>(i); request->result = lyric_result_t{providers_[i].name, std::move(lyrics)}; }
+            {
+                std::lock_guard<std::mutex> metrics_lock(mutex_);
+                provider_metrics_t &metrics = metrics_[i];
+                if (request->state[i] == kHit) metrics.hits++; else metrics.misses++;
+                metrics.total_latency_us += latency_us;
+                metrics.max_latency_us = std::max(metrics.max_latency_us, latency_us);
+            }
+            request->cv.notify_all();
+        });
+    }
+
+    lyric_result_t result;
+    {
+        std::unique_lock<std::mutex> lock(request->mutex);
+        while (!request->cancelled && request->winner < 0) {
+            steady::time_point now = steady::now(), wake = steady::time_point::max();
+            bool running = false;
+            for (size_t i = 0; i < providers_.size(); ++i) {
+                if (request->state[i] != kRunning) continue;
+                if (providers_[i].deadline_us <= 0) { running = true; continue; }
+                steady::time_point deadline = start + std::chrono::microseconds(providers_[i].deadline_us);
+                if (deadline <= now) {
+                    request->state[i] = kTimedOut;
+                    std::lock_guard<std::mutex> metrics_lock(mutex_);
+                    metrics_[i].timeouts++;
+                } else {
+                    running = true;
+                    wake = std::min(wake, deadline);
+                }
+            }
+            if (!running) break;
+            if (wake == steady::time_point::max()) request->cv.wait(lock); else request->cv.wait_until(lock, wake);
+        }
+        // 没跑完的来源一律取消，之后返回的结果直接丢弃
+        request->cancelled = true;
+        std::lock_guard<std::mutex> metrics_lock(mutex_);
+        for (size_t i = 0; i < providers_.size(); ++i) {
+            if (request->state[i] == kRunning) { request->state[i] = kCancelled; metrics_[i].cancelled++; }
+        }
+        if (request->winner >= 0) metrics_[request->winner].wins++;
+        result = std::move(request->result);
+    }
+    request->done(std::move(result));
+    for (std::thread &worker : workers) worker.join();
+    request->finished = true;
+}
+
+std::string expand_url_template(const std::string &url_template, const lyric_query_t &query) {
+    std::string url;
+    url.reserve(url_template.size() + query.artist.size() * 3 + query.title.size() * 3);
+    for (size_t i = 0; i < url_template.size(); ++i) {
+        if (url_template[i] == '{') {
+            size_t close = url_template.find('}', i);
+            std::string key = close == std::string::npos ? std::string() : url_template.substr(i + 1, close - i - 1);
+            if (key == "artist") { append_percent_encoded(url, query.artist); i = close; continue; }
+            if (key == "title") { append_percent_encoded(url, query.title); i = close; continue; }
+            if (key == "trackid") { append_percent_encoded(url, query.trackid); i = close; continue; }
+            if (key == "duration") { url += std::to_string(query.duration_us / 1000000); i = close; continue; }
+        }
+        url.push_back(url_template[i]);
+    }
+    return url;
+}
+
+int http_get(const std::string &url, int64_t timeout_us, const std::atomic<bool> &cancelled, std::string *body) {
+    std::string host, port, path;
+    if (!split_url(url, &host, &port, &path)) return -1;
+    steady::time_point deadline = steady::now() + std::chrono::microseconds(timeout_us);
+    int fd = connect_to(host, port, deadline, cancelled);
+    if (fd < 0) return -1;
+
+    std::string request = "GET " + path + " HTTP/1.0\r\nHost: " + host + "\r\nUser-Agent: musicfox-lyric\r\nAccept: */*\r\nConnection: close\r\n\r\n";
+    size_t sent = 0;
+    while (sent < request.size()) {
+        if (!wait_fd(fd, POLLOUT, deadline, cancelled)) { close(fd); return -1; }
+        ssize_t n = send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno != EAGAIN && errno != EINTR) { close(fd); return -1; }
+        if (n > 0) sent += static_cast<size_t>(n);
+    }
+    std::string response;
+    char buf[16384];
+    while (response.size() <= kMaxBodySize) {
+        if (!wait_fd(fd, POLLIN, deadline, cancelled)) { close(fd); return -1; }
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n == 0) break;
+        if (n < 0 && errno != EAGAIN && errno != EINTR) { close(fd); return -1; }
+        if (n > 0) response.append(buf, static_cast<size_t>(n));
+    }
+    close(fd);
+
+    // 状态行 "HTTP/1.x NNN ..."，头部以空行结束
+    size_t header_end = response.find("\r\n\r\n");
+    if (response.compare(0, 5, "HTTP/") != 0 || header_end == std::string::npos) return -1;
+    size_t space = response.find(' ');
+    if (space == std::string::npos || space > header_end) return -1;
+    int status = std::atoi(response.c_str() + space + 1);
+    body->assign(response, header_end + 4, std::string::npos);
+    // 有 Content-Length 时以它为准（头部名不区分大小写）
+    for (size_t line = response.find("\r\n"); line < header_end; line = response.find("\r\n", line + 2)) {
+        static const char kLength[] = "content-length:";
+        if (strncasecmp(response.c_str() + line + 2, kLength, sizeof(kLength) - 1) != 0) continue;
+        size_t length = std::strtoull(response.c_str() + line + 2 + sizeof(kLength) - 1, nullptr, 10);
+        if (length < body->size()) body->resize(length);
+        break;
+    }
+    return status;
+}
+
+LyricProvider http_lyric_provider(std::string url_template, int64_t deadline_us) {
+    LyricProvider provider;
+    provider.name = "http";
+    provider.deadline_us = deadline_us;
+    // 不限期限时连接和读取也要有个上限
+    int64_t timeout_us = deadline_us > 0 ? deadline_us : 10000000;
+    provider.fetch = [url_template = std::move(url_template), timeout_us](const lyric_query_t &query, const std::atomic<bool> &cancelled) {
+        provider_lyrics_t lyrics;
+        if (query.title.empty()) return lyrics;
+        std::string body;
+        if (http_get(expand_url_template(url_template, query), timeout_us, cancelled, &body) == 200) lyrics.text = std::move(body);
+        return lyrics;
+    };
+    return provider;
+}
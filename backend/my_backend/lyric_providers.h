@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lyric_timeline.h"
+
+// 歌词来源流水线：播放器没在 xesam:asText 里给歌词时（引擎直接处理这一层），
+// 依次登记的来源（本地 .lrc 歌词库、音频文件内嵌标签、HTTP 歌词服务……）在各自的线程上同时查找，
+// 每个来源有自己的期限；第一份非空结果胜出，其余的来源被取消，它们的结果丢弃。
+// 每个来源记录命中率和耗时。不依赖 GLib，结果回调在工作线程上调用，由调用方转回主线程。
+
+// 查找条件；url 是 xesam:url（本地文件时可读内嵌标签），可能为空
+typedef struct { std::string trackid; std::string artist; std::string title; std::string url; int64_t duration_us; } lyric_query_t;
+
+// 来源查到的歌词：原始文本（未解码），或已经带时间的行（SYLT 这类同步歌词直接给时间轴，不经过文本）；都为空表示没找到
+typedef struct { std::string text; std::vector<LyricLine> timeline; } provider_lyrics_t;
+
+// 一个歌词来源。fetch 在工作线程上调用，找不到返回空的 provider_lyrics_t；
+// 阻塞较久的来源应每隔几十毫秒检查一次 cancelled，被取消或超过期限后尽早返回
+struct LyricProvider {
+    std::string name;
+    // 从开始查找算起的期限，0 表示不限；超过期限的来源按超时计，结果不再采用
+    int64_t deadline_us = 0;
+    std::function<provider_lyrics_t(const lyric_query_t &query, const std::atomic<bool> &cancelled)> fetch;
+};
+
+// requests 是被调用的次数，每次以 hits/misses/timeouts/cancelled 之一结束；wins 是胜出的次数（一次查找只有一个）。
+// 耗时只统计按时返回的调用（命中或落空）
+typedef struct { uint64_t requests; uint64_t hits; uint64_t misses; uint64_t timeouts; uint64_t cancelled; uint64_t wins; int64_t total_latency_us; int64_t max_latency_us; } provider_metrics_t;
+
+// provider 为空表示所有来源都落空、超时，或整个查找被取消
+typedef struct { std::string provider; provider_lyrics_t lyrics; } lyric_result_t;
+
+class LyricPipeline {
+public:
+    typedef std::function<void(lyric_result_t result)> done_fn;
+
+    explicit LyricPipeline(std::vector<LyricProvider> providers);
+    LyricPipeline(const LyricPipeline &) = delete;
+    LyricPipeline &operator=(const LyricPipeline &) = delete;
+    // 取消所有查找并等待线程退出
+    ~LyricPipeline();
+
+    // 开始一次查找，返回编号；done 恰好调用一次（取消时也会，结果为空），在流水线的工作线程上
+    uint64_t lookup(lyric_query_t query, done_fn done);
+    // 取消查找；已经结束的忽略
+    void cancel(uint64_t request);
+    void cancel_all();
+
+    size_t provider_count() const { return providers_.size(); }
+    const std::string &provider_name(size_t index) const { return providers_[index].name; }
+    provider_metrics_t metrics(size_t index) const;
+
+private:
+    struct Request;
+    void run(std::shared_ptr<Request> request);
+    void reap_locked();
+
+    std::vector<LyricProvider> providers_;
+    mutable std::mutex mutex_;
+    std::vector<provider_metrics_t> metrics_;
+    std::vector<std::shared_ptr<Request>> requests_;
+    uint64_t next_id_ = 1;
+};
+
+// 把 URL 模板里的 {artist}、{title}、{trackid} 换成百分号编码后的值，{duration} 换成整秒数
+std::string expand_url_template(const std::string &url_template, const lyric_query_t &query);
+
+// HTTP 歌词来源：对展开后的 URL 发 GET，200 的响应体即歌词，其他状态码算落空。
+// 只支持 http://（自建或本机的歌词服务、测试用的本地桩服务器），不支持 TLS 和重定向
+LyricProvider http_lyric_provider(std::string url_template, int64_t deadline_us);
+
+// 同步的 HTTP GET（HTTP/1.0，响应读到连接关闭为止）；返回状态码，连接失败、超时或被取消返回 -1
+int http_get(const std::string &url, int64_t timeout_us, const std::atomic<bool> &cancelled, std::string *body);
@@ -0,0 +1,89 @@
+#include "lyric_search.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+inline uint64_t bigram(char32_t a, char32_t b) { return static_cast<uint64_t>(a) << 32 | b; }
+
+// 返回 0 表示丢掉这个码点
+char32_t fold(char32_t c) {
+    if (c >= 0xFF01 && c <= 0xFF5E) c -= 0xFEE0;  // 全角 ASCII
+    if (c < 0x80) {
+        if (c >= 'A' && c <= 'Z') return c + ('a' - 'A');
+        if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) return c;
+        return 0;
+    }
+    // 全角空格、CJK 标点（、。「」等），以及半角片假名区的标点
+    if ((c >= 0x3000 && c <= 0x3003) || (c >= 0x3008 && c <= 0x3011) || (c >= 0x3014 && c <= 0x301F) || (c >= 0xFF61 && c <= 0xFF65)) return 0;
+    // 常用标点区（破折号、引号、省略号）
+    if (c >= 0x2010 && c <= 0x206F) return 0;
+    return c;
+}
+
+}  // namespace
+
+std::u32string lyric_search_normalize(const std::string &text) {
+    std::u32string out;
+    out.reserve(text.size());
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(text.data()), *end = p + text.size();
+    while (p < end) {
+        char32_t c; int len;
+        if (*p < 0x80) { c = *p; len = 1; }
+        else if ((*p & 0xE0) == 0xC0) { c = *p & 0x1F; len = 2; }
+        else if ((*p & 0xF0) == 0xE0) { c = *p & 0x0F; len = 3; }
+        else if ((*p & 0xF8) == 0xF0) { c = *p & 0x07; len = 4; }
+        else { ++p; continue; }
+        if (end - p < len) break;
+        bool valid = true;
+        for (int i = 1; i < len; ++i) {
+            if ((p[i] & 0xC0) != 0x80) { valid = false; break; }
+            c = c << 6 | (p[i] & 0x3F);
+        }
+        if (!valid) { ++p; continue; }
+        p += len;
+        if (char32_t folded = fold(c)) out.push_back(folded);
+    }
+    return out;
+}
+
+LyricSearchIndex::LyricSearchIndex(const std::vector<LyricLine> &timeline) {
+    lines_.reserve(timeline.size());
+    for (size_t i = 0; i < timeline.size(); ++i) {
+        lines_.push_back(lyric_search_normalize(timeline[i].text));
+        const std::u32string &line = lines_.back();
+        for (size_t j = 0; j + 1 < line.size(); ++j) {
+            std::vector<int> &posting = postings_[bigram(line[j], line[j + 1])];
+            // 行按顺序加入，同一行的重复 bigram 只记一次
+            if (posting.empty() || posting.back() != static_cast<int>(i)) posting.push_back(static_cast<int>(i));
+        }
+    }
+}
+
+std::vector<int> LyricSearchIndex::find(const std::string &query) const {
+    std::u32string needle = lyric_search_normalize(query);
+    std::vector<int> result;
+    if (needle.empty()) return result;
+    if (needle.size() == 1) {
+        for (size_t i = 0; i < lines_.size(); ++i) if (lines_[i].find(needle[0]) != std::u32string::npos) result.push_back(static_cast<int>(i));
+        return result;
+    }
+    // 先取最短的倒排表，再依次求交集
+    std::vector<const std::vector<int> *> lists;
+    for (size_t j = 0; j + 1 < needle.size(); ++j) {
+        auto it = postings_.find(bigram(needle[j], needle[j + 1]));
+        if (it == postings_.end()) return result;
+        lists.push_back(&it->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](const std::vector<int> *a, const std::vector<int> *b) { return a->size() < b->size(); });
+    std::vector<int> candidates = *lists[0], merged;
+    for (size_t k = 1; k < lists.size() && !candidates.empty(); ++k) {
+        merged.clear();
+        std::set_intersection(candidates.begin(), candidates.end(), lists[k]->begin(), lists[k]->end(), std::back_inserter(merged));
+        candidates.swap(merged);
+    }
+    // bigram 都在不代表连在一起，逐行确认
+    for (int index : candidates) if (lines_[index].find(needle) != std::u32string::npos) result.push_back(index);
+    return result;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "lyric_timeline.h"
+
+// 歌词检索：在一份时间轴里按子串找行，忽略大小写、空白和标点。
+// 建立时把每行规范化成码点序列，按相邻两个码点（bigram）建倒排表；查询时求各 bigram 倒排表的交集，
+// 再在候选行里确认子串。中文歌词没有空格分词，bigram 比按词索引更合适。单个字符的查询直接扫描各行
+
+// UTF-8 解码为码点：全角 ASCII 折成半角，字母转小写，丢掉空白、ASCII 标点和常见的中日文标点；非法字节跳过
+std::u32string lyric_search_normalize(const std::string &text);
+
+class LyricSearchIndex {
+public:
+    LyricSearchIndex() = default;
+    explicit LyricSearchIndex(const std::vector<LyricLine> &timeline);
+    // 包含 query 的行号，升序；query 规范化后为空时返回空
+    std::vector<int> find(const std::string &query) const;
+    size_t line_count() const { return lines_.size(); }
+
+private:
+    std::vector<std::u32string> lines_;
+    // bigram（两个码点拼成 64 位）→ 行号，升序且不重复
+    std::unordered_map<uint64_t, std::vector<int>> postings_;
+};
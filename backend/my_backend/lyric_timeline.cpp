@@ -0,0 +1,78 @@
+#include "lyric_timeline.h"
+
+#include <algorithm>
+
+#include "lrc_timestamp.h"
+
+static bool is_trim_char(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+static bool line_before(const LyricLine &a, const LyricLine &b) { return a.timestamp_us < b.timestamp_us; }
+
+// 解析 lrc_text 中 [begin, end) 范围内的各行，按原顺序追加到 out，空行（间奏标记）也保留。
+// 时间标签由 lrc_timestamp.h 的定宽解码器处理，每行只为歌词文本分配一次
+static void parse_lines(const std::string &lrc_text, size_t begin, size_t end, std::vector<LyricLine> &out) {
+    const char *data = lrc_text.data();
+    while (begin < end) {
+        size_t newline = lrc_text.find('\n', begin); if (newline == std::string::npos || newline > end) newline = end;
+        const char *line = data + begin; size_t len = newline - begin; begin = newline + 1;
+        size_t text_begin = 0;
+        int64_t total_microseconds = lrc_parse_line_timestamp(line, len, &text_begin);
+        if (total_microseconds < 0) continue;
+        size_t first = text_begin, last = len;
+        while (first < last && is_trim_char(line[first])) ++first;
+        while (last > first && is_trim_char(line[last - 1])) --last;
+        out.push_back({total_microseconds, std::string(line + first, last - first)});
+    }
+}
+
+// lines 已按时间稳定排序：从后往前一遍，记住最近一个更晚的时间戳和它是不是空行，据此填结束时间，再去掉空行
+static void finish_timeline(std::vector<LyricLine> &lyrics) {
+    int64_t next_start = -1; bool next_empty = false; size_t i = lyrics.size();
+    while (i > 0) {
+        int64_t ts = lyrics[i - 1].timestamp_us; bool group_empty = true;
+        while (i > 0 && lyrics[i - 1].timestamp_us == ts) { --i; lyrics[i].end_us = next_start; lyrics[i].gap_after = next_empty; if (!lyrics[i].text.empty()) group_empty = false; }
+        next_start = ts; next_empty = group_empty;
+    }
+    lyrics.erase(std::remove_if(lyrics.begin(), lyrics.end(), [](const LyricLine &line){ return line.text.empty(); }), lyrics.end());
+}
+
+std::vector<LyricLine> parse_lrc(const std::string &lrc_text) {
+    std::vector<LyricLine> lyrics;
+    parse_lines(lrc_text, 0, lrc_text.size(), lyrics);
+    std::stable_sort(lyrics.begin(), lyrics.end(), line_before);
+    finish_timeline(lyrics);
+    return lyrics;
+}
+
+bool lrc_stream_append(lrc_stream_t &stream, const std::string &lrc_text) {
+    if (lrc_text.size() < stream.text.size() || lrc_text.compare(0, stream.text.size(), stream.text) != 0) return false;
+    // 只解析上次最后一个换行之后的完整行；新行通常排在末尾，稳定合并保证同一时间戳仍按出现顺序
+    size_t complete_end = lrc_text.rfind('\n');
+    complete_end = (complete_end == std::string::npos || complete_end < stream.parsed_bytes) ? stream.parsed_bytes : complete_end + 1;
+    size_t middle = stream.lines.size();
+    parse_lines(lrc_text, stream.parsed_bytes, complete_end, stream.lines);
+    std::stable_sort(stream.lines.begin() + middle, stream.lines.end(), line_before);
+    std::inplace_merge(stream.lines.begin(), stream.lines.begin() + middle, stream.lines.end(), line_before);
+    stream.parsed_bytes = complete_end;
+    stream.text = lrc_text;
+    return true;
+}
+
+void lrc_stream_reset(lrc_stream_t &stream, const std::string &lrc_text) {
+    stream = lrc_stream_t();
+    lrc_stream_append(stream, lrc_text);
+}
+
+std::vector<LyricLine> lrc_stream_timeline(const lrc_stream_t &stream) {
+    std::vector<LyricLine> lyrics = stream.lines;
+    // 末尾没有换行的一行可能还没传完，每次单独解析，不进入已解析的行表
+    size_t middle = lyrics.size();
+    parse_lines(stream.text, stream.parsed_bytes, stream.text.size(), lyrics);
+    std::inplace_merge(lyrics.begin(), lyrics.begin() + middle, lyrics.end(), line_before);
+    finish_timeline(lyrics);
+    return lyrics;
+}
+
+int timeline_index_at(const std::vector<LyricLine> &timeline, int64_t position_us) {
+    auto it = std::upper_bound(timeline.begin(), timeline.end(), position_us, [](int64_t pos, const LyricLine &line){ return pos < line.timestamp_us; });
+    return static_cast<int>(it - timeline.begin()) - 1;
+}
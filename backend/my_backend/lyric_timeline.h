@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 歌词核心：LRC 解析和时间轴查找，不依赖 GLib，可单独测试、基准测试和模糊测试
+
+// end_us 是下一个更晚时间戳（包括间奏空行）的开始，最后一行未知时为 -1；
+// gap_after 表示这一行结束后是一段空白（间奏），而不是紧接着下一行歌词
+struct LyricLine { int64_t timestamp_us; std::string text; int64_t end_us = -1; bool gap_after = false; };
+
+// 解析 [mm:ss.xx] / [mm:ss.xxx] / [mmm:ss] 格式的歌词，结果按时间排序。
+// 空行只用来确定上一行的结束时间，不会出现在结果里
+std::vector<LyricLine> parse_lrc(const std::string &lrc_text);
+
+// 逐步到达的歌词：有的播放器先发空歌词，再发截断的，最后才发完整的。
+// 新文本以上一份为前缀时只解析追加的完整行，稳定合并进已排序的行表（含间奏空行）；
+// 末尾还没有换行的一行每次生成时间轴时单独解析。文本须已经过 decode_lyric_text
+typedef struct { std::string text; size_t parsed_bytes; std::vector<LyricLine> lines; } lrc_stream_t;
+
+// lrc_text 以 stream.text 为前缀时增量解析并返回 true，否则不改动 stream 并返回 false
+bool lrc_stream_append(lrc_stream_t &stream, const std::string &lrc_text);
+void lrc_stream_reset(lrc_stream_t &stream, const std::string &lrc_text);
+// 与 parse_lrc(stream.text) 结果相同
+std::vector<LyricLine> lrc_stream_timeline(const lrc_stream_t &stream);
+
+// 时间轴已按时间排序，二分查找最后一条 timestamp <= position 的歌词，没有返回 -1
+int timeline_index_at(const std::vector<LyricLine> &timeline, int64_t position_us);
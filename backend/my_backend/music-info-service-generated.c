@@ -1,1974 +0,0 @@
-/*
- * This file is generated by gdbus-codegen, do not modify it.
- *
- * The license of this code is the same as for the D-Bus interface description
- * it was derived from. Note that it links to GLib, so must comply with the
- * LGPL linking clauses.
- */
-
-#ifdef HAVE_CONFIG_H
-#  include "config.h"
-#endif
-
-#include "music-info-service-generated.h"
-
-#include <string.h>
-#ifdef G_OS_UNIX
-#  include <gio/gunixfdlist.h>
-#endif
-
-#ifdef G_ENABLE_DEBUG
-#define g_marshal_value_peek_boolean(v)  g_value_get_boolean (v)
-#define g_marshal_value_peek_char(v)     g_value_get_schar (v)
-#define g_marshal_value_peek_uchar(v)    g_value_get_uchar (v)
-#define g_marshal_value_peek_int(v)      g_value_get_int (v)
-#define g_marshal_value_peek_uint(v)     g_value_get_uint (v)
-#define g_marshal_value_peek_long(v)     g_value_get_long (v)
-#define g_marshal_value_peek_ulong(v)    g_value_get_ulong (v)
-#define g_marshal_value_peek_int64(v)    g_value_get_int64 (v)
-#define g_marshal_value_peek_uint64(v)   g_value_get_uint64 (v)
-#define g_marshal_value_peek_enum(v)     g_value_get_enum (v)
-#define g_marshal_value_peek_flags(v)    g_value_get_flags (v)
-#define g_marshal_value_peek_float(v)    g_value_get_float (v)
-#define g_marshal_value_peek_double(v)   g_value_get_double (v)
-#define g_marshal_value_peek_string(v)   (char*) g_value_get_string (v)
-#define g_marshal_value_peek_param(v)    g_value_get_param (v)
-#define g_marshal_value_peek_boxed(v)    g_value_get_boxed (v)
-#define g_marshal_value_peek_pointer(v)  g_value_get_pointer (v)
-#define g_marshal_value_peek_object(v)   g_value_get_object (v)
-#define g_marshal_value_peek_variant(v)  g_value_get_variant (v)
-#else /* !G_ENABLE_DEBUG */
-/* WARNING: This code accesses GValues directly, which is UNSUPPORTED API.
- *          Do not access GValues directly in your code. Instead, use the
- *          g_value_get_*() functions
- */
-#define g_marshal_value_peek_boolean(v)  (v)->data[0].v_int
-#define g_marshal_value_peek_char(v)     (v)->data[0].v_int
-#define g_marshal_value_peek_uchar(v)    (v)->data[0].v_uint
-#define g_marshal_value_peek_int(v)      (v)->data[0].v_int
-#define g_marshal_value_peek_uint(v)     (v)->data[0].v_uint
-#define g_marshal_value_peek_long(v)     (v)->data[0].v_long
-#define g_marshal_value_peek_ulong(v)    (v)->data[0].v_ulong
-#define g_marshal_value_peek_int64(v)    (v)->data[0].v_int64
-#define g_marshal_value_peek_uint64(v)   (v)->data[0].v_uint64
-#define g_marshal_value_peek_enum(v)     (v)->data[0].v_long
-#define g_marshal_value_peek_flags(v)    (v)->data[0].v_ulong
-#define g_marshal_value_peek_float(v)    (v)->data[0].v_float
-#define g_marshal_value_peek_double(v)   (v)->data[0].v_double
-#define g_marshal_value_peek_string(v)   (v)->data[0].v_pointer
-#define g_marshal_value_peek_param(v)    (v)->data[0].v_pointer
-#define g_marshal_value_peek_boxed(v)    (v)->data[0].v_pointer
-#define g_marshal_value_peek_pointer(v)  (v)->data[0].v_pointer
-#define g_marshal_value_peek_object(v)   (v)->data[0].v_pointer
-#define g_marshal_value_peek_variant(v)  (v)->data[0].v_pointer
-#endif /* !G_ENABLE_DEBUG */
-
-typedef struct
-{
-  GDBusArgInfo parent_struct;
-  gboolean use_gvariant;
-} _ExtendedGDBusArgInfo;
-
-typedef struct
-{
-  GDBusMethodInfo parent_struct;
-  const gchar *signal_name;
-  gboolean pass_fdlist;
-} _ExtendedGDBusMethodInfo;
-
-typedef struct
-{
-  GDBusSignalInfo parent_struct;
-  const gchar *signal_name;
-} _ExtendedGDBusSignalInfo;
-
-typedef struct
-{
-  GDBusPropertyInfo parent_struct;
-  const gchar *hyphen_name;
-  guint use_gvariant : 1;
-  guint emits_changed_signal : 1;
-} _ExtendedGDBusPropertyInfo;
-
-typedef struct
-{
-  GDBusInterfaceInfo parent_struct;
-  const gchar *hyphen_name;
-} _ExtendedGDBusInterfaceInfo;
-
-typedef struct
-{
-  const _ExtendedGDBusPropertyInfo *info;
-  guint prop_id;
-  GValue orig_value; /* the value before the change */
-} ChangedProperty;
-
-static void
-_changed_property_free (ChangedProperty *data)
-{
-  g_value_unset (&data->orig_value);
-  g_free (data);
-}
-
-static gboolean
-_g_strv_equal0 (gchar **a, gchar **b)
-{
-  gboolean ret = FALSE;
-  guint n;
-  if (a == NULL && b == NULL)
-    {
-      ret = TRUE;
-      goto out;
-    }
-  if (a == NULL || b == NULL)
-    goto out;
-  if (g_strv_length (a) != g_strv_length (b))
-    goto out;
-  for (n = 0; a[n] != NULL; n++)
-    if (g_strcmp0 (a[n], b[n]) != 0)
-      goto out;
-  ret = TRUE;
-out:
-  return ret;
-}
-
-static gboolean
-_g_variant_equal0 (GVariant *a, GVariant *b)
-{
-  gboolean ret = FALSE;
-  if (a == NULL && b == NULL)
-    {
-      ret = TRUE;
-      goto out;
-    }
-  if (a == NULL || b == NULL)
-    goto out;
-  ret = g_variant_equal (a, b);
-out:
-  return ret;
-}
-
-G_GNUC_UNUSED static gboolean
-_g_value_equal (const GValue *a, const GValue *b)
-{
-  gboolean ret = FALSE;
-  g_assert (G_VALUE_TYPE (a) == G_VALUE_TYPE (b));
-  switch (G_VALUE_TYPE (a))
-    {
-      case G_TYPE_BOOLEAN:
-        ret = (g_value_get_boolean (a) == g_value_get_boolean (b));
-        break;
-      case G_TYPE_UCHAR:
-        ret = (g_value_get_uchar (a) == g_value_get_uchar (b));
-        break;
-      case G_TYPE_INT:
-        ret = (g_value_get_int (a) == g_value_get_int (b));
-        break;
-      case G_TYPE_UINT:
-        ret = (g_value_get_uint (a) == g_value_get_uint (b));
-        break;
-      case G_TYPE_INT64:
-        ret = (g_value_get_int64 (a) == g_value_get_int64 (b));
-        break;
-      case G_TYPE_UINT64:
-        ret = (g_value_get_uint64 (a) == g_value_get_uint64 (b));
-        break;
-      case G_TYPE_DOUBLE:
-        {
-          /* Avoid -Wfloat-equal warnings by doing a direct bit compare */
-          gdouble da = g_value_get_double (a);
-          gdouble db = g_value_get_double (b);
-          ret = memcmp (&da, &db, sizeof (gdouble)) == 0;
-        }
-        break;
-      case G_TYPE_STRING:
-        ret = (g_strcmp0 (g_value_get_string (a), g_value_get_string (b)) == 0);
-        break;
-      case G_TYPE_VARIANT:
-        ret = _g_variant_equal0 (g_value_get_variant (a), g_value_get_variant (b));
-        break;
-      default:
-        if (G_VALUE_TYPE (a) == G_TYPE_STRV)
-          ret = _g_strv_equal0 (g_value_get_boxed (a), g_value_get_boxed (b));
-        else
-          g_critical ("_g_value_equal() does not handle type %s", g_type_name (G_VALUE_TYPE (a)));
-        break;
-    }
-  return ret;
-}
-
-static void
-_g_dbus_codegen_marshal_VOID__STRING_STRING_BOOLEAN_STRING_DOUBLE_DOUBLE (
-    GClosure     *closure,
-    GValue       *return_value G_GNUC_UNUSED,
-    unsigned int  n_param_values,
-    const GValue *param_values,
-    void         *invocation_hint G_GNUC_UNUSED,
-    void         *marshal_data)
-{
-  typedef void (*_GDbusCodegenMarshalVoid_StringStringBooleanStringDoubleDoubleFunc)
-       (void *data1,
-        const gchar *arg_artist,
-        const gchar *arg_title,
-        gboolean arg_is_playing,
-        const gchar *arg_current_lyric,
-        gdouble arg_duration,
-        gdouble arg_position,
-        void *data2);
-  _GDbusCodegenMarshalVoid_StringStringBooleanStringDoubleDoubleFunc callback;
-  GCClosure *cc = (GCClosure*) closure;
-  void *data1, *data2;
-
-  g_return_if_fail (n_param_values == 7);
-
-  if (G_CCLOSURE_SWAP_DATA (closure))
-    {
-      data1 = closure->data;
-      data2 = g_value_peek_pointer (param_values + 0);
-    }
-  else
-    {
-      data1 = g_value_peek_pointer (param_values + 0);
-      data2 = closure->data;
-    }
-
-  callback = (_GDbusCodegenMarshalVoid_StringStringBooleanStringDoubleDoubleFunc)
-    (marshal_data ? marshal_data : cc->callback);
-
-  callback (data1,
-            g_marshal_value_peek_string (param_values + 1),
-            g_marshal_value_peek_string (param_values + 2),
-            g_marshal_value_peek_boolean (param_values + 3),
-            g_marshal_value_peek_string (param_values + 4),
-            g_marshal_value_peek_double (param_values + 5),
-            g_marshal_value_peek_double (param_values + 6),
-            data2);
-}
-
-/* ------------------------------------------------------------------------
- * Code for interface org.amazzy24128.MusicInfoService.Player
- * ------------------------------------------------------------------------
- */
-
-/**
- * SECTION:MusicInfoServicePlayer
- * @title: MusicInfoServicePlayer
- * @short_description: Generated C code for the org.amazzy24128.MusicInfoService.Player D-Bus interface
- *
- * This section contains code for working with the <link linkend="gdbus-interface-org-amazzy24128-MusicInfoService-Player.top_of_page">org.amazzy24128.MusicInfoService.Player</link> D-Bus interface in C.
- */
-
-enum
-{
-  _MUSIC_INFO_SERVICE_PLAYER_STATE_CHANGED,
-};
-
-static unsigned _MUSIC_INFO_SERVICE_PLAYER_SIGNALS[1] = { 0 };
-
-/* ---- Introspection data for org.amazzy24128.MusicInfoService.Player ---- */
-
-static const _ExtendedGDBusArgInfo _music_info_service_player_signal_info_state_changed_ARG_artist =
-{
-  {
-    -1,
-    (gchar *) "artist",
-    (gchar *) "s",
-    NULL
-  },
-  FALSE
-};
-
-static const _ExtendedGDBusArgInfo _music_info_service_player_signal_info_state_changed_ARG_title =
-{
-  {
-    -1,
-    (gchar *) "title",
-    (gchar *) "s",
-    NULL
-  },
-  FALSE
-};
-
-static const _ExtendedGDBusArgInfo _music_info_service_player_signal_info_state_changed_ARG_is_playing =
-{
-  {
-    -1,
-    (gchar *) "is_playing",
-    (gchar *) "b",
-    NULL
-  },
-  FALSE
-};
-
-static const _ExtendedGDBusArgInfo _music_info_service_player_signal_info_state_changed_ARG_current_lyric =
-{
-  {
-    -1,
-    (gchar *) "current_lyric",
-    (gchar *) "s",
-    NULL
-  },
-  FALSE
-};
-
-static const _ExtendedGDBusArgInfo _music_info_service_player_signal_info_state_changed_ARG_duration =
-{
-  {
-    -1,
-    (gchar *) "duration",
-    (gchar *) "d",
-    NULL
-  },
-  FALSE
-};
-
-static const _ExtendedGDBusArgInfo _music_info_service_player_signal_info_state_changed_ARG_position =
-{
-  {
-    -1,
-    (gchar *) "position",
-    (gchar *) "d",
-    NULL
-  },
-  FALSE
-};
-
-static const GDBusArgInfo * const _music_info_service_player_signal_info_state_changed_ARG_pointers[] =
-{
-  &_music_info_service_player_signal_info_state_changed_ARG_artist.parent_struct,
-  &_music_info_service_player_signal_info_state_changed_ARG_title.parent_struct,
-  &_music_info_service_player_signal_info_state_changed_ARG_is_playing.parent_struct,
-  &_music_info_service_player_signal_info_state_changed_ARG_current_lyric.parent_struct,
-  &_music_info_service_player_signal_info_state_changed_ARG_duration.parent_struct,
-  &_music_info_service_player_signal_info_state_changed_ARG_position.parent_struct,
-  NULL
-};
-
-static const _ExtendedGDBusSignalInfo _music_info_service_player_signal_info_state_changed =
-{
-  {
-    -1,
-    (gchar *) "StateChanged",
-    (GDBusArgInfo **) &_music_info_service_player_signal_info_state_changed_ARG_pointers,
-    NULL
-  },
-  "state-changed"
-};
-
-static const GDBusSignalInfo * const _music_info_service_player_signal_info_pointers[] =
-{
-  &_music_info_service_player_signal_info_state_changed.parent_struct,
-  NULL
-};
-
-static const _ExtendedGDBusPropertyInfo _music_info_service_player_property_info_artist =
-{
-  {
-    -1,
-    (gchar *) "Artist",
-    (gchar *) "s",
-    G_DBUS_PROPERTY_INFO_FLAGS_READABLE,
-    NULL
-  },
-  "artist",
-  FALSE,
-  TRUE
-};
-
-static const _ExtendedGDBusPropertyInfo _music_info_service_player_property_info_title =
-{
-  {
-    -1,
-    (gchar *) "Title",
-    (gchar *) "s",
-    G_DBUS_PROPERTY_INFO_FLAGS_READABLE,
-    NULL
-  },
-  "title",
-  FALSE,
-  TRUE
-};
-
-static const _ExtendedGDBusPropertyInfo _music_info_service_player_property_info_is_playing =
-{
-  {
-    -1,
-    (gchar *) "IsPlaying",
-    (gchar *) "b",
-    G_DBUS_PROPERTY_INFO_FLAGS_READABLE,
-    NULL
-  },
-  "is-playing",
-  FALSE,
-  TRUE
-};
-
-static const _ExtendedGDBusPropertyInfo _music_info_service_player_property_info_current_lyric =
-{
-  {
-    -1,
-    (gchar *) "CurrentLyric",
-    (gchar *) "s",
-    G_DBUS_PROPERTY_INFO_FLAGS_READABLE,
-    NULL
-  },
-  "current-lyric",
-  FALSE,
-  TRUE
-};
-
-static const _ExtendedGDBusPropertyInfo _music_info_service_player_property_info_duration =
-{
-  {
-    -1,
-    (gchar *) "Duration",
-    (gchar *) "d",
-    G_DBUS_PROPERTY_INFO_FLAGS_READABLE,
-    NULL
-  },
-  "duration",
-  FALSE,
-  TRUE
-};
-
-static const _ExtendedGDBusPropertyInfo _music_info_service_player_property_info_position =
-{
-  {
-    -1,
-    (gchar *) "Position",
-    (gchar *) "d",
-    G_DBUS_PROPERTY_INFO_FLAGS_READABLE,
-    NULL
-  },
-  "position",
-  FALSE,
-  TRUE
-};
-
-static const GDBusPropertyInfo * const _music_info_service_player_property_info_pointers[] =
-{
-  &_music_info_service_player_property_info_artist.parent_struct,
-  &_music_info_service_player_property_info_title.parent_struct,
-  &_music_info_service_player_property_info_is_playing.parent_struct,
-  &_music_info_service_player_property_info_current_lyric.parent_struct,
-  &_music_info_service_player_property_info_duration.parent_struct,
-  &_music_info_service_player_property_info_position.parent_struct,
-  NULL
-};
-
-static const _ExtendedGDBusInterfaceInfo _music_info_service_player_interface_info =
-{
-  {
-    -1,
-    (gchar *) "org.amazzy24128.MusicInfoService.Player",
-    NULL,
-    (GDBusSignalInfo **) &_music_info_service_player_signal_info_pointers,
-    (GDBusPropertyInfo **) &_music_info_service_player_property_info_pointers,
-    NULL
-  },
-  "music-info-service-player",
-};
-
-
-/**
- * music_info_service_player_interface_info:
- *
- * Gets a machine-readable description of the <link linkend="gdbus-interface-org-amazzy24128-MusicInfoService-Player.top_of_page">org.amazzy24128.MusicInfoService.Player</link> D-Bus interface.
- *
- * Returns: (transfer none): A #GDBusInterfaceInfo. Do not free.
- */
-GDBusInterfaceInfo *
-music_info_service_player_interface_info (void)
-{
-  return (GDBusInterfaceInfo *) &_music_info_service_player_interface_info.parent_struct;
-}
-
-/**
- * music_info_service_player_override_properties:
- * @klass: The class structure for a #GObject derived class.
- * @property_id_begin: The property id to assign to the first overridden property.
- *
- * Overrides all #GObject properties in the #MusicInfoServicePlayer interface for a concrete class.
- * The properties are overridden in the order they are defined.
- *
- * Returns: The last property id.
- */
-guint
-music_info_service_player_override_properties (GObjectClass *klass, guint property_id_begin)
-{
-  g_object_class_override_property (klass, property_id_begin++, "artist");
-  g_object_class_override_property (klass, property_id_begin++, "title");
-  g_object_class_override_property (klass, property_id_begin++, "is-playing");
-  g_object_class_override_property (klass, property_id_begin++, "current-lyric");
-  g_object_class_override_property (klass, property_id_begin++, "duration");
-  g_object_class_override_property (klass, property_id_begin++, "position");
-  return property_id_begin - 1;
-}
-
-
-inline static void
-music_info_service_player_signal_marshal_state_changed (
-    GClosure     *closure,
-    GValue       *return_value,
-    unsigned int  n_param_values,
-    const GValue *param_values,
-    void         *invocation_hint,
-    void         *marshal_data)
-{
-  _g_dbus_codegen_marshal_VOID__STRING_STRING_BOOLEAN_STRING_DOUBLE_DOUBLE (closure,
-    return_value, n_param_values, param_values, invocation_hint, marshal_data);
-}
-
-
-/**
- * MusicInfoServicePlayer:
- *
- * Abstract interface type for the D-Bus interface <link linkend="gdbus-interface-org-amazzy24128-MusicInfoService-Player.top_of_page">org.amazzy24128.MusicInfoService.Player</link>.
- */
-
-/**
- * MusicInfoServicePlayerIface:
- * @parent_iface: The parent interface.
- * @get_artist: Getter for the #MusicInfoServicePlayer:artist property.
- * @get_current_lyric: Getter for the #MusicInfoServicePlayer:current-lyric property.
- * @get_duration: Getter for the #MusicInfoServicePlayer:duration property.
- * @get_is_playing: Getter for the #MusicInfoServicePlayer:is-playing property.
- * @get_position: Getter for the #MusicInfoServicePlayer:position property.
- * @get_title: Getter for the #MusicInfoServicePlayer:title property.
- * @state_changed: Handler for the #MusicInfoServicePlayer::state-changed signal.
- *
- * Virtual table for the D-Bus interface <link linkend="gdbus-interface-org-amazzy24128-MusicInfoService-Player.top_of_page">org.amazzy24128.MusicInfoService.Player</link>.
- */
-
-typedef MusicInfoServicePlayerIface MusicInfoServicePlayerInterface;
-G_DEFINE_INTERFACE (MusicInfoServicePlayer, music_info_service_player, G_TYPE_OBJECT)
-
-static void
-music_info_service_player_default_init (MusicInfoServicePlayerIface *iface)
-{
-  /* GObject signals for received D-Bus signals: */
-  /**
-   * MusicInfoServicePlayer::state-changed:
-   * @object: A #MusicInfoServicePlayer.
-   * @arg_artist: Argument.
-   * @arg_title: Argument.
-   * @arg_is_playing: Argument.
-   * @arg_current_lyric: Argument.
-   * @arg_duration: Argument.
-   * @arg_position: Argument.
-   *
-   * On the client-side, this signal is emitted whenever the D-Bus signal <link linkend="gdbus-signal-org-amazzy24128-MusicInfoService-Player.StateChanged">"StateChanged"</link> is received.
-   *
-   * On the service-side, this signal can be used with e.g. g_signal_emit_by_name() to make the object emit the D-Bus signal.
-   */
-  _MUSIC_INFO_SERVICE_PLAYER_SIGNALS[_MUSIC_INFO_SERVICE_PLAYER_STATE_CHANGED] =
-    g_signal_new ("state-changed",
-      G_TYPE_FROM_INTERFACE (iface),
-      G_SIGNAL_RUN_LAST,
-      G_STRUCT_OFFSET (MusicInfoServicePlayerIface, state_changed),
-      NULL,
-      NULL,
-      music_info_service_player_signal_marshal_state_changed,
-      G_TYPE_NONE,
-      6, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_BOOLEAN, G_TYPE_STRING, G_TYPE_DOUBLE, G_TYPE_DOUBLE);
-
-  /* GObject properties for D-Bus properties: */
-  /**
-   * MusicInfoServicePlayer:artist:
-   *
-   * Represents the D-Bus property <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Artist">"Artist"</link>.
-   *
-   * Since the D-Bus property for this #GObject property is readable but not writable, it is meaningful to read from it on both the client- and service-side. It is only meaningful, however, to write to it on the service-side.
-   */
-  g_object_interface_install_property (iface,
-    g_param_spec_string ("artist", "Artist", "Artist", NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-  /**
-   * MusicInfoServicePlayer:title:
-   *
-   * Represents the D-Bus property <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Title">"Title"</link>.
-   *
-   * Since the D-Bus property for this #GObject property is readable but not writable, it is meaningful to read from it on both the client- and service-side. It is only meaningful, however, to write to it on the service-side.
-   */
-  g_object_interface_install_property (iface,
-    g_param_spec_string ("title", "Title", "Title", NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-  /**
-   * MusicInfoServicePlayer:is-playing:
-   *
-   * Represents the D-Bus property <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.IsPlaying">"IsPlaying"</link>.
-   *
-   * Since the D-Bus property for this #GObject property is readable but not writable, it is meaningful to read from it on both the client- and service-side. It is only meaningful, however, to write to it on the service-side.
-   */
-  g_object_interface_install_property (iface,
-    g_param_spec_boolean ("is-playing", "IsPlaying", "IsPlaying", FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-  /**
-   * MusicInfoServicePlayer:current-lyric:
-   *
-   * Represents the D-Bus property <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.CurrentLyric">"CurrentLyric"</link>.
-   *
-   * Since the D-Bus property for this #GObject property is readable but not writable, it is meaningful to read from it on both the client- and service-side. It is only meaningful, however, to write to it on the service-side.
-   */
-  g_object_interface_install_property (iface,
-    g_param_spec_string ("current-lyric", "CurrentLyric", "CurrentLyric", NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-  /**
-   * MusicInfoServicePlayer:duration:
-   *
-   * Represents the D-Bus property <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Duration">"Duration"</link>.
-   *
-   * Since the D-Bus property for this #GObject property is readable but not writable, it is meaningful to read from it on both the client- and service-side. It is only meaningful, however, to write to it on the service-side.
-   */
-  g_object_interface_install_property (iface,
-    g_param_spec_double ("duration", "Duration", "Duration", -G_MAXDOUBLE, G_MAXDOUBLE, 0.0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-  /**
-   * MusicInfoServicePlayer:position:
-   *
-   * Represents the D-Bus property <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Position">"Position"</link>.
-   *
-   * Since the D-Bus property for this #GObject property is readable but not writable, it is meaningful to read from it on both the client- and service-side. It is only meaningful, however, to write to it on the service-side.
-   */
-  g_object_interface_install_property (iface,
-    g_param_spec_double ("position", "Position", "Position", -G_MAXDOUBLE, G_MAXDOUBLE, 0.0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-}
-
-/**
- * music_info_service_player_get_artist: (skip)
- * @object: A #MusicInfoServicePlayer.
- *
- * Gets the value of the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Artist">"Artist"</link> D-Bus property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client- and service-side.
- *
- * The returned value is only valid until the property changes so on the client-side it is only safe to use this function on the thread where @object was constructed. Use music_info_service_player_dup_artist() if on another thread.
- *
- * Returns: (transfer none) (nullable): The property value or %NULL if the property is not set. Do not free the returned value, it belongs to @object.
- */
-const gchar *
-music_info_service_player_get_artist (MusicInfoServicePlayer *object)
-{
-  g_return_val_if_fail (IS_MUSIC_INFO_SERVICE_PLAYER (object), NULL);
-
-  return MUSIC_INFO_SERVICE_PLAYER_GET_IFACE (object)->get_artist (object);
-}
-
-/**
- * music_info_service_player_dup_artist: (skip)
- * @object: A #MusicInfoServicePlayer.
- *
- * Gets a copy of the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Artist">"Artist"</link> D-Bus property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client- and service-side.
- *
- * Returns: (transfer full) (nullable): The property value or %NULL if the property is not set. The returned value should be freed with g_free().
- */
-gchar *
-music_info_service_player_dup_artist (MusicInfoServicePlayer *object)
-{
-  gchar *value;
-  g_object_get (G_OBJECT (object), "artist", &value, NULL);
-  return value;
-}
-
-/**
- * music_info_service_player_set_artist: (skip)
- * @object: A #MusicInfoServicePlayer.
- * @value: The value to set.
- *
- * Sets the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Artist">"Artist"</link> D-Bus property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the service-side.
- */
-void
-music_info_service_player_set_artist (MusicInfoServicePlayer *object, const gchar *value)
-{
-  g_object_set (G_OBJECT (object), "artist", value, NULL);
-}
-
-/**
- * music_info_service_player_get_title: (skip)
- * @object: A #MusicInfoServicePlayer.
- *
- * Gets the value of the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Title">"Title"</link> D-Bus property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client- and service-side.
- *
- * The returned value is only valid until the property changes so on the client-side it is only safe to use this function on the thread where @object was constructed. Use music_info_service_player_dup_title() if on another thread.
- *
- * Returns: (transfer none) (nullable): The property value or %NULL if the property is not set. Do not free the returned value, it belongs to @object.
- */
-const gchar *
-music_info_service_player_get_title (MusicInfoServicePlayer *object)
-{
-  g_return_val_if_fail (IS_MUSIC_INFO_SERVICE_PLAYER (object), NULL);
-
-  return MUSIC_INFO_SERVICE_PLAYER_GET_IFACE (object)->get_title (object);
-}
-
-/**
- * music_info_service_player_dup_title: (skip)
- * @object: A #MusicInfoServicePlayer.
- *
- * Gets a copy of the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Title">"Title"</link> D-Bus property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client- and service-side.
- *
- * Returns: (transfer full) (nullable): The property value or %NULL if the property is not set. The returned value should be freed with g_free().
- */
-gchar *
-music_info_service_player_dup_title (MusicInfoServicePlayer *object)
-{
-  gchar *value;
-  g_object_get (G_OBJECT (object), "title", &value, NULL);
-  return value;
-}
-
-/**
- * music_info_service_player_set_title: (skip)
- * @object: A #MusicInfoServicePlayer.
- * @value: The value to set.
- *
- * Sets the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Title">"Title"</link> D-Bus property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the service-side.
- */
-void
-music_info_service_player_set_title (MusicInfoServicePlayer *object, const gchar *value)
-{
-  g_object_set (G_OBJECT (object), "title", value, NULL);
-}
-
-/**
- * music_info_service_player_get_is_playing: (skip)
- * @object: A #MusicInfoServicePlayer.
- *
- * Gets the value of the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.IsPlaying">"IsPlaying"</link> D-Bus property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client- and service-side.
- *
- * Returns: The property value.
- */
-gboolean 
-music_info_service_player_get_is_playing (MusicInfoServicePlayer *object)
-{
-  g_return_val_if_fail (IS_MUSIC_INFO_SERVICE_PLAYER (object), FALSE);
-
-  return MUSIC_INFO_SERVICE_PLAYER_GET_IFACE (object)->get_is_playing (object);
-}
-
-/**
- * music_info_service_player_set_is_playing: (skip)
- * @object: A #MusicInfoServicePlayer.
- * @value: The value to set.
- *
- * Sets the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.IsPlaying">"IsPlaying"</link> D-Bus property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the service-side.
- */
-void
-music_info_service_player_set_is_playing (MusicInfoServicePlayer *object, gboolean value)
-{
-  g_object_set (G_OBJECT (object), "is-playing", value, NULL);
-}
-
-/**
- * music_info_service_player_get_current_lyric: (skip)
- * @object: A #MusicInfoServicePlayer.
- *
- * Gets the value of the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.CurrentLyric">"CurrentLyric"</link> D-Bus property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client- and service-side.
- *
- * The returned value is only valid until the property changes so on the client-side it is only safe to use this function on the thread where @object was constructed. Use music_info_service_player_dup_current_lyric() if on another thread.
- *
- * Returns: (transfer none) (nullable): The property value or %NULL if the property is not set. Do not free the returned value, it belongs to @object.
- */
-const gchar *
-music_info_service_player_get_current_lyric (MusicInfoServicePlayer *object)
-{
-  g_return_val_if_fail (IS_MUSIC_INFO_SERVICE_PLAYER (object), NULL);
-
-  return MUSIC_INFO_SERVICE_PLAYER_GET_IFACE (object)->get_current_lyric (object);
-}
-
-/**
- * music_info_service_player_dup_current_lyric: (skip)
- * @object: A #MusicInfoServicePlayer.
- *
- * Gets a copy of the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.CurrentLyric">"CurrentLyric"</link> D-Bus property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client- and service-side.
- *
- * Returns: (transfer full) (nullable): The property value or %NULL if the property is not set. The returned value should be freed with g_free().
- */
-gchar *
-music_info_service_player_dup_current_lyric (MusicInfoServicePlayer *object)
-{
-  gchar *value;
-  g_object_get (G_OBJECT (object), "current-lyric", &value, NULL);
-  return value;
-}
-
-/**
- * music_info_service_player_set_current_lyric: (skip)
- * @object: A #MusicInfoServicePlayer.
- * @value: The value to set.
- *
- * Sets the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.CurrentLyric">"CurrentLyric"</link> D-Bus property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the service-side.
- */
-void
-music_info_service_player_set_current_lyric (MusicInfoServicePlayer *object, const gchar *value)
-{
-  g_object_set (G_OBJECT (object), "current-lyric", value, NULL);
-}
-
-/**
- * music_info_service_player_get_duration: (skip)
- * @object: A #MusicInfoServicePlayer.
- *
- * Gets the value of the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Duration">"Duration"</link> D-Bus property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client- and service-side.
- *
- * Returns: The property value.
- */
-gdouble 
-music_info_service_player_get_duration (MusicInfoServicePlayer *object)
-{
-  g_return_val_if_fail (IS_MUSIC_INFO_SERVICE_PLAYER (object), 0.0);
-
-  return MUSIC_INFO_SERVICE_PLAYER_GET_IFACE (object)->get_duration (object);
-}
-
-/**
- * music_info_service_player_set_duration: (skip)
- * @object: A #MusicInfoServicePlayer.
- * @value: The value to set.
- *
- * Sets the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Duration">"Duration"</link> D-Bus property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the service-side.
- */
-void
-music_info_service_player_set_duration (MusicInfoServicePlayer *object, gdouble value)
-{
-  g_object_set (G_OBJECT (object), "duration", value, NULL);
-}
-
-/**
- * music_info_service_player_get_position: (skip)
- * @object: A #MusicInfoServicePlayer.
- *
- * Gets the value of the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Position">"Position"</link> D-Bus property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client- and service-side.
- *
- * Returns: The property value.
- */
-gdouble 
-music_info_service_player_get_position (MusicInfoServicePlayer *object)
-{
-  g_return_val_if_fail (IS_MUSIC_INFO_SERVICE_PLAYER (object), 0.0);
-
-  return MUSIC_INFO_SERVICE_PLAYER_GET_IFACE (object)->get_position (object);
-}
-
-/**
- * music_info_service_player_set_position: (skip)
- * @object: A #MusicInfoServicePlayer.
- * @value: The value to set.
- *
- * Sets the <link linkend="gdbus-property-org-amazzy24128-MusicInfoService-Player.Position">"Position"</link> D-Bus property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the service-side.
- */
-void
-music_info_service_player_set_position (MusicInfoServicePlayer *object, gdouble value)
-{
-  g_object_set (G_OBJECT (object), "position", value, NULL);
-}
-
-/**
- * music_info_service_player_emit_state_changed:
- * @object: A #MusicInfoServicePlayer.
- * @arg_artist: Argument to pass with the signal.
- * @arg_title: Argument to pass with the signal.
- * @arg_is_playing: Argument to pass with the signal.
- * @arg_current_lyric: Argument to pass with the signal.
- * @arg_duration: Argument to pass with the signal.
- * @arg_position: Argument to pass with the signal.
- *
- * Emits the <link linkend="gdbus-signal-org-amazzy24128-MusicInfoService-Player.StateChanged">"StateChanged"</link> D-Bus signal.
- */
-void
-music_info_service_player_emit_state_changed (
-    MusicInfoServicePlayer *object,
-    const gchar *arg_artist,
-    const gchar *arg_title,
-    gboolean arg_is_playing,
-    const gchar *arg_current_lyric,
-    gdouble arg_duration,
-    gdouble arg_position)
-{
-  g_signal_emit (object, _MUSIC_INFO_SERVICE_PLAYER_SIGNALS[_MUSIC_INFO_SERVICE_PLAYER_STATE_CHANGED], 0, arg_artist, arg_title, arg_is_playing, arg_current_lyric, arg_duration, arg_position);
-}
-
-/* ------------------------------------------------------------------------ */
-
-/**
- * MusicInfoServicePlayerProxy:
- *
- * The #MusicInfoServicePlayerProxy structure contains only private data and should only be accessed using the provided API.
- */
-
-/**
- * MusicInfoServicePlayerProxyClass:
- * @parent_class: The parent class.
- *
- * Class structure for #MusicInfoServicePlayerProxy.
- */
-
-struct _MusicInfoServicePlayerProxyPrivate
-{
-  GData *qdata;
-};
-
-static void music_info_service_player_proxy_iface_init (MusicInfoServicePlayerIface *iface);
-
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-G_DEFINE_TYPE_WITH_CODE (MusicInfoServicePlayerProxy, music_info_service_player_proxy, G_TYPE_DBUS_PROXY,
-                         G_ADD_PRIVATE (MusicInfoServicePlayerProxy)
-                         G_IMPLEMENT_INTERFACE (TYPE_MUSIC_INFO_SERVICE_PLAYER, music_info_service_player_proxy_iface_init))
-
-#else
-G_DEFINE_TYPE_WITH_CODE (MusicInfoServicePlayerProxy, music_info_service_player_proxy, G_TYPE_DBUS_PROXY,
-                         G_IMPLEMENT_INTERFACE (TYPE_MUSIC_INFO_SERVICE_PLAYER, music_info_service_player_proxy_iface_init))
-
-#endif
-static void
-music_info_service_player_proxy_finalize (GObject *object)
-{
-  MusicInfoServicePlayerProxy *proxy = MUSIC_INFO_SERVICE_PLAYER_PROXY (object);
-  g_datalist_clear (&proxy->priv->qdata);
-  G_OBJECT_CLASS (music_info_service_player_proxy_parent_class)->finalize (object);
-}
-
-static void
-music_info_service_player_proxy_get_property (GObject      *object,
-  guint         prop_id,
-  GValue       *value,
-  GParamSpec   *pspec G_GNUC_UNUSED)
-{
-  const _ExtendedGDBusPropertyInfo *info;
-  GVariant *variant;
-  g_assert (prop_id != 0 && prop_id - 1 < 6);
-  info = (const _ExtendedGDBusPropertyInfo *) _music_info_service_player_property_info_pointers[prop_id - 1];
-  variant = g_dbus_proxy_get_cached_property (G_DBUS_PROXY (object), info->parent_struct.name);
-  if (info->use_gvariant)
-    {
-      g_value_set_variant (value, variant);
-    }
-  else
-    {
-      if (variant != NULL)
-        g_dbus_gvariant_to_gvalue (variant, value);
-    }
-  if (variant != NULL)
-    g_variant_unref (variant);
-}
-
-static void
-music_info_service_player_proxy_set_property_cb (GDBusProxy *proxy,
-  GAsyncResult *res,
-  gpointer      user_data)
-{
-  const _ExtendedGDBusPropertyInfo *info = user_data;
-  GError *error;
-  GVariant *_ret;
-  error = NULL;
-  _ret = g_dbus_proxy_call_finish (proxy, res, &error);
-  if (!_ret)
-    {
-      g_warning ("Error setting property '%s' on interface org.amazzy24128.MusicInfoService.Player: %s (%s, %d)",
-                 info->parent_struct.name, 
-                 error->message, g_quark_to_string (error->domain), error->code);
-      g_error_free (error);
-    }
-  else
-    {
-      g_variant_unref (_ret);
-    }
-}
-
-static void
-music_info_service_player_proxy_set_property (GObject      *object,
-  guint         prop_id,
-  const GValue *value,
-  GParamSpec   *pspec G_GNUC_UNUSED)
-{
-  const _ExtendedGDBusPropertyInfo *info;
-  GVariant *variant;
-  g_assert (prop_id != 0 && prop_id - 1 < 6);
-  info = (const _ExtendedGDBusPropertyInfo *) _music_info_service_player_property_info_pointers[prop_id - 1];
-  variant = g_dbus_gvalue_to_gvariant (value, G_VARIANT_TYPE (info->parent_struct.signature));
-  g_dbus_proxy_call (G_DBUS_PROXY (object),
-    "org.freedesktop.DBus.Properties.Set",
-    g_variant_new ("(ssv)", "org.amazzy24128.MusicInfoService.Player", info->parent_struct.name, variant),
-    G_DBUS_CALL_FLAGS_NONE,
-    -1,
-    NULL, (GAsyncReadyCallback) music_info_service_player_proxy_set_property_cb, (GDBusPropertyInfo *) &info->parent_struct);
-  g_variant_unref (variant);
-}
-
-static void
-music_info_service_player_proxy_g_signal (GDBusProxy *proxy,
-  const gchar *sender_name G_GNUC_UNUSED,
-  const gchar *signal_name,
-  GVariant *parameters)
-{
-  _ExtendedGDBusSignalInfo *info;
-  GVariantIter iter;
-  GVariant *child;
-  GValue *paramv;
-  gsize num_params;
-  gsize n;
-  guint signal_id;
-  info = (_ExtendedGDBusSignalInfo *) g_dbus_interface_info_lookup_signal ((GDBusInterfaceInfo *) &_music_info_service_player_interface_info.parent_struct, signal_name);
-  if (info == NULL)
-    return;
-  num_params = g_variant_n_children (parameters);
-  paramv = g_new0 (GValue, num_params + 1);
-  g_value_init (&paramv[0], TYPE_MUSIC_INFO_SERVICE_PLAYER);
-  g_value_set_object (&paramv[0], proxy);
-  g_variant_iter_init (&iter, parameters);
-  n = 1;
-  while ((child = g_variant_iter_next_value (&iter)) != NULL)
-    {
-      _ExtendedGDBusArgInfo *arg_info = (_ExtendedGDBusArgInfo *) info->parent_struct.args[n - 1];
-      if (arg_info->use_gvariant)
-        {
-          g_value_init (&paramv[n], G_TYPE_VARIANT);
-          g_value_set_variant (&paramv[n], child);
-          n++;
-        }
-      else
-        g_dbus_gvariant_to_gvalue (child, &paramv[n++]);
-      g_variant_unref (child);
-    }
-  signal_id = g_signal_lookup (info->signal_name, TYPE_MUSIC_INFO_SERVICE_PLAYER);
-  g_signal_emitv (paramv, signal_id, 0, NULL);
-  for (n = 0; n < num_params + 1; n++)
-    g_value_unset (&paramv[n]);
-  g_free (paramv);
-}
-
-static void
-music_info_service_player_proxy_g_properties_changed (GDBusProxy *_proxy,
-  GVariant *changed_properties,
-  const gchar *const *invalidated_properties)
-{
-  MusicInfoServicePlayerProxy *proxy = MUSIC_INFO_SERVICE_PLAYER_PROXY (_proxy);
-  guint n;
-  const gchar *key;
-  GVariantIter *iter;
-  _ExtendedGDBusPropertyInfo *info;
-  g_variant_get (changed_properties, "a{sv}", &iter);
-  while (g_variant_iter_next (iter, "{&sv}", &key, NULL))
-    {
-      info = (_ExtendedGDBusPropertyInfo *) g_dbus_interface_info_lookup_property ((GDBusInterfaceInfo *) &_music_info_service_player_interface_info.parent_struct, key);
-      g_datalist_remove_data (&proxy->priv->qdata, key);
-      if (info != NULL)
-        g_object_notify (G_OBJECT (proxy), info->hyphen_name);
-    }
-  g_variant_iter_free (iter);
-  for (n = 0; invalidated_properties[n] != NULL; n++)
-    {
-      info = (_ExtendedGDBusPropertyInfo *) g_dbus_interface_info_lookup_property ((GDBusInterfaceInfo *) &_music_info_service_player_interface_info.parent_struct, invalidated_properties[n]);
-      g_datalist_remove_data (&proxy->priv->qdata, invalidated_properties[n]);
-      if (info != NULL)
-        g_object_notify (G_OBJECT (proxy), info->hyphen_name);
-    }
-}
-
-static const gchar *
-music_info_service_player_proxy_get_artist (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerProxy *proxy = MUSIC_INFO_SERVICE_PLAYER_PROXY (object);
-  GVariant *variant;
-  const gchar *value = NULL;
-  variant = g_dbus_proxy_get_cached_property (G_DBUS_PROXY (proxy), "Artist");
-  if (variant != NULL)
-    {
-      value = g_variant_get_string (variant, NULL);
-      g_variant_unref (variant);
-    }
-  return value;
-}
-
-static const gchar *
-music_info_service_player_proxy_get_title (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerProxy *proxy = MUSIC_INFO_SERVICE_PLAYER_PROXY (object);
-  GVariant *variant;
-  const gchar *value = NULL;
-  variant = g_dbus_proxy_get_cached_property (G_DBUS_PROXY (proxy), "Title");
-  if (variant != NULL)
-    {
-      value = g_variant_get_string (variant, NULL);
-      g_variant_unref (variant);
-    }
-  return value;
-}
-
-static gboolean 
-music_info_service_player_proxy_get_is_playing (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerProxy *proxy = MUSIC_INFO_SERVICE_PLAYER_PROXY (object);
-  GVariant *variant;
-  gboolean value = FALSE;
-  variant = g_dbus_proxy_get_cached_property (G_DBUS_PROXY (proxy), "IsPlaying");
-  if (variant != NULL)
-    {
-      value = g_variant_get_boolean (variant);
-      g_variant_unref (variant);
-    }
-  return value;
-}
-
-static const gchar *
-music_info_service_player_proxy_get_current_lyric (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerProxy *proxy = MUSIC_INFO_SERVICE_PLAYER_PROXY (object);
-  GVariant *variant;
-  const gchar *value = NULL;
-  variant = g_dbus_proxy_get_cached_property (G_DBUS_PROXY (proxy), "CurrentLyric");
-  if (variant != NULL)
-    {
-      value = g_variant_get_string (variant, NULL);
-      g_variant_unref (variant);
-    }
-  return value;
-}
-
-static gdouble 
-music_info_service_player_proxy_get_duration (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerProxy *proxy = MUSIC_INFO_SERVICE_PLAYER_PROXY (object);
-  GVariant *variant;
-  gdouble value = 0.0;
-  variant = g_dbus_proxy_get_cached_property (G_DBUS_PROXY (proxy), "Duration");
-  if (variant != NULL)
-    {
-      value = g_variant_get_double (variant);
-      g_variant_unref (variant);
-    }
-  return value;
-}
-
-static gdouble 
-music_info_service_player_proxy_get_position (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerProxy *proxy = MUSIC_INFO_SERVICE_PLAYER_PROXY (object);
-  GVariant *variant;
-  gdouble value = 0.0;
-  variant = g_dbus_proxy_get_cached_property (G_DBUS_PROXY (proxy), "Position");
-  if (variant != NULL)
-    {
-      value = g_variant_get_double (variant);
-      g_variant_unref (variant);
-    }
-  return value;
-}
-
-static void
-music_info_service_player_proxy_init (MusicInfoServicePlayerProxy *proxy)
-{
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-  proxy->priv = music_info_service_player_proxy_get_instance_private (proxy);
-#else
-  proxy->priv = G_TYPE_INSTANCE_GET_PRIVATE (proxy, TYPE_MUSIC_INFO_SERVICE_PLAYER_PROXY, MusicInfoServicePlayerProxyPrivate);
-#endif
-
-  g_dbus_proxy_set_interface_info (G_DBUS_PROXY (proxy), music_info_service_player_interface_info ());
-}
-
-static void
-music_info_service_player_proxy_class_init (MusicInfoServicePlayerProxyClass *klass)
-{
-  GObjectClass *gobject_class;
-  GDBusProxyClass *proxy_class;
-
-  gobject_class = G_OBJECT_CLASS (klass);
-  gobject_class->finalize     = music_info_service_player_proxy_finalize;
-  gobject_class->get_property = music_info_service_player_proxy_get_property;
-  gobject_class->set_property = music_info_service_player_proxy_set_property;
-
-  proxy_class = G_DBUS_PROXY_CLASS (klass);
-  proxy_class->g_signal = music_info_service_player_proxy_g_signal;
-  proxy_class->g_properties_changed = music_info_service_player_proxy_g_properties_changed;
-
-  music_info_service_player_override_properties (gobject_class, 1);
-
-#if GLIB_VERSION_MAX_ALLOWED < GLIB_VERSION_2_38
-  g_type_class_add_private (klass, sizeof (MusicInfoServicePlayerProxyPrivate));
-#endif
-}
-
-static void
-music_info_service_player_proxy_iface_init (MusicInfoServicePlayerIface *iface)
-{
-  iface->get_artist = music_info_service_player_proxy_get_artist;
-  iface->get_title = music_info_service_player_proxy_get_title;
-  iface->get_is_playing = music_info_service_player_proxy_get_is_playing;
-  iface->get_current_lyric = music_info_service_player_proxy_get_current_lyric;
-  iface->get_duration = music_info_service_player_proxy_get_duration;
-  iface->get_position = music_info_service_player_proxy_get_position;
-}
-
-/**
- * music_info_service_player_proxy_new:
- * @connection: A #GDBusConnection.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: (nullable): A bus name (well-known or unique) or %NULL if @connection is not a message bus connection.
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @callback: A #GAsyncReadyCallback to call when the request is satisfied.
- * @user_data: User data to pass to @callback.
- *
- * Asynchronously creates a proxy for the D-Bus interface <link linkend="gdbus-interface-org-amazzy24128-MusicInfoService-Player.top_of_page">org.amazzy24128.MusicInfoService.Player</link>. See g_dbus_proxy_new() for more details.
- *
- * When the operation is finished, @callback will be invoked in the thread-default main loop of the thread you are calling this method from (see g_main_context_push_thread_default()).
- * You can then call music_info_service_player_proxy_new_finish() to get the result of the operation.
- *
- * See music_info_service_player_proxy_new_sync() for the synchronous, blocking version of this constructor.
- */
-void
-music_info_service_player_proxy_new (
-    GDBusConnection     *connection,
-    GDBusProxyFlags      flags,
-    const gchar         *name,
-    const gchar         *object_path,
-    GCancellable        *cancellable,
-    GAsyncReadyCallback  callback,
-    gpointer             user_data)
-{
-  g_async_initable_new_async (TYPE_MUSIC_INFO_SERVICE_PLAYER_PROXY, G_PRIORITY_DEFAULT, cancellable, callback, user_data, "g-flags", flags, "g-name", name, "g-connection", connection, "g-object-path", object_path, "g-interface-name", "org.amazzy24128.MusicInfoService.Player", NULL);
-}
-
-/**
- * music_info_service_player_proxy_new_finish:
- * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to music_info_service_player_proxy_new().
- * @error: Return location for error or %NULL
- *
- * Finishes an operation started with music_info_service_player_proxy_new().
- *
- * Returns: (transfer full) (type MusicInfoServicePlayerProxy): The constructed proxy object or %NULL if @error is set.
- */
-MusicInfoServicePlayer *
-music_info_service_player_proxy_new_finish (
-    GAsyncResult        *res,
-    GError             **error)
-{
-  GObject *ret;
-  GObject *source_object;
-  source_object = g_async_result_get_source_object (res);
-  ret = g_async_initable_new_finish (G_ASYNC_INITABLE (source_object), res, error);
-  g_object_unref (source_object);
-  if (ret != NULL)
-    return MUSIC_INFO_SERVICE_PLAYER (ret);
-  else
-    return NULL;
-}
-
-/**
- * music_info_service_player_proxy_new_sync:
- * @connection: A #GDBusConnection.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: (nullable): A bus name (well-known or unique) or %NULL if @connection is not a message bus connection.
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @error: Return location for error or %NULL
- *
- * Synchronously creates a proxy for the D-Bus interface <link linkend="gdbus-interface-org-amazzy24128-MusicInfoService-Player.top_of_page">org.amazzy24128.MusicInfoService.Player</link>. See g_dbus_proxy_new_sync() for more details.
- *
- * The calling thread is blocked until a reply is received.
- *
- * See music_info_service_player_proxy_new() for the asynchronous version of this constructor.
- *
- * Returns: (transfer full) (type MusicInfoServicePlayerProxy): The constructed proxy object or %NULL if @error is set.
- */
-MusicInfoServicePlayer *
-music_info_service_player_proxy_new_sync (
-    GDBusConnection     *connection,
-    GDBusProxyFlags      flags,
-    const gchar         *name,
-    const gchar         *object_path,
-    GCancellable        *cancellable,
-    GError             **error)
-{
-  GInitable *ret;
-  ret = g_initable_new (TYPE_MUSIC_INFO_SERVICE_PLAYER_PROXY, cancellable, error, "g-flags", flags, "g-name", name, "g-connection", connection, "g-object-path", object_path, "g-interface-name", "org.amazzy24128.MusicInfoService.Player", NULL);
-  if (ret != NULL)
-    return MUSIC_INFO_SERVICE_PLAYER (ret);
-  else
-    return NULL;
-}
-
-
-/**
- * music_info_service_player_proxy_new_for_bus:
- * @bus_type: A #GBusType.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: A bus name (well-known or unique).
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @callback: A #GAsyncReadyCallback to call when the request is satisfied.
- * @user_data: User data to pass to @callback.
- *
- * Like music_info_service_player_proxy_new() but takes a #GBusType instead of a #GDBusConnection.
- *
- * When the operation is finished, @callback will be invoked in the thread-default main loop of the thread you are calling this method from (see g_main_context_push_thread_default()).
- * You can then call music_info_service_player_proxy_new_for_bus_finish() to get the result of the operation.
- *
- * See music_info_service_player_proxy_new_for_bus_sync() for the synchronous, blocking version of this constructor.
- */
-void
-music_info_service_player_proxy_new_for_bus (
-    GBusType             bus_type,
-    GDBusProxyFlags      flags,
-    const gchar         *name,
-    const gchar         *object_path,
-    GCancellable        *cancellable,
-    GAsyncReadyCallback  callback,
-    gpointer             user_data)
-{
-  g_async_initable_new_async (TYPE_MUSIC_INFO_SERVICE_PLAYER_PROXY, G_PRIORITY_DEFAULT, cancellable, callback, user_data, "g-flags", flags, "g-name", name, "g-bus-type", bus_type, "g-object-path", object_path, "g-interface-name", "org.amazzy24128.MusicInfoService.Player", NULL);
-}
-
-/**
- * music_info_service_player_proxy_new_for_bus_finish:
- * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to music_info_service_player_proxy_new_for_bus().
- * @error: Return location for error or %NULL
- *
- * Finishes an operation started with music_info_service_player_proxy_new_for_bus().
- *
- * Returns: (transfer full) (type MusicInfoServicePlayerProxy): The constructed proxy object or %NULL if @error is set.
- */
-MusicInfoServicePlayer *
-music_info_service_player_proxy_new_for_bus_finish (
-    GAsyncResult        *res,
-    GError             **error)
-{
-  GObject *ret;
-  GObject *source_object;
-  source_object = g_async_result_get_source_object (res);
-  ret = g_async_initable_new_finish (G_ASYNC_INITABLE (source_object), res, error);
-  g_object_unref (source_object);
-  if (ret != NULL)
-    return MUSIC_INFO_SERVICE_PLAYER (ret);
-  else
-    return NULL;
-}
-
-/**
- * music_info_service_player_proxy_new_for_bus_sync:
- * @bus_type: A #GBusType.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: A bus name (well-known or unique).
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @error: Return location for error or %NULL
- *
- * Like music_info_service_player_proxy_new_sync() but takes a #GBusType instead of a #GDBusConnection.
- *
- * The calling thread is blocked until a reply is received.
- *
- * See music_info_service_player_proxy_new_for_bus() for the asynchronous version of this constructor.
- *
- * Returns: (transfer full) (type MusicInfoServicePlayerProxy): The constructed proxy object or %NULL if @error is set.
- */
-MusicInfoServicePlayer *
-music_info_service_player_proxy_new_for_bus_sync (
-    GBusType             bus_type,
-    GDBusProxyFlags      flags,
-    const gchar         *name,
-    const gchar         *object_path,
-    GCancellable        *cancellable,
-    GError             **error)
-{
-  GInitable *ret;
-  ret = g_initable_new (TYPE_MUSIC_INFO_SERVICE_PLAYER_PROXY, cancellable, error, "g-flags", flags, "g-name", name, "g-bus-type", bus_type, "g-object-path", object_path, "g-interface-name", "org.amazzy24128.MusicInfoService.Player", NULL);
-  if (ret != NULL)
-    return MUSIC_INFO_SERVICE_PLAYER (ret);
-  else
-    return NULL;
-}
-
-
-/* ------------------------------------------------------------------------ */
-
-/**
- * MusicInfoServicePlayerSkeleton:
- *
- * The #MusicInfoServicePlayerSkeleton structure contains only private data and should only be accessed using the provided API.
- */
-
-/**
- * MusicInfoServicePlayerSkeletonClass:
- * @parent_class: The parent class.
- *
- * Class structure for #MusicInfoServicePlayerSkeleton.
- */
-
-struct _MusicInfoServicePlayerSkeletonPrivate
-{
-  GValue *properties;
-  GList *changed_properties;
-  GSource *changed_properties_idle_source;
-  GMainContext *context;
-  GMutex lock;
-};
-
-static void
-_music_info_service_player_skeleton_handle_method_call (
-  GDBusConnection *connection G_GNUC_UNUSED,
-  const gchar *sender G_GNUC_UNUSED,
-  const gchar *object_path G_GNUC_UNUSED,
-  const gchar *interface_name,
-  const gchar *method_name,
-  GVariant *parameters,
-  GDBusMethodInvocation *invocation,
-  gpointer user_data)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (user_data);
-  _ExtendedGDBusMethodInfo *info;
-  GVariantIter iter;
-  GVariant *child;
-  GValue *paramv;
-  gsize num_params;
-  guint num_extra;
-  gsize n;
-  guint signal_id;
-  GValue return_value = G_VALUE_INIT;
-  info = (_ExtendedGDBusMethodInfo *) g_dbus_method_invocation_get_method_info (invocation);
-  g_assert (info != NULL);
-  num_params = g_variant_n_children (parameters);
-  num_extra = info->pass_fdlist ? 3 : 2;  paramv = g_new0 (GValue, num_params + num_extra);
-  n = 0;
-  g_value_init (&paramv[n], TYPE_MUSIC_INFO_SERVICE_PLAYER);
-  g_value_set_object (&paramv[n++], skeleton);
-  g_value_init (&paramv[n], G_TYPE_DBUS_METHOD_INVOCATION);
-  g_value_set_object (&paramv[n++], invocation);
-  if (info->pass_fdlist)
-    {
-#ifdef G_OS_UNIX
-      g_value_init (&paramv[n], G_TYPE_UNIX_FD_LIST);
-      g_value_set_object (&paramv[n++], g_dbus_message_get_unix_fd_list (g_dbus_method_invocation_get_message (invocation)));
-#else
-      g_assert_not_reached ();
-#endif
-    }
-  g_variant_iter_init (&iter, parameters);
-  while ((child = g_variant_iter_next_value (&iter)) != NULL)
-    {
-      _ExtendedGDBusArgInfo *arg_info = (_ExtendedGDBusArgInfo *) info->parent_struct.in_args[n - num_extra];
-      if (arg_info->use_gvariant)
-        {
-          g_value_init (&paramv[n], G_TYPE_VARIANT);
-          g_value_set_variant (&paramv[n], child);
-          n++;
-        }
-      else
-        g_dbus_gvariant_to_gvalue (child, &paramv[n++]);
-      g_variant_unref (child);
-    }
-  signal_id = g_signal_lookup (info->signal_name, TYPE_MUSIC_INFO_SERVICE_PLAYER);
-  g_value_init (&return_value, G_TYPE_BOOLEAN);
-  g_signal_emitv (paramv, signal_id, 0, &return_value);
-  if (!g_value_get_boolean (&return_value))
-    g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD, "Method %s is not implemented on interface %s", method_name, interface_name);
-  g_value_unset (&return_value);
-  for (n = 0; n < num_params + num_extra; n++)
-    g_value_unset (&paramv[n]);
-  g_free (paramv);
-}
-
-static GVariant *
-_music_info_service_player_skeleton_handle_get_property (
-  GDBusConnection *connection G_GNUC_UNUSED,
-  const gchar *sender G_GNUC_UNUSED,
-  const gchar *object_path G_GNUC_UNUSED,
-  const gchar *interface_name G_GNUC_UNUSED,
-  const gchar *property_name,
-  GError **error,
-  gpointer user_data)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (user_data);
-  GValue value = G_VALUE_INIT;
-  GParamSpec *pspec;
-  _ExtendedGDBusPropertyInfo *info;
-  GVariant *ret;
-  ret = NULL;
-  info = (_ExtendedGDBusPropertyInfo *) g_dbus_interface_info_lookup_property ((GDBusInterfaceInfo *) &_music_info_service_player_interface_info.parent_struct, property_name);
-  g_assert (info != NULL);
-  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (skeleton), info->hyphen_name);
-  if (pspec == NULL)
-    {
-      g_set_error (error, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "No property with name %s", property_name);
-    }
-  else
-    {
-      g_value_init (&value, pspec->value_type);
-      g_object_get_property (G_OBJECT (skeleton), info->hyphen_name, &value);
-      ret = g_dbus_gvalue_to_gvariant (&value, G_VARIANT_TYPE (info->parent_struct.signature));
-      g_value_unset (&value);
-    }
-  return ret;
-}
-
-static gboolean
-_music_info_service_player_skeleton_handle_set_property (
-  GDBusConnection *connection G_GNUC_UNUSED,
-  const gchar *sender G_GNUC_UNUSED,
-  const gchar *object_path G_GNUC_UNUSED,
-  const gchar *interface_name G_GNUC_UNUSED,
-  const gchar *property_name,
-  GVariant *variant,
-  GError **error,
-  gpointer user_data)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (user_data);
-  GValue value = G_VALUE_INIT;
-  GParamSpec *pspec;
-  _ExtendedGDBusPropertyInfo *info;
-  gboolean ret;
-  ret = FALSE;
-  info = (_ExtendedGDBusPropertyInfo *) g_dbus_interface_info_lookup_property ((GDBusInterfaceInfo *) &_music_info_service_player_interface_info.parent_struct, property_name);
-  g_assert (info != NULL);
-  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (skeleton), info->hyphen_name);
-  if (pspec == NULL)
-    {
-      g_set_error (error, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "No property with name %s", property_name);
-    }
-  else
-    {
-      if (info->use_gvariant)
-        g_value_set_variant (&value, variant);
-      else
-        g_dbus_gvariant_to_gvalue (variant, &value);
-      g_object_set_property (G_OBJECT (skeleton), info->hyphen_name, &value);
-      g_value_unset (&value);
-      ret = TRUE;
-    }
-  return ret;
-}
-
-static const GDBusInterfaceVTable _music_info_service_player_skeleton_vtable =
-{
-  _music_info_service_player_skeleton_handle_method_call,
-  _music_info_service_player_skeleton_handle_get_property,
-  _music_info_service_player_skeleton_handle_set_property,
-  {NULL}
-};
-
-static GDBusInterfaceInfo *
-music_info_service_player_skeleton_dbus_interface_get_info (GDBusInterfaceSkeleton *skeleton G_GNUC_UNUSED)
-{
-  return music_info_service_player_interface_info ();
-}
-
-static GDBusInterfaceVTable *
-music_info_service_player_skeleton_dbus_interface_get_vtable (GDBusInterfaceSkeleton *skeleton G_GNUC_UNUSED)
-{
-  return (GDBusInterfaceVTable *) &_music_info_service_player_skeleton_vtable;
-}
-
-static GVariant *
-music_info_service_player_skeleton_dbus_interface_get_properties (GDBusInterfaceSkeleton *_skeleton)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (_skeleton);
-
-  GVariantBuilder builder;
-  guint n;
-  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
-  if (_music_info_service_player_interface_info.parent_struct.properties == NULL)
-    goto out;
-  for (n = 0; _music_info_service_player_interface_info.parent_struct.properties[n] != NULL; n++)
-    {
-      GDBusPropertyInfo *info = _music_info_service_player_interface_info.parent_struct.properties[n];
-      if (info->flags & G_DBUS_PROPERTY_INFO_FLAGS_READABLE)
-        {
-          GVariant *value;
-          value = _music_info_service_player_skeleton_handle_get_property (g_dbus_interface_skeleton_get_connection (G_DBUS_INTERFACE_SKELETON (skeleton)), NULL, g_dbus_interface_skeleton_get_object_path (G_DBUS_INTERFACE_SKELETON (skeleton)), "org.amazzy24128.MusicInfoService.Player", info->name, NULL, skeleton);
-          if (value != NULL)
-            {
-              g_variant_take_ref (value);
-              g_variant_builder_add (&builder, "{sv}", info->name, value);
-              g_variant_unref (value);
-            }
-        }
-    }
-out:
-  return g_variant_builder_end (&builder);
-}
-
-static gboolean _music_info_service_player_emit_changed (gpointer user_data);
-
-static void
-music_info_service_player_skeleton_dbus_interface_flush (GDBusInterfaceSkeleton *_skeleton)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (_skeleton);
-  gboolean emit_changed = FALSE;
-
-  g_mutex_lock (&skeleton->priv->lock);
-  if (skeleton->priv->changed_properties_idle_source != NULL)
-    {
-      g_source_destroy (skeleton->priv->changed_properties_idle_source);
-      skeleton->priv->changed_properties_idle_source = NULL;
-      emit_changed = TRUE;
-    }
-  g_mutex_unlock (&skeleton->priv->lock);
-
-  if (emit_changed)
-    _music_info_service_player_emit_changed (skeleton);
-}
-
-static void
-_music_info_service_player_on_signal_state_changed (
-    MusicInfoServicePlayer *object,
-    const gchar *arg_artist,
-    const gchar *arg_title,
-    gboolean arg_is_playing,
-    const gchar *arg_current_lyric,
-    gdouble arg_duration,
-    gdouble arg_position)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (object);
-
-  GList      *connections, *l;
-  GVariant   *signal_variant;
-  connections = g_dbus_interface_skeleton_get_connections (G_DBUS_INTERFACE_SKELETON (skeleton));
-
-  signal_variant = g_variant_ref_sink (g_variant_new ("(ssbsdd)",
-                   arg_artist,
-                   arg_title,
-                   arg_is_playing,
-                   arg_current_lyric,
-                   arg_duration,
-                   arg_position));
-  for (l = connections; l != NULL; l = l->next)
-    {
-      GDBusConnection *connection = l->data;
-      g_dbus_connection_emit_signal (connection,
-        NULL, g_dbus_interface_skeleton_get_object_path (G_DBUS_INTERFACE_SKELETON (skeleton)), "org.amazzy24128.MusicInfoService.Player", "StateChanged",
-        signal_variant, NULL);
-    }
-  g_variant_unref (signal_variant);
-  g_list_free_full (connections, g_object_unref);
-}
-
-static void music_info_service_player_skeleton_iface_init (MusicInfoServicePlayerIface *iface);
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-G_DEFINE_TYPE_WITH_CODE (MusicInfoServicePlayerSkeleton, music_info_service_player_skeleton, G_TYPE_DBUS_INTERFACE_SKELETON,
-                         G_ADD_PRIVATE (MusicInfoServicePlayerSkeleton)
-                         G_IMPLEMENT_INTERFACE (TYPE_MUSIC_INFO_SERVICE_PLAYER, music_info_service_player_skeleton_iface_init))
-
-#else
-G_DEFINE_TYPE_WITH_CODE (MusicInfoServicePlayerSkeleton, music_info_service_player_skeleton, G_TYPE_DBUS_INTERFACE_SKELETON,
-                         G_IMPLEMENT_INTERFACE (TYPE_MUSIC_INFO_SERVICE_PLAYER, music_info_service_player_skeleton_iface_init))
-
-#endif
-static void
-music_info_service_player_skeleton_finalize (GObject *object)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (object);
-  guint n;
-  for (n = 0; n < 6; n++)
-    g_value_unset (&skeleton->priv->properties[n]);
-  g_free (skeleton->priv->properties);
-  g_list_free_full (skeleton->priv->changed_properties, (GDestroyNotify) _changed_property_free);
-  if (skeleton->priv->changed_properties_idle_source != NULL)
-    g_source_destroy (skeleton->priv->changed_properties_idle_source);
-  g_main_context_unref (skeleton->priv->context);
-  g_mutex_clear (&skeleton->priv->lock);
-  G_OBJECT_CLASS (music_info_service_player_skeleton_parent_class)->finalize (object);
-}
-
-static void
-music_info_service_player_skeleton_get_property (GObject      *object,
-  guint         prop_id,
-  GValue       *value,
-  GParamSpec   *pspec G_GNUC_UNUSED)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (object);
-  g_assert (prop_id != 0 && prop_id - 1 < 6);
-  g_mutex_lock (&skeleton->priv->lock);
-  g_value_copy (&skeleton->priv->properties[prop_id - 1], value);
-  g_mutex_unlock (&skeleton->priv->lock);
-}
-
-static gboolean
-_music_info_service_player_emit_changed (gpointer user_data)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (user_data);
-  GList *l;
-  GVariantBuilder builder;
-  GVariantBuilder invalidated_builder;
-  guint num_changes;
-
-  g_mutex_lock (&skeleton->priv->lock);
-  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
-  g_variant_builder_init (&invalidated_builder, G_VARIANT_TYPE ("as"));
-  for (l = skeleton->priv->changed_properties, num_changes = 0; l != NULL; l = l->next)
-    {
-      ChangedProperty *cp = l->data;
-      GVariant *variant;
-      const GValue *cur_value;
-
-      cur_value = &skeleton->priv->properties[cp->prop_id - 1];
-      if (!_g_value_equal (cur_value, &cp->orig_value))
-        {
-          variant = g_dbus_gvalue_to_gvariant (cur_value, G_VARIANT_TYPE (cp->info->parent_struct.signature));
-          g_variant_builder_add (&builder, "{sv}", cp->info->parent_struct.name, variant);
-          g_variant_unref (variant);
-          num_changes++;
-        }
-    }
-  if (num_changes > 0)
-    {
-      GList *connections, *ll;
-      GVariant *signal_variant;
-      signal_variant = g_variant_ref_sink (g_variant_new ("(sa{sv}as)", "org.amazzy24128.MusicInfoService.Player",
-                                           &builder, &invalidated_builder));
-      connections = g_dbus_interface_skeleton_get_connections (G_DBUS_INTERFACE_SKELETON (skeleton));
-      for (ll = connections; ll != NULL; ll = ll->next)
-        {
-          GDBusConnection *connection = ll->data;
-
-          g_dbus_connection_emit_signal (connection,
-                                         NULL, g_dbus_interface_skeleton_get_object_path (G_DBUS_INTERFACE_SKELETON (skeleton)),
-                                         "org.freedesktop.DBus.Properties",
-                                         "PropertiesChanged",
-                                         signal_variant,
-                                         NULL);
-        }
-      g_variant_unref (signal_variant);
-      g_list_free_full (connections, g_object_unref);
-    }
-  else
-    {
-      g_variant_builder_clear (&builder);
-      g_variant_builder_clear (&invalidated_builder);
-    }
-  g_list_free_full (skeleton->priv->changed_properties, (GDestroyNotify) _changed_property_free);
-  skeleton->priv->changed_properties = NULL;
-  skeleton->priv->changed_properties_idle_source = NULL;
-  g_mutex_unlock (&skeleton->priv->lock);
-  return FALSE;
-}
-
-static void
-_music_info_service_player_schedule_emit_changed (MusicInfoServicePlayerSkeleton *skeleton, const _ExtendedGDBusPropertyInfo *info, guint prop_id, const GValue *orig_value)
-{
-  ChangedProperty *cp;
-  GList *l;
-  cp = NULL;
-  for (l = skeleton->priv->changed_properties; l != NULL; l = l->next)
-    {
-      ChangedProperty *i_cp = l->data;
-      if (i_cp->info == info)
-        {
-          cp = i_cp;
-          break;
-        }
-    }
-  if (cp == NULL)
-    {
-      cp = g_new0 (ChangedProperty, 1);
-      cp->prop_id = prop_id;
-      cp->info = info;
-      skeleton->priv->changed_properties = g_list_prepend (skeleton->priv->changed_properties, cp);
-      g_value_init (&cp->orig_value, G_VALUE_TYPE (orig_value));
-      g_value_copy (orig_value, &cp->orig_value);
-    }
-}
-
-static void
-music_info_service_player_skeleton_notify (GObject      *object,
-  GParamSpec *pspec G_GNUC_UNUSED)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (object);
-  g_mutex_lock (&skeleton->priv->lock);
-  if (skeleton->priv->changed_properties != NULL &&
-      skeleton->priv->changed_properties_idle_source == NULL)
-    {
-      skeleton->priv->changed_properties_idle_source = g_idle_source_new ();
-      g_source_set_priority (skeleton->priv->changed_properties_idle_source, G_PRIORITY_DEFAULT);
-      g_source_set_callback (skeleton->priv->changed_properties_idle_source, _music_info_service_player_emit_changed, g_object_ref (skeleton), (GDestroyNotify) g_object_unref);
-      g_source_set_name (skeleton->priv->changed_properties_idle_source, "[generated] _music_info_service_player_emit_changed");
-      g_source_attach (skeleton->priv->changed_properties_idle_source, skeleton->priv->context);
-      g_source_unref (skeleton->priv->changed_properties_idle_source);
-    }
-  g_mutex_unlock (&skeleton->priv->lock);
-}
-
-static void
-music_info_service_player_skeleton_set_property (GObject      *object,
-  guint         prop_id,
-  const GValue *value,
-  GParamSpec   *pspec)
-{
-  const _ExtendedGDBusPropertyInfo *info;
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (object);
-  g_assert (prop_id != 0 && prop_id - 1 < 6);
-  info = (const _ExtendedGDBusPropertyInfo *) _music_info_service_player_property_info_pointers[prop_id - 1];
-  g_mutex_lock (&skeleton->priv->lock);
-  g_object_freeze_notify (object);
-  if (!_g_value_equal (value, &skeleton->priv->properties[prop_id - 1]))
-    {
-      if (g_dbus_interface_skeleton_get_connection (G_DBUS_INTERFACE_SKELETON (skeleton)) != NULL &&
-          info->emits_changed_signal)
-        _music_info_service_player_schedule_emit_changed (skeleton, info, prop_id, &skeleton->priv->properties[prop_id - 1]);
-      g_value_copy (value, &skeleton->priv->properties[prop_id - 1]);
-      g_object_notify_by_pspec (object, pspec);
-    }
-  g_mutex_unlock (&skeleton->priv->lock);
-  g_object_thaw_notify (object);
-}
-
-static void
-music_info_service_player_skeleton_init (MusicInfoServicePlayerSkeleton *skeleton)
-{
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-  skeleton->priv = music_info_service_player_skeleton_get_instance_private (skeleton);
-#else
-  skeleton->priv = G_TYPE_INSTANCE_GET_PRIVATE (skeleton, TYPE_MUSIC_INFO_SERVICE_PLAYER_SKELETON, MusicInfoServicePlayerSkeletonPrivate);
-#endif
-
-  g_mutex_init (&skeleton->priv->lock);
-  skeleton->priv->context = g_main_context_ref_thread_default ();
-  skeleton->priv->properties = g_new0 (GValue, 6);
-  g_value_init (&skeleton->priv->properties[0], G_TYPE_STRING);
-  g_value_init (&skeleton->priv->properties[1], G_TYPE_STRING);
-  g_value_init (&skeleton->priv->properties[2], G_TYPE_BOOLEAN);
-  g_value_init (&skeleton->priv->properties[3], G_TYPE_STRING);
-  g_value_init (&skeleton->priv->properties[4], G_TYPE_DOUBLE);
-  g_value_init (&skeleton->priv->properties[5], G_TYPE_DOUBLE);
-}
-
-static const gchar *
-music_info_service_player_skeleton_get_artist (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (object);
-  const gchar *value;
-  g_mutex_lock (&skeleton->priv->lock);
-  value = g_marshal_value_peek_string (&(skeleton->priv->properties[0]));
-  g_mutex_unlock (&skeleton->priv->lock);
-  return value;
-}
-
-static const gchar *
-music_info_service_player_skeleton_get_title (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (object);
-  const gchar *value;
-  g_mutex_lock (&skeleton->priv->lock);
-  value = g_marshal_value_peek_string (&(skeleton->priv->properties[1]));
-  g_mutex_unlock (&skeleton->priv->lock);
-  return value;
-}
-
-static gboolean 
-music_info_service_player_skeleton_get_is_playing (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (object);
-  gboolean value;
-  g_mutex_lock (&skeleton->priv->lock);
-  value = g_marshal_value_peek_boolean (&(skeleton->priv->properties[2]));
-  g_mutex_unlock (&skeleton->priv->lock);
-  return value;
-}
-
-static const gchar *
-music_info_service_player_skeleton_get_current_lyric (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (object);
-  const gchar *value;
-  g_mutex_lock (&skeleton->priv->lock);
-  value = g_marshal_value_peek_string (&(skeleton->priv->properties[3]));
-  g_mutex_unlock (&skeleton->priv->lock);
-  return value;
-}
-
-static gdouble 
-music_info_service_player_skeleton_get_duration (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (object);
-  gdouble value;
-  g_mutex_lock (&skeleton->priv->lock);
-  value = g_marshal_value_peek_double (&(skeleton->priv->properties[4]));
-  g_mutex_unlock (&skeleton->priv->lock);
-  return value;
-}
-
-static gdouble 
-music_info_service_player_skeleton_get_position (MusicInfoServicePlayer *object)
-{
-  MusicInfoServicePlayerSkeleton *skeleton = MUSIC_INFO_SERVICE_PLAYER_SKELETON (object);
-  gdouble value;
-  g_mutex_lock (&skeleton->priv->lock);
-  value = g_marshal_value_peek_double (&(skeleton->priv->properties[5]));
-  g_mutex_unlock (&skeleton->priv->lock);
-  return value;
-}
-
-static void
-music_info_service_player_skeleton_class_init (MusicInfoServicePlayerSkeletonClass *klass)
-{
-  GObjectClass *gobject_class;
-  GDBusInterfaceSkeletonClass *skeleton_class;
-
-  gobject_class = G_OBJECT_CLASS (klass);
-  gobject_class->finalize = music_info_service_player_skeleton_finalize;
-  gobject_class->get_property = music_info_service_player_skeleton_get_property;
-  gobject_class->set_property = music_info_service_player_skeleton_set_property;
-  gobject_class->notify       = music_info_service_player_skeleton_notify;
-
-
-  music_info_service_player_override_properties (gobject_class, 1);
-
-  skeleton_class = G_DBUS_INTERFACE_SKELETON_CLASS (klass);
-  skeleton_class->get_info = music_info_service_player_skeleton_dbus_interface_get_info;
-  skeleton_class->get_properties = music_info_service_player_skeleton_dbus_interface_get_properties;
-  skeleton_class->flush = music_info_service_player_skeleton_dbus_interface_flush;
-  skeleton_class->get_vtable = music_info_service_player_skeleton_dbus_interface_get_vtable;
-
-#if GLIB_VERSION_MAX_ALLOWED < GLIB_VERSION_2_38
-  g_type_class_add_private (klass, sizeof (MusicInfoServicePlayerSkeletonPrivate));
-#endif
-}
-
-static void
-music_info_service_player_skeleton_iface_init (MusicInfoServicePlayerIface *iface)
-{
-  iface->state_changed = _music_info_service_player_on_signal_state_changed;
-  iface->get_artist = music_info_service_player_skeleton_get_artist;
-  iface->get_title = music_info_service_player_skeleton_get_title;
-  iface->get_is_playing = music_info_service_player_skeleton_get_is_playing;
-  iface->get_current_lyric = music_info_service_player_skeleton_get_current_lyric;
-  iface->get_duration = music_info_service_player_skeleton_get_duration;
-  iface->get_position = music_info_service_player_skeleton_get_position;
-}
-
-/**
- * music_info_service_player_skeleton_new:
- *
- * Creates a skeleton object for the D-Bus interface <link linkend="gdbus-interface-org-amazzy24128-MusicInfoService-Player.top_of_page">org.amazzy24128.MusicInfoService.Player</link>.
- *
- * Returns: (transfer full) (type MusicInfoServicePlayerSkeleton): The skeleton object.
- */
-MusicInfoServicePlayer *
-music_info_service_player_skeleton_new (void)
-{
-  return MUSIC_INFO_SERVICE_PLAYER (g_object_new (TYPE_MUSIC_INFO_SERVICE_PLAYER_SKELETON, NULL));
-}
-
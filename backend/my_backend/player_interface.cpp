@@ -0,0 +1,144 @@
+#include "player_interface.h"
+
+// 由 CMake 从 music_info_service.xml 生成，定义 kMusicInfoServiceXml
+#include "music_info_service_xml.h"
+
+static const char *kInterfaceName = "org.amazzy24128.MusicInfoService.Player";
+
+// 接口定义第一次注册时解析，之后所有连接共用，进程结束前不释放
+static GDBusNodeInfo *g_introspection = nullptr;
+
+struct PlayerInterface {
+    GDBusConnection *connection;
+    std::string object_path;
+    guint registration_id;
+    PlayerState state;
+    player_method_handler_t method_handler;
+    gpointer method_user_data;
+};
+
+static GVariant *clock_anchor_value(const PlayerState &state) {
+    GVariant *fields[4] = { g_variant_new_int64(state.anchor_monotonic_us), g_variant_new_int64(state.anchor_position_us), g_variant_new_double(state.rate), g_variant_new_boolean(state.is_playing) };
+    return g_variant_new_tuple(fields, 4);
+}
+
+// 位置不再随信号推送，读属性时按锚点现算
+static double live_position(const PlayerState &state) {
+    if (!state.is_playing) return state.position;
+    double position_us = static_cast<double>(state.anchor_position_us) + static_cast<double>(g_get_monotonic_time() - state.anchor_monotonic_us) * state.rate;
+    double position = position_us < 0 ? 0.0 : position_us / 1000000.0;
+    return (state.duration > 0 && position > state.duration) ? state.duration : position;
+}
+
+static GVariant *property_value(const PlayerState &state, const gchar *property_name) {
+    if (g_strcmp0(property_name, "Artist") == 0) return g_variant_new_string(state.artist.c_str());
+    if (g_strcmp0(property_name, "Title") == 0) return g_variant_new_string(state.title.c_str());
+    if (g_strcmp0(property_name, "IsPlaying") == 0) return g_variant_new_boolean(state.is_playing);
+    if (g_strcmp0(property_name, "CurrentLyric") == 0) return g_variant_new_string(state.current_lyric.c_str());
+    if (g_strcmp0(property_name, "CurrentSegment") == 0) return g_variant_new_string(state.current_segment.c_str());
+    if (g_strcmp0(property_name, "Duration") == 0) return g_variant_new_double(state.duration);
+    if (g_strcmp0(property_name, "Position") == 0) return g_variant_new_double(live_position(state));
+    if (g_strcmp0(property_name, "CurrentRomanization") == 0) return g_variant_new_string(state.current_romanization.c_str());
+    if (g_strcmp0(property_name, "LineStartUs") == 0) return g_variant_new_int64(state.line_start_us);
+    if (g_strcmp0(property_name, "LineEndUs") == 0) return g_variant_new_int64(state.line_end_us);
+    if (g_strcmp0(property_name, "NextLyric") == 0) return g_variant_new_string(state.next_lyric.c_str());
+    if (g_strcmp0(property_name, "ClockAnchor") == 0) return clock_anchor_value(state);
+    return nullptr;
+}
+
+static GVariant *handle_get_property(GDBusConnection *connection, const gchar *sender, const gchar *object_path, const gchar *interface_name, const gchar *property_name, GError **error, gpointer user_data) {
+    GVariant *value = property_value(static_cast<PlayerInterface*>(user_data)->state, property_name);
+    if (!value) g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_PROPERTY, "Unknown property %s", property_name);
+    return value;
+}
+
+static void handle_method_call(GDBusConnection *connection, const gchar *sender, const gchar *object_path, const gchar *interface_name, const gchar *method_name, GVariant *parameters, GDBusMethodInvocation *invocation, gpointer user_data) {
+    PlayerInterface *player = static_cast<PlayerInterface*>(user_data);
+    GError *error = nullptr;
+    GVariant *result = player->method_handler ? player->method_handler(sender, method_name, parameters, player->method_user_data, &error) : nullptr;
+    if (result) { g_dbus_method_invocation_return_value(invocation, result); return; }
+    if (error) { g_dbus_method_invocation_take_error(invocation, error); return; }
+    g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD, "Unknown method %s", method_name);
+}
+
+static const GDBusInterfaceVTable kVTable = { handle_method_call, handle_get_property, nullptr, { nullptr } };
+
+PlayerInterface *player_interface_register(GDBusConnection *connection, const char *object_path, player_method_handler_t handler, gpointer user_data, GError **error) {
+    if (!g_introspection) {
+        g_introspection = g_dbus_node_info_new_for_xml(kMusicInfoServiceXml, error);
+        if (!g_introspection) return nullptr;
+    }
+    GDBusInterfaceInfo *info = g_dbus_node_info_lookup_interface(g_introspection, kInterfaceName);
+    PlayerInterface *player = new PlayerInterface{connection, object_path, 0, PlayerState(), handler, user_data};
+    player->registration_id = g_dbus_connection_register_object(connection, object_path, info, &kVTable, player, nullptr, error);
+    if (player->registration_id == 0) { delete player; return nullptr; }
+    g_object_ref(connection);
+    return player;
+}
+
+void player_interface_unregister(PlayerInterface *player) {
+    if (!player) return;
+    g_dbus_connection_unregister_object(player->connection, player->registration_id);
+    g_object_unref(player->connection);
+    delete player;
+}
+
+void player_interface_build(PlayerState &snapshot, const PlayerState &state, GVariant **properties_changed, GVariant **state_changed, GVariant **clock_anchor) {
+    // 逐字段比较旧快照，只把变化的属性放进 PropertiesChanged。构造器放在栈上、每次重新 init：
+    // init 分配的子项数组在 g_variant_builder_end 时直接成为结果的存储，end 之后构造器也不能再用，
+    // 预先分配一个构造器跨更新复用省不下这次分配
+    GVariantBuilder changed;
+    g_variant_builder_init(&changed, G_VARIANT_TYPE_VARDICT);
+    bool any_changed = false;
+    auto add = [&](const char *name, GVariant *value) { g_variant_builder_add(&changed, "{sv}", name, value); any_changed = true; };
+    if (state.artist != snapshot.artist) add("Artist", g_variant_new_string(state.artist.c_str()));
+    if (state.title != snapshot.title) add("Title", g_variant_new_string(state.title.c_str()));
+    if (state.is_playing != snapshot.is_playing) add("IsPlaying", g_variant_new_boolean(state.is_playing));
+    if (state.current_lyric != snapshot.current_lyric) add("CurrentLyric", g_variant_new_string(state.current_lyric.c_str()));
+    if (state.current_segment != snapshot.current_segment) add("CurrentSegment", g_variant_new_string(state.current_segment.c_str()));
+    if (state.duration != snapshot.duration) add("Duration", g_variant_new_double(state.duration));
+    if (state.position != snapshot.position) add("Position", g_variant_new_double(state.position));
+    if (state.current_romanization != snapshot.current_romanization) add("CurrentRomanization", g_variant_new_string(state.current_romanization.c_str()));
+    if (state.line_start_us != snapshot.line_start_us) add("LineStartUs", g_variant_new_int64(state.line_start_us));
+    if (state.line_end_us != snapshot.line_end_us) add("LineEndUs", g_variant_new_int64(state.line_end_us));
+    if (state.next_lyric != snapshot.next_lyric) add("NextLyric", g_variant_new_string(state.next_lyric.c_str()));
+    bool anchor_changed = state.anchor_monotonic_us != snapshot.anchor_monotonic_us || state.anchor_position_us != snapshot.anchor_position_us || state.rate != snapshot.rate || state.is_playing != snapshot.is_playing;
+    *clock_anchor = anchor_changed ? clock_anchor_value(state) : nullptr;
+    if (anchor_changed) add("ClockAnchor", clock_anchor_value(state));
+    snapshot = state;
+
+    if (any_changed) {
+        GVariant *children[3] = { g_variant_new_string(kInterfaceName), g_variant_builder_end(&changed), g_variant_new_strv(nullptr, 0) };
+        *properties_changed = g_variant_new_tuple(children, 3);
+    } else {
+        g_variant_builder_clear(&changed);
+        *properties_changed = nullptr;
+    }
+
+    // 直接拼元组，省去 g_variant_new 解析格式串
+    GVariant *args[6] = {
+        g_variant_new_string(state.artist.c_str()),
+        g_variant_new_string(state.title.c_str()),
+        g_variant_new_boolean(state.is_playing),
+        g_variant_new_string(state.current_lyric.c_str()),
+        g_variant_new_double(state.duration),
+        g_variant_new_double(state.position),
+    };
+    *state_changed = g_variant_new_tuple(args, 6);
+}
+
+void player_interface_publish(PlayerInterface *player, const PlayerState &state) {
+    GVariant *properties_changed = nullptr;
+    GVariant *state_changed = nullptr;
+    GVariant *clock_anchor = nullptr;
+    player_interface_build(player->state, state, &properties_changed, &state_changed, &clock_anchor);
+    const char *path = player->object_path.c_str();
+    // 先发属性变化，客户端收到 StateChanged 时代理缓存已是最新
+    if (properties_changed) g_dbus_connection_emit_signal(player->connection, nullptr, path, "org.freedesktop.DBus.Properties", "PropertiesChanged", properties_changed, nullptr);
+    g_dbus_connection_emit_signal(player->connection, nullptr, path, kInterfaceName, "StateChanged", state_changed, nullptr);
+    if (clock_anchor) g_dbus_connection_emit_signal(player->connection, nullptr, path, kInterfaceName, "ClockAnchor", clock_anchor, nullptr);
+}
+
+void player_interface_emit_progress(PlayerInterface *player, int64_t position_us) {
+    g_dbus_connection_emit_signal(player->connection, nullptr, player->object_path.c_str(), kInterfaceName, "Progress", g_variant_new("(x)", static_cast<gint64>(position_us)), nullptr);
+}
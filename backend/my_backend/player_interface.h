@@ -0,0 +1,50 @@
+#pragma once
+
+#include <gio/gio.h>
+#include <cstdint>
+#include <string>
+
+// org.amazzy24128.MusicInfoService.Player 的手写实现：
+// 直接用 g_dbus_connection_register_object 导出，Get/GetAll 直接读下面的状态快照，
+// 不再经过 gdbus-codegen 生成的 GObject 属性和 GValue。
+// 接口定义仍以 music_info_service.xml 为准，编译时嵌入并在注册时解析。
+
+struct PlayerState {
+    std::string artist;
+    std::string title;
+    bool is_playing = false;
+    std::string current_lyric;
+    std::string current_segment;
+    double duration = 0.0;
+    double position = 0.0;
+    std::string current_romanization;
+    int64_t line_start_us = -1;
+    int64_t line_end_us = -1;
+    std::string next_lyric;
+    // 时钟锚点（见 EngineState）：anchor_monotonic_us 为 CLOCK_MONOTONIC 微秒，即 g_get_monotonic_time 的基准
+    int64_t anchor_monotonic_us = 0;
+    int64_t anchor_position_us = 0;
+    double rate = 1.0;
+};
+
+// 一个导出的对象。守护模式下每条会话总线各注册一个，各自保存状态快照；接口定义只解析一次，进程内共用
+struct PlayerInterface;
+
+// 方法调用交给适配层处理：返回结果元组（floating 引用即可）；出错时返回 nullptr 并设置 error，
+// 不认识的方法返回 nullptr 且不设置 error。sender 为调用方的唯一名，user_data 为注册时传入的值
+typedef GVariant *(*player_method_handler_t)(const gchar *sender, const gchar *method_name, GVariant *parameters, gpointer user_data, GError **error);
+
+// 失败返回 nullptr 并设置 error
+PlayerInterface *player_interface_register(GDBusConnection *connection, const char *object_path, player_method_handler_t handler, gpointer user_data, GError **error);
+void player_interface_unregister(PlayerInterface *player);
+
+// 更新快照并发信号：变化的属性合并成一条 PropertiesChanged，随后发出 StateChanged，锚点变了再发 ClockAnchor
+void player_interface_publish(PlayerInterface *player, const PlayerState &state);
+
+// 发出 Progress 信号（按订阅档位定时发送，不改快照）
+void player_interface_emit_progress(PlayerInterface *player, int64_t position_us);
+
+// 与 snapshot 比较后把它更新为 state，并构造信号的参数，不发送；没有属性变化时 *properties_changed 为 nullptr，
+// 锚点（含播放状态）没变时 *clock_anchor 为 nullptr。
+// 返回的 GVariant 为 floating 引用。player_interface_publish 和基准测试共用这一路径。
+void player_interface_build(PlayerState &snapshot, const PlayerState &state, GVariant **properties_changed, GVariant **state_changed, GVariant **clock_anchor);
@@ -0,0 +1,140 @@
+#include "romanization.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// 平假名 U+3041..U+3096 的罗马字，片假名减去 0x60 后共用此表
+const char *const kHiragana[] = {
+    "a", "a", "i", "i", "u", "u", "e", "e", "o", "o",                     // ぁ..お
+    "ka", "ga", "ki", "gi", "ku", "gu", "ke", "ge", "ko", "go",           // か..ご
+    "sa", "za", "shi", "ji", "su", "zu", "se", "ze", "so", "zo",          // さ..ぞ
+    "ta", "da", "chi", "ji", "", "tsu", "zu", "te", "de", "to", "do",     // た..ど（っ 单独处理）
+    "na", "ni", "nu", "ne", "no",                                         // な..の
+    "ha", "ba", "pa", "hi", "bi", "pi", "fu", "bu", "pu",                 // は..ぷ
+    "he", "be", "pe", "ho", "bo", "po",                                   // へ..ぽ
+    "ma", "mi", "mu", "me", "mo",                                         // ま..も
+    "ya", "ya", "yu", "yu", "yo", "yo",                                   // ゃ..よ
+    "ra", "ri", "ru", "re", "ro",                                         // ら..ろ
+    "wa", "wa", "wi", "we", "wo", "n", "vu", "ka", "ke",                  // ゎ..ゖ
+};
+constexpr uint32_t kHiraganaFirst = 0x3041;
+constexpr uint32_t kHiraganaLast = 0x3096;
+static_assert(sizeof(kHiragana) / sizeof(kHiragana[0]) == kHiraganaLast - kHiraganaFirst + 1, "kana table size");
+
+bool is_small_vowel(uint32_t cp) { return cp == 0x3041 || cp == 0x3043 || cp == 0x3045 || cp == 0x3047 || cp == 0x3049; }
+bool is_small_y(uint32_t cp) { return cp == 0x3083 || cp == 0x3085 || cp == 0x3087; }
+bool is_kana(uint32_t cp) { return (cp >= 0x3041 && cp <= 0x3096) || (cp >= 0x30A1 && cp <= 0x30FA) || cp == 0x30FC; }
+bool is_han(uint32_t cp) { return (cp >= 0x4E00 && cp <= 0x9FFF) || (cp >= 0x3400 && cp <= 0x4DBF); }
+bool is_vowel(char c) { return c == 'a' || c == 'i' || c == 'u' || c == 'e' || c == 'o'; }
+
+const char *pinyin_of(uint32_t cp) {
+    const PinyinEntry *end = kPinyinTable + kPinyinTableSize;
+    const PinyinEntry *it = std::lower_bound(kPinyinTable, end, cp, [](const PinyinEntry &e, uint32_t c){ return e.codepoint < c; });
+    return (it != end && it->codepoint == cp) ? it->syllable : nullptr;
+}
+
+void append_utf8(std::string &out, uint32_t cp) {
+    if (cp < 0x80) out.push_back(static_cast<char>(cp));
+    else if (cp < 0x800) { out.push_back(static_cast<char>(0xC0 | (cp >> 6))); out.push_back(static_cast<char>(0x80 | (cp & 0x3F))); }
+    else if (cp < 0x10000) { out.push_back(static_cast<char>(0xE0 | (cp >> 12))); out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F))); out.push_back(static_cast<char>(0x80 | (cp & 0x3F))); }
+    else { out.push_back(static_cast<char>(0xF0 | (cp >> 18))); out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F))); out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F))); out.push_back(static_cast<char>(0x80 | (cp & 0x3F))); }
+}
+
+// 输入已经过 decode_lyric_text，保证是合法 UTF-8
+std::vector<uint32_t> decode_utf8(std::string_view s) {
+    std::vector<uint32_t> cps;
+    cps.reserve(s.size());
+    for (size_t i = 0; i < s.size();) {
+        unsigned char c = s[i];
+        size_t len = c < 0x80 ? 1 : c < 0xE0 ? 2 : c < 0xF0 ? 3 : 4;
+        if (i + len > s.size()) break;
+        uint32_t cp = len == 1 ? c : len == 2 ? (c & 0x1F) : len == 3 ? (c & 0x0F) : (c & 0x07);
+        for (size_t k = 1; k < len; ++k) cp = (cp << 6) | (static_cast<unsigned char>(s[i + k]) & 0x3F);
+        cps.push_back(cp);
+        i += len;
+    }
+    return cps;
+}
+
+// 把一段连续假名转成一个罗马字单词
+void append_kana(std::string &word, uint32_t cp, bool &sokuon) {
+    if (cp >= 0x30A1 && cp <= 0x30F6) cp -= 0x60;
+    if (cp == 0x30FC) {  // 长音符号：重复前一个元音
+        if (!word.empty() && is_vowel(word.back())) word.push_back(word.back());
+        return;
+    }
+    if (cp < kHiraganaFirst || cp > kHiraganaLast) return;
+    if (cp == 0x3063) { sokuon = true; return; }
+    std::string syllable = kHiragana[cp - kHiraganaFirst];
+    if (!word.empty() && is_small_y(cp) && word.back() == 'i') {
+        // きゃ -> kya，しゃ -> sha，ちゃ -> cha，じゃ -> ja
+        word.pop_back();
+        bool palatal = word.size() >= 2 && (word.compare(word.size() - 2, 2, "sh") == 0 || word.compare(word.size() - 2, 2, "ch") == 0);
+        if (palatal || (!word.empty() && word.back() == 'j')) syllable.erase(0, 1);
+        word += syllable;
+        return;
+    }
+    if (!word.empty() && is_small_vowel(cp) && is_vowel(word.back())) {
+        // ファ -> fa，ティ -> ti
+        word.pop_back();
+        word += syllable;
+        return;
+    }
+    if (sokuon) {
+        // っ 重复下一个音节的辅音，ch 前写作 t
+        if (syllable.compare(0, 2, "ch") == 0) word.push_back('t');
+        else if (!is_vowel(syllable[0]) && syllable[0] != 'n') word.push_back(syllable[0]);
+        sokuon = false;
+    }
+    word += syllable;
+}
+
+} // namespace
+
+std::string romanize_line(std::string_view text) {
+    std::vector<uint32_t> cps = decode_utf8(text);
+    bool japanese = std::any_of(cps.begin(), cps.end(), is_kana);
+    if (!japanese && std::none_of(cps.begin(), cps.end(), is_han)) return "";
+
+    std::vector<std::string> tokens;
+    std::string word;
+    bool word_is_kana = false;
+    bool sokuon = false;
+    auto flush = [&]() {
+        if (!word.empty()) tokens.push_back(std::move(word));
+        word.clear();
+        word_is_kana = false;
+        sokuon = false;
+    };
+    for (uint32_t cp : cps) {
+        if (japanese && is_kana(cp)) {
+            if (!word_is_kana) flush();
+            word_is_kana = true;
+            append_kana(word, cp, sokuon);
+            continue;
+        }
+        if (cp == ' ' || cp == '\t' || cp == 0x3000 || cp == 0x30FB) { flush(); continue; }
+        const char *pinyin = (!japanese && is_han(cp)) ? pinyin_of(cp) : nullptr;
+        if (pinyin) { flush(); tokens.emplace_back(pinyin); continue; }
+        if (is_han(cp)) {
+            // 日文里的汉字，以及字典里没有的生僻字，原样保留
+            flush();
+            std::string han;
+            append_utf8(han, cp);
+            tokens.push_back(std::move(han));
+            continue;
+        }
+        if (word_is_kana) flush();
+        append_utf8(word, cp);
+    }
+    flush();
+
+    std::string out;
+    for (const std::string &token : tokens) {
+        if (!out.empty()) out.push_back(' ');
+        out += token;
+    }
+    return out;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// 歌词罗马音：中文转带声调拼音，日文假名转平文式罗马字。
+// 只在后台线程解析完时间轴后调用，显示路径只查预先算好的结果。
+
+struct PinyinEntry {
+    uint32_t codepoint;
+    char syllable[8];  // 带声调的拼音，UTF-8，最长如 "zhuàng" 共 7 字节
+};
+
+extern const PinyinEntry kPinyinTable[];
+extern const size_t kPinyinTableSize;
+
+// 含假名的行按日文处理（汉字原样保留），否则按中文转拼音；
+// 既无汉字也无假名的行返回空字符串
+std::string romanize_line(std::string_view text);
@@ -0,0 +1,1199 @@
+#include "romanization.h"
+
+// 编译进程序只读段的拼音字典：按码点排序，二分查找；
+// 只读段由内核按需从可执行文件映射，不占额外堆内存，也不需要启动时加载。
+// 收录歌词里常见的简体字及部分繁体字，多音字取歌词中最常用的读音。
+
+const PinyinEntry kPinyinTable[] = {
+    {0x4E00, "yī"}, // 一
+    {0x4E01, "dīng"}, // 丁
+    {0x4E03, "qī"}, // 七
+    {0x4E07, "wàn"}, // 万
+    {0x4E08, "zhàng"}, // 丈
+    {0x4E09, "sān"}, // 三
+    {0x4E0A, "shàng"}, // 上
+    {0x4E0B, "xià"}, // 下
+    {0x4E0D, "bù"}, // 不
+    {0x4E0E, "yǔ"}, // 与
+    {0x4E11, "chǒu"}, // 丑
+    {0x4E14, "qiě"}, // 且
+    {0x4E16, "shì"}, // 世
+    {0x4E1A, "yè"}, // 业
+    {0x4E1C, "dōng"}, // 东
+    {0x4E1D, "sī"}, // 丝
+    {0x4E22, "diū"}, // 丢
+    {0x4E24, "liǎng"}, // 两
+    {0x4E2A, "gè"}, // 个
+    {0x4E2D, "zhōng"}, // 中
+    {0x4E34, "lín"}, // 临
+    {0x4E3A, "wèi"}, // 为
+    {0x4E3B, "zhǔ"}, // 主
+    {0x4E3D, "lì"}, // 丽
+    {0x4E3E, "jǔ"}, // 举
+    {0x4E45, "jiǔ"}, // 久
+    {0x4E48, "me"}, // 么
+    {0x4E49, "yì"}, // 义
+    {0x4E4B, "zhī"}, // 之
+    {0x4E50, "lè"}, // 乐
+    {0x4E5D, "jiǔ"}, // 九
+    {0x4E5F, "yě"}, // 也
+    {0x4E60, "xí"}, // 习
+    {0x4E61, "xiāng"}, // 乡
+    {0x4E66, "shū"}, // 书
+    {0x4E70, "mǎi"}, // 买
+    {0x4E71, "luàn"}, // 乱
+    {0x4E86, "le"}, // 了
+    {0x4E89, "zhēng"}, // 争
+    {0x4E8B, "shì"}, // 事
+    {0x4E8C, "èr"}, // 二
+    {0x4E8E, "yú"}, // 于
+    {0x4E91, "yún"}, // 云
+    {0x4E94, "wǔ"}, // 五
+    {0x4E9B, "xiē"}, // 些
+    {0x4EA4, "jiāo"}, // 交
+    {0x4EAC, "jīng"}, // 京
+    {0x4EAE, "liàng"}, // 亮
+    {0x4EB2, "qīn"}, // 亲
+    {0x4EBA, "rén"}, // 人
+    {0x4EBF, "yì"}, // 亿
+    {0x4EC0, "shén"}, // 什
+    {0x4EC5, "jǐn"}, // 仅
+    {0x4ECA, "jīn"}, // 今
+    {0x4ECD, "réng"}, // 仍
+    {0x4ECE, "cóng"}, // 从
+    {0x4ED6, "tā"}, // 他
+    {0x4ED8, "fù"}, // 付
+    {0x4ED9, "xiān"}, // 仙
+    {0x4EE3, "dài"}, // 代
+    {0x4EE5, "yǐ"}, // 以
+    {0x4EEC, "men"}, // 们
+    {0x4EF6, "jiàn"}, // 件
+    {0x4EF7, "jià"}, // 价
+    {0x4EFB, "rèn"}, // 任
+    {0x4EFD, "fèn"}, // 份
+    {0x4EFF, "fǎng"}, // 仿
+    {0x4F11, "xiū"}, // 休
+    {0x4F18, "yōu"}, // 优
+    {0x4F1A, "huì"}, // 会
+    {0x4F1F, "wěi"}, // 伟
+    {0x4F20, "chuán"}, // 传
+    {0x4F24, "shāng"}, // 伤
+    {0x4F34, "bàn"}, // 伴
+    {0x4F3C, "sì"}, // 似
+    {0x4F46, "dàn"}, // 但
+    {0x4F4D, "wèi"}, // 位
+    {0x4F4E, "dī"}, // 低
+    {0x4F4F, "zhù"}, // 住
+    {0x4F53, "tǐ"}, // 体
+    {0x4F55, "hé"}, // 何
+    {0x4F59, "yú"}, // 余
+    {0x4F5B, "fó"}, // 佛
+    {0x4F5C, "zuò"}, // 作
+    {0x4F60, "nǐ"}, // 你
+    {0x4F7F, "shǐ"}, // 使
+    {0x4F86, "lái"}, // 來
+    {0x4F9D, "yī"}, // 依
+    {0x4FBF, "biàn"}, // 便
+    {0x4FC3, "cù"}, // 促
+    {0x4FDD, "bǎo"}, // 保
+    {0x4FE1, "xìn"}, // 信
+    {0x4FE9, "liǎ"}, // 俩
+    {0x500B, "gè"}, // 個
+    {0x500D, "bèi"}, // 倍
+    {0x5011, "men"}, // 們
+    {0x5012, "dǎo"}, // 倒
+    {0x5019, "hòu"}, // 候
+    {0x501F, "jiè"}, // 借
+    {0x503C, "zhí"}, // 值
+    {0x5047, "jiǎ"}, // 假
+    {0x505A, "zuò"}, // 做
+    {0x505C, "tíng"}, // 停
+    {0x5077, "tōu"}, // 偷
+    {0x50B2, "ào"}, // 傲
+    {0x50BB, "shǎ"}, // 傻
+    {0x50CF, "xiàng"}, // 像
+    {0x513F, "ér"}, // 儿
+    {0x5143, "yuán"}, // 元
+    {0x5148, "xiān"}, // 先
+    {0x5149, "guāng"}, // 光
+    {0x5165, "rù"}, // 入
+    {0x5168, "quán"}, // 全
+    {0x516B, "bā"}, // 八
+    {0x516C, "gōng"}, // 公
+    {0x516D, "liù"}, // 六
+    {0x5170, "lán"}, // 兰
+    {0x5171, "gòng"}, // 共
+    {0x5173, "guān"}, // 关
+    {0x5175, "bīng"}, // 兵
+    {0x5176, "qí"}, // 其
+    {0x5177, "jù"}, // 具
+    {0x517B, "yǎng"}, // 养
+    {0x5185, "nèi"}, // 内
+    {0x518D, "zài"}, // 再
+    {0x5192, "mào"}, // 冒
+    {0x5199, "xiě"}, // 写
+    {0x519B, "jūn"}, // 军
+    {0x51A4, "yuān"}, // 冤
+    {0x51AC, "dōng"}, // 冬
+    {0x51B0, "bīng"}, // 冰
+    {0x51B2, "chōng"}, // 冲
+    {0x51B3, "jué"}, // 决
+    {0x51B7, "lěng"}, // 冷
+    {0x51C6, "zhǔn"}, // 准
+    {0x51C9, "liáng"}, // 凉
+    {0x51CF, "jiǎn"}, // 减
+    {0x51E0, "jǐ"}, // 几
+    {0x51E1, "fán"}, // 凡
+    {0x51E4, "fèng"}, // 凤
+    {0x51ED, "píng"}, // 凭
+    {0x51FA, "chū"}, // 出
+    {0x51FB, "jī"}, // 击
+    {0x5200, "dāo"}, // 刀
+    {0x5206, "fēn"}, // 分
+    {0x5207, "qiè"}, // 切
+    {0x5219, "zé"}, // 则
+    {0x521A, "gāng"}, // 刚
+    {0x521D, "chū"}, // 初
+    {0x5229, "lì"}, // 利
+    {0x522B, "bié"}, // 别
+    {0x5230, "dào"}, // 到
+    {0x5236, "zhì"}, // 制
+    {0x523A, "cì"}, // 刺
+    {0x523B, "kè"}, // 刻
+    {0x524D, "qián"}, // 前
+    {0x5269, "shèng"}, // 剩
+    {0x526A, "jiǎn"}, // 剪
+    {0x5272, "gē"}, // 割
+    {0x529B, "lì"}, // 力
+    {0x529E, "bàn"}, // 办
+    {0x529F, "gōng"}, // 功
+    {0x52A0, "jiā"}, // 加
+    {0x52A8, "dòng"}, // 动
+    {0x52AA, "nǔ"}, // 努
+    {0x52C7, "yǒng"}, // 勇
+    {0x52D5, "dòng"}, // 動
+    {0x52FE, "gōu"}, // 勾
+    {0x5305, "bāo"}, // 包
+    {0x5306, "cōng"}, // 匆
+    {0x5316, "huà"}, // 化
+    {0x5317, "běi"}, // 北
+    {0x533A, "qū"}, // 区
+    {0x5341, "shí"}, // 十
+    {0x5343, "qiān"}, // 千
+    {0x5347, "shēng"}, // 升
+    {0x5348, "wǔ"}, // 午
+    {0x534A, "bàn"}, // 半
+    {0x534E, "huá"}, // 华
+    {0x5355, "dān"}, // 单
+    {0x5356, "mài"}, // 卖
+    {0x5357, "nán"}, // 南
+    {0x535A, "bó"}, // 博
+    {0x5370, "yìn"}, // 印
+    {0x5371, "wēi"}, // 危
+    {0x5373, "jí"}, // 即
+    {0x5374, "què"}, // 却
+    {0x5377, "juàn"}, // 卷
+    {0x5386, "lì"}, // 历
+    {0x538B, "yā"}, // 压
+    {0x539A, "hòu"}, // 厚
+    {0x539F, "yuán"}, // 原
+    {0x53BB, "qù"}, // 去
+    {0x53C2, "cān"}, // 参
+    {0x53C8, "yòu"}, // 又
+    {0x53CA, "jí"}, // 及
+    {0x53CB, "yǒu"}, // 友
+    {0x53CC, "shuāng"}, // 双
+    {0x53CD, "fǎn"}, // 反
+    {0x53D1, "fā"}, // 发
+    {0x53D6, "qǔ"}, // 取
+    {0x53D7, "shòu"}, // 受
+    {0x53D8, "biàn"}, // 变
+    {0x53E3, "kǒu"}, // 口
+    {0x53E4, "gǔ"}, // 古
+    {0x53E5, "jù"}, // 句
+    {0x53E6, "lìng"}, // 另
+    {0x53EA, "zhī"}, // 只
+    {0x53EB, "jiào"}, // 叫
+    {0x53EF, "kě"}, // 可
+    {0x53F0, "tái"}, // 台
+    {0x53F3, "yòu"}, // 右
+    {0x53F6, "yè"}, // 叶
+    {0x53F7, "hào"}, // 号
+    {0x53F8, "sī"}, // 司
+    {0x53F9, "tàn"}, // 叹
+    {0x5403, "chī"}, // 吃
+    {0x5404, "gè"}, // 各
+    {0x5408, "hé"}, // 合
+    {0x540C, "tóng"}, // 同
+    {0x540D, "míng"}, // 名
+    {0x540E, "hòu"}, // 后
+    {0x5411, "xiàng"}, // 向
+    {0x5413, "xià"}, // 吓
+    {0x5417, "ma"}, // 吗
+    {0x541B, "jūn"}, // 君
+    {0x5426, "fǒu"}, // 否
+    {0x5427, "bā"}, // 吧
+    {0x542B, "hán"}, // 含
+    {0x542C, "tīng"}, // 听
+    {0x5438, "xī"}, // 吸
+    {0x5439, "chuī"}, // 吹
+    {0x543B, "wěn"}, // 吻
+    {0x5440, "ya"}, // 呀
+    {0x5446, "dāi"}, // 呆
+    {0x544A, "gào"}, // 告
+    {0x5462, "ne"}, // 呢
+    {0x5468, "zhōu"}, // 周
+    {0x5473, "wèi"}, // 味
+    {0x547C, "hū"}, // 呼
+    {0x547D, "mìng"}, // 命
+    {0x548C, "hé"}, // 和
+    {0x5496, "kā"}, // 咖
+    {0x54B1, "zán"}, // 咱
+    {0x54C0, "āi"}, // 哀
+    {0x54C8, "hā"}, // 哈
+    {0x54CD, "xiǎng"}, // 响
+    {0x54E5, "gē"}, // 哥
+    {0x54E6, "ō"}, // 哦
+    {0x54EA, "nǎ"}, // 哪
+    {0x54ED, "kū"}, // 哭
+    {0x5507, "chún"}, // 唇
+    {0x5531, "chàng"}, // 唱
+    {0x5546, "shāng"}, // 商
+    {0x554A, "ā"}, // 啊
+    {0x554F, "wèn"}, // 問
+    {0x5584, "shàn"}, // 善
+    {0x558A, "hǎn"}, // 喊
+    {0x559C, "xǐ"}, // 喜
+    {0x559D, "hē"}, // 喝
+    {0x55B7, "pēn"}, // 喷
+    {0x561B, "ma"}, // 嘛
+    {0x5634, "zuǐ"}, // 嘴
+    {0x5668, "qì"}, // 器
+    {0x56DB, "sì"}, // 四
+    {0x56DE, "huí"}, // 回
+    {0x56E0, "yīn"}, // 因
+    {0x56E2, "tuán"}, // 团
+    {0x56ED, "yuán"}, // 园
+    {0x56F0, "kùn"}, // 困
+    {0x56F4, "wéi"}, // 围
+    {0x56FA, "gù"}, // 固
+    {0x56FD, "guó"}, // 国
+    {0x56FE, "tú"}, // 图
+    {0x5706, "yuán"}, // 圆
+    {0x570B, "guó"}, // 國
+    {0x571F, "tǔ"}, // 土
+    {0x5728, "zài"}, // 在
+    {0x5730, "dì"}, // 地
+    {0x573A, "chǎng"}, // 场
+    {0x574F, "huài"}, // 坏
+    {0x5750, "zuò"}, // 坐
+    {0x5757, "kuài"}, // 块
+    {0x575A, "jiān"}, // 坚
+    {0x57C3, "āi"}, // 埃
+    {0x57CB, "mái"}, // 埋
+    {0x57CE, "chéng"}, // 城
+    {0x57FA, "jī"}, // 基
+    {0x5802, "táng"}, // 堂
+    {0x5806, "duī"}, // 堆
+    {0x5883, "jìng"}, // 境
+    {0x5899, "qiáng"}, // 墙
+    {0x589E, "zēng"}, // 增
+    {0x58C1, "bì"}, // 壁
+    {0x58F0, "shēng"}, // 声
+    {0x5904, "chù"}, // 处
+    {0x5907, "bèi"}, // 备
+    {0x590D, "fù"}, // 复
+    {0x590F, "xià"}, // 夏
+    {0x5915, "xī"}, // 夕
+    {0x5916, "wài"}, // 外
+    {0x591A, "duō"}, // 多
+    {0x591C, "yè"}, // 夜
+    {0x591F, "gòu"}, // 够
+    {0x5922, "mèng"}, // 夢
+    {0x5927, "dà"}, // 大
+    {0x5929, "tiān"}, // 天
+    {0x592A, "tài"}, // 太
+    {0x592B, "fū"}, // 夫
+    {0x5931, "shī"}, // 失
+    {0x5934, "tóu"}, // 头
+    {0x5947, "qí"}, // 奇
+    {0x5965, "ào"}, // 奥
+    {0x5973, "nǚ"}, // 女
+    {0x5976, "nǎi"}, // 奶
+    {0x5979, "tā"}, // 她
+    {0x597D, "hǎo"}, // 好
+    {0x5982, "rú"}, // 如
+    {0x5988, "mā"}, // 妈
+    {0x59B9, "mèi"}, // 妹
+    {0x59CB, "shǐ"}, // 始
+    {0x59D0, "jiě"}, // 姐
+    {0x59D1, "gū"}, // 姑
+    {0x5A5A, "hūn"}, // 婚
+    {0x5B50, "zǐ"}, // 子
+    {0x5B57, "zì"}, // 字
+    {0x5B58, "cún"}, // 存
+    {0x5B59, "sūn"}, // 孙
+    {0x5B63, "jì"}, // 季
+    {0x5B64, "gū"}, // 孤
+    {0x5B66, "xué"}, // 学
+    {0x5B69, "hái"}, // 孩
+    {0x5B81, "níng"}, // 宁
+    {0x5B83, "tā"}, // 它
+    {0x5B87, "yǔ"}, // 宇
+    {0x5B88, "shǒu"}, // 守
+    {0x5B89, "ān"}, // 安
+    {0x5B8C, "wán"}, // 完
+    {0x5B98, "guān"}, // 官
+    {0x5B9A, "dìng"}, // 定
+    {0x5B9D, "bǎo"}, // 宝
+    {0x5B9E, "shí"}, // 实
+    {0x5BA2, "kè"}, // 客
+    {0x5BA3, "xuān"}, // 宣
+    {0x5BAB, "gōng"}, // 宫
+    {0x5BB3, "hài"}, // 害
+    {0x5BB6, "jiā"}, // 家
+    {0x5BB9, "róng"}, // 容
+    {0x5BBD, "kuān"}, // 宽
+    {0x5BC2, "jì"}, // 寂
+    {0x5BC4, "jì"}, // 寄
+    {0x5BC6, "mì"}, // 密
+    {0x5BCC, "fù"}, // 富
+    {0x5BD2, "hán"}, // 寒
+    {0x5BF9, "duì"}, // 对
+    {0x5BFB, "xún"}, // 寻
+    {0x5C01, "fēng"}, // 封
+    {0x5C06, "jiāng"}, // 将
+    {0x5C0A, "zūn"}, // 尊
+    {0x5C0D, "duì"}, // 對
+    {0x5C0F, "xiǎo"}, // 小
+    {0x5C11, "shǎo"}, // 少
+    {0x5C14, "ěr"}, // 尔
+    {0x5C16, "jiān"}, // 尖
+    {0x5C18, "chén"}, // 尘
+    {0x5C1D, "cháng"}, // 尝
+    {0x5C31, "jiù"}, // 就
+    {0x5C3A, "chǐ"}, // 尺
+    {0x5C3D, "jìn"}, // 尽
+    {0x5C40, "jú"}, // 局
+    {0x5C42, "céng"}, // 层
+    {0x5C45, "jū"}, // 居
+    {0x5C4B, "wū"}, // 屋
+    {0x5C5E, "shǔ"}, // 属
+    {0x5C71, "shān"}, // 山
+    {0x5C81, "suì"}, // 岁
+    {0x5C9B, "dǎo"}, // 岛
+    {0x5CB8, "àn"}, // 岸
+    {0x5CF0, "fēng"}, // 峰
+    {0x5DDD, "chuān"}, // 川
+    {0x5DE5, "gōng"}, // 工
+    {0x5DE6, "zuǒ"}, // 左
+    {0x5DE8, "jù"}, // 巨
+    {0x5DEE, "chà"}, // 差
+    {0x5DF1, "jǐ"}, // 己
+    {0x5DF2, "yǐ"}, // 已
+    {0x5DF4, "bā"}, // 巴
+    {0x5E02, "shì"}, // 市
+    {0x5E03, "bù"}, // 布
+    {0x5E08, "shī"}, // 师
+    {0x5E0C, "xī"}, // 希
+    {0x5E1D, "dì"}, // 帝
+    {0x5E26, "dài"}, // 带
+    {0x5E2E, "bāng"}, // 帮
+    {0x5E38, "cháng"}, // 常
+    {0x5E3D, "mào"}, // 帽
+    {0x5E72, "gān"}, // 干
+    {0x5E73, "píng"}, // 平
+    {0x5E74, "nián"}, // 年
+    {0x5E76, "bìng"}, // 并
+    {0x5E78, "xìng"}, // 幸
+    {0x5E7B, "huàn"}, // 幻
+    {0x5E7D, "yōu"}, // 幽
+    {0x5E7F, "guǎng"}, // 广
+    {0x5E86, "qìng"}, // 庆
+    {0x5E8A, "chuáng"}, // 床
+    {0x5E94, "yīng"}, // 应
+    {0x5E95, "dǐ"}, // 底
+    {0x5E97, "diàn"}, // 店
+    {0x5EA6, "dù"}, // 度
+    {0x5EA7, "zuò"}, // 座
+    {0x5EF6, "yán"}, // 延
+    {0x5EFA, "jiàn"}, // 建
+    {0x5F00, "kāi"}, // 开
+    {0x5F04, "nòng"}, // 弄
+    {0x5F0F, "shì"}, // 式
+    {0x5F15, "yǐn"}, // 引
+    {0x5F1F, "dì"}, // 弟
+    {0x5F20, "zhāng"}, // 张
+    {0x5F31, "ruò"}, // 弱
+    {0x5F39, "tán"}, // 弹
+    {0x5F3A, "qiáng"}, // 强
+    {0x5F52, "guī"}, // 归
+    {0x5F53, "dāng"}, // 当
+    {0x5F62, "xíng"}, // 形
+    {0x5F69, "cǎi"}, // 彩
+    {0x5F71, "yǐng"}, // 影
+    {0x5F7B, "chè"}, // 彻
+    {0x5F7C, "bǐ"}, // 彼
+    {0x5F80, "wǎng"}, // 往
+    {0x5F85, "dài"}, // 待
+    {0x5F88, "hěn"}, // 很
+    {0x5F8C, "hòu"}, // 後
+    {0x5F97, "dé"}, // 得
+    {0x5F9E, "cóng"}, // 從
+    {0x5FAE, "wēi"}, // 微
+    {0x5FB7, "dé"}, // 德
+    {0x5FC3, "xīn"}, // 心
+    {0x5FC5, "bì"}, // 必
+    {0x5FC6, "yì"}, // 忆
+    {0x5FCD, "rěn"}, // 忍
+    {0x5FD7, "zhì"}, // 志
+    {0x5FD8, "wàng"}, // 忘
+    {0x5FD9, "máng"}, // 忙
+    {0x5FE7, "yōu"}, // 忧
+    {0x5FEB, "kuài"}, // 快
+    {0x5FF5, "niàn"}, // 念
+    {0x5FFD, "hū"}, // 忽
+    {0x6000, "huái"}, // 怀
+    {0x6001, "tài"}, // 态
+    {0x600E, "zěn"}, // 怎
+    {0x6012, "nù"}, // 怒
+    {0x6015, "pà"}, // 怕
+    {0x601C, "lián"}, // 怜
+    {0x601D, "sī"}, // 思
+    {0x6025, "jí"}, // 急
+    {0x6027, "xìng"}, // 性
+    {0x602A, "guài"}, // 怪
+    {0x604B, "liàn"}, // 恋
+    {0x6050, "kǒng"}, // 恐
+    {0x6068, "hèn"}, // 恨
+    {0x606F, "xī"}, // 息
+    {0x6076, "è"}, // 恶
+    {0x6084, "qiāo"}, // 悄
+    {0x6094, "huǐ"}, // 悔
+    {0x60A8, "nín"}, // 您
+    {0x60B2, "bēi"}, // 悲
+    {0x60C5, "qíng"}, // 情
+    {0x60CA, "jīng"}, // 惊
+    {0x60DC, "xī"}, // 惜
+    {0x60E8, "cǎn"}, // 惨
+    {0x60EF, "guàn"}, // 惯
+    {0x60F3, "xiǎng"}, // 想
+    {0x6101, "chóu"}, // 愁
+    {0x610F, "yì"}, // 意
+    {0x611B, "ài"}, // 愛
+    {0x611F, "gǎn"}, // 感
+    {0x613F, "yuàn"}, // 愿
+    {0x614C, "huāng"}, // 慌
+    {0x6162, "màn"}, // 慢
+    {0x61B6, "yì"}, // 憶
+    {0x61C2, "dǒng"}, // 懂
+    {0x6200, "liàn"}, // 戀
+    {0x620F, "xì"}, // 戏
+    {0x6210, "chéng"}, // 成
+    {0x6211, "wǒ"}, // 我
+    {0x6216, "huò"}, // 或
+    {0x6234, "dài"}, // 戴
+    {0x6237, "hù"}, // 户
+    {0x623F, "fáng"}, // 房
+    {0x6240, "suǒ"}, // 所
+    {0x624B, "shǒu"}, // 手
+    {0x624D, "cái"}, // 才
+    {0x6253, "dǎ"}, // 打
+    {0x625B, "káng"}, // 扛
+    {0x6269, "kuò"}, // 扩
+    {0x626E, "bàn"}, // 扮
+    {0x6276, "fú"}, // 扶
+    {0x6279, "pī"}, // 批
+    {0x627E, "zhǎo"}, // 找
+    {0x627F, "chéng"}, // 承
+    {0x628A, "bǎ"}, // 把
+    {0x6293, "zhuā"}, // 抓
+    {0x629A, "fǔ"}, // 抚
+    {0x62A4, "hù"}, // 护
+    {0x62A5, "bào"}, // 报
+    {0x62AC, "tái"}, // 抬
+    {0x62B1, "bào"}, // 抱
+    {0x62BD, "chōu"}, // 抽
+    {0x62C5, "dān"}, // 担
+    {0x62C9, "lā"}, // 拉
+    {0x62CD, "pāi"}, // 拍
+    {0x62DB, "zhāo"}, // 招
+    {0x62DC, "bài"}, // 拜
+    {0x62E5, "yōng"}, // 拥
+    {0x62FC, "pīn"}, // 拼
+    {0x62FE, "shí"}, // 拾
+    {0x62FF, "ná"}, // 拿
+    {0x6301, "chí"}, // 持
+    {0x6302, "guà"}, // 挂
+    {0x6307, "zhǐ"}, // 指
+    {0x6309, "àn"}, // 按
+    {0x6311, "tiāo"}, // 挑
+    {0x6316, "wā"}, // 挖
+    {0x6321, "dǎng"}, // 挡
+    {0x6325, "huī"}, // 挥
+    {0x6328, "āi"}, // 挨
+    {0x633A, "tǐng"}, // 挺
+    {0x6350, "juān"}, // 捐
+    {0x6362, "huàn"}, // 换
+    {0x6389, "diào"}, // 掉
+    {0x638C, "zhǎng"}, // 掌
+    {0x6392, "pái"}, // 排
+    {0x63A5, "jiē"}, // 接
+    {0x63A7, "kòng"}, // 控
+    {0x63A8, "tuī"}, // 推
+    {0x63D0, "tí"}, // 提
+    {0x63D2, "chā"}, // 插
+    {0x63E1, "wò"}, // 握
+    {0x641E, "gǎo"}, // 搞
+    {0x6446, "bǎi"}, // 摆
+    {0x6447, "yáo"}, // 摇
+    {0x649E, "zhuàng"}, // 撞
+    {0x64AD, "bō"}, // 播
+    {0x64E6, "cā"}, // 擦
+    {0x652F, "zhī"}, // 支
+    {0x6536, "shōu"}, // 收
+    {0x6539, "gǎi"}, // 改
+    {0x653E, "fàng"}, // 放
+    {0x6545, "gù"}, // 故
+    {0x6551, "jiù"}, // 救
+    {0x6559, "jiāo"}, // 教
+    {0x6562, "gǎn"}, // 敢
+    {0x6563, "sàn"}, // 散
+    {0x6570, "shù"}, // 数
+    {0x6574, "zhěng"}, // 整
+    {0x6587, "wén"}, // 文
+    {0x6597, "dòu"}, // 斗
+    {0x6599, "liào"}, // 料
+    {0x65AD, "duàn"}, // 断
+    {0x65B0, "xīn"}, // 新
+    {0x65B7, "duàn"}, // 斷
+    {0x65B9, "fāng"}, // 方
+    {0x65C1, "páng"}, // 旁
+    {0x65C5, "lǚ"}, // 旅
+    {0x65E0, "wú"}, // 无
+    {0x65E5, "rì"}, // 日
+    {0x65E7, "jiù"}, // 旧
+    {0x65E9, "zǎo"}, // 早
+    {0x65F6, "shí"}, // 时
+    {0x660E, "míng"}, // 明
+    {0x660F, "hūn"}, // 昏
+    {0x661F, "xīng"}, // 星
+    {0x6625, "chūn"}, // 春
+    {0x6628, "zuó"}, // 昨
+    {0x662F, "shì"}, // 是
+    {0x663E, "xiǎn"}, // 显
+    {0x6642, "shí"}, // 時
+    {0x6653, "xiǎo"}, // 晓
+    {0x665A, "wǎn"}, // 晚
+    {0x6668, "chén"}, // 晨
+    {0x666E, "pǔ"}, // 普
+    {0x666F, "jǐng"}, // 景
+    {0x6674, "qíng"}, // 晴
+    {0x6696, "nuǎn"}, // 暖
+    {0x6697, "àn"}, // 暗
+    {0x66B4, "bào"}, // 暴
+    {0x66F2, "qǔ"}, // 曲
+    {0x66F4, "gèng"}, // 更
+    {0x66FE, "céng"}, // 曾
+    {0x66FF, "tì"}, // 替
+    {0x6700, "zuì"}, // 最
+    {0x6703, "huì"}, // 會
+    {0x6708, "yuè"}, // 月
+    {0x6709, "yǒu"}, // 有
+    {0x670B, "péng"}, // 朋
+    {0x670D, "fú"}, // 服
+    {0x6717, "lǎng"}, // 朗
+    {0x671B, "wàng"}, // 望
+    {0x671D, "cháo"}, // 朝
+    {0x671F, "qī"}, // 期
+    {0x6728, "mù"}, // 木
+    {0x672A, "wèi"}, // 未
+    {0x672B, "mò"}, // 末
+    {0x672C, "běn"}, // 本
+    {0x6735, "duǒ"}, // 朵
+    {0x673A, "jī"}, // 机
+    {0x6740, "shā"}, // 杀
+    {0x674E, "lǐ"}, // 李
+    {0x6750, "cái"}, // 材
+    {0x6751, "cūn"}, // 村
+    {0x6761, "tiáo"}, // 条
+    {0x6765, "lái"}, // 来
+    {0x676F, "bēi"}, // 杯
+    {0x6771, "dōng"}, // 東
+    {0x677E, "sōng"}, // 松
+    {0x6781, "jí"}, // 极
+    {0x6797, "lín"}, // 林
+    {0x679C, "guǒ"}, // 果
+    {0x67B6, "jià"}, // 架
+    {0x67D4, "róu"}, // 柔
+    {0x67E5, "chá"}, // 查
+    {0x6807, "biāo"}, // 标
+    {0x6811, "shù"}, // 树
+    {0x6837, "yàng"}, // 样
+    {0x6839, "gēn"}, // 根
+    {0x683C, "gé"}, // 格
+    {0x6848, "àn"}, // 案
+    {0x684C, "zhuō"}, // 桌
+    {0x6865, "qiáo"}, // 桥
+    {0x6885, "méi"}, // 梅
+    {0x689D, "tiáo"}, // 條
+    {0x68A6, "mèng"}, // 梦
+    {0x68A8, "lí"}, // 梨
+    {0x68C9, "mián"}, // 棉
+    {0x68D2, "bàng"}, // 棒
+    {0x68EE, "sēn"}, // 森
+    {0x68F5, "kē"}, // 棵
+    {0x695A, "chǔ"}, // 楚
+    {0x697C, "lóu"}, // 楼
+    {0x6A21, "mó"}, // 模
+    {0x6A23, "yàng"}, // 樣
+    {0x6A2A, "héng"}, // 横
+    {0x6B21, "cì"}, // 次
+    {0x6B22, "huān"}, // 欢
+    {0x6B32, "yù"}, // 欲
+    {0x6B4C, "gē"}, // 歌
+    {0x6B62, "zhǐ"}, // 止
+    {0x6B63, "zhèng"}, // 正
+    {0x6B64, "cǐ"}, // 此
+    {0x6B65, "bù"}, // 步
+    {0x6B72, "suì"}, // 歲
+    {0x6B7B, "sǐ"}, // 死
+    {0x6B8B, "cán"}, // 残
+    {0x6BB5, "duàn"}, // 段
+    {0x6BC1, "huǐ"}, // 毁
+    {0x6BCD, "mǔ"}, // 母
+    {0x6BCF, "měi"}, // 每
+    {0x6BD2, "dú"}, // 毒
+    {0x6BD4, "bǐ"}, // 比
+    {0x6BD5, "bì"}, // 毕
+    {0x6BDB, "máo"}, // 毛
+    {0x6C11, "mín"}, // 民
+    {0x6C14, "qì"}, // 气
+    {0x6C34, "shuǐ"}, // 水
+    {0x6C38, "yǒng"}, // 永
+    {0x6C42, "qiú"}, // 求
+    {0x6C47, "huì"}, // 汇
+    {0x6C57, "hàn"}, // 汗
+    {0x6C5F, "jiāng"}, // 江
+    {0x6C60, "chí"}, // 池
+    {0x6C89, "chén"}, // 沉
+    {0x6C92, "méi"}, // 沒
+    {0x6C99, "shā"}, // 沙
+    {0x6CA1, "méi"}, // 没
+    {0x6CB3, "hé"}, // 河
+    {0x6CB9, "yóu"}, // 油
+    {0x6CD5, "fǎ"}, // 法
+    {0x6CE2, "bō"}, // 波
+    {0x6CE8, "zhù"}, // 注
+    {0x6CEA, "lèi"}, // 泪
+    {0x6D0B, "yáng"}, // 洋
+    {0x6D12, "sǎ"}, // 洒
+    {0x6D17, "xǐ"}, // 洗
+    {0x6D1E, "dòng"}, // 洞
+    {0x6D3B, "huó"}, // 活
+    {0x6D41, "liú"}, // 流
+    {0x6D45, "qiǎn"}, // 浅
+    {0x6D53, "nóng"}, // 浓
+    {0x6D6A, "làng"}, // 浪
+    {0x6D6E, "fú"}, // 浮
+    {0x6D77, "hǎi"}, // 海
+    {0x6D88, "xiāo"}, // 消
+    {0x6DDA, "lèi"}, // 淚
+    {0x6DE1, "dàn"}, // 淡
+    {0x6DF1, "shēn"}, // 深
+    {0x6E10, "jiàn"}, // 渐
+    {0x6E21, "dù"}, // 渡
+    {0x6E29, "wēn"}, // 温
+    {0x6E34, "kě"}, // 渴
+    {0x6E38, "yóu"}, // 游
+    {0x6E56, "hú"}, // 湖
+    {0x6E7F, "shī"}, // 湿
+    {0x6ED1, "huá"}, // 滑
+    {0x6EDA, "gǔn"}, // 滚
+    {0x6EE1, "mǎn"}, // 满
+    {0x6F14, "yǎn"}, // 演
+    {0x6F2B, "màn"}, // 漫
+    {0x6F6E, "cháo"}, // 潮
+    {0x6FC0, "jī"}, // 激
+    {0x706B, "huǒ"}, // 火
+    {0x706D, "miè"}, // 灭
+    {0x7070, "huī"}, // 灰
+    {0x7075, "líng"}, // 灵
+    {0x70B9, "diǎn"}, // 点
+    {0x70BA, "wèi"}, // 為
+    {0x70C2, "làn"}, // 烂
+    {0x70C8, "liè"}, // 烈
+    {0x70DF, "yān"}, // 烟
+    {0x70E6, "fán"}, // 烦
+    {0x70E7, "shāo"}, // 烧
+    {0x70EB, "tàng"}, // 烫
+    {0x70ED, "rè"}, // 热
+    {0x7121, "wú"}, // 無
+    {0x7136, "rán"}, // 然
+    {0x7167, "zhào"}, // 照
+    {0x718A, "xióng"}, // 熊
+    {0x719F, "shú"}, // 熟
+    {0x71C3, "rán"}, // 燃
+    {0x71D5, "yàn"}, // 燕
+    {0x722C, "pá"}, // 爬
+    {0x7231, "ài"}, // 爱
+    {0x7236, "fù"}, // 父
+    {0x7237, "yé"}, // 爷
+    {0x7238, "bà"}, // 爸
+    {0x7247, "piàn"}, // 片
+    {0x7259, "yá"}, // 牙
+    {0x725B, "niú"}, // 牛
+    {0x7269, "wù"}, // 物
+    {0x7275, "qiān"}, // 牵
+    {0x7279, "tè"}, // 特
+    {0x72AF, "fàn"}, // 犯
+    {0x72C2, "kuáng"}, // 狂
+    {0x72D7, "gǒu"}, // 狗
+    {0x72EC, "dú"}, // 独
+    {0x72FC, "láng"}, // 狼
+    {0x732B, "māo"}, // 猫
+    {0x7389, "yù"}, // 玉
+    {0x738B, "wáng"}, // 王
+    {0x73A9, "wán"}, // 玩
+    {0x73AF, "huán"}, // 环
+    {0x73B0, "xiàn"}, // 现
+    {0x73CD, "zhēn"}, // 珍
+    {0x73E0, "zhū"}, // 珠
+    {0x73ED, "bān"}, // 班
+    {0x7403, "qiú"}, // 球
+    {0x7406, "lǐ"}, // 理
+    {0x74DC, "guā"}, // 瓜
+    {0x74F6, "píng"}, // 瓶
+    {0x7518, "gān"}, // 甘
+    {0x751A, "shèn"}, // 甚
+    {0x751C, "tián"}, // 甜
+    {0x751F, "shēng"}, // 生
+    {0x7528, "yòng"}, // 用
+    {0x7530, "tián"}, // 田
+    {0x7531, "yóu"}, // 由
+    {0x7535, "diàn"}, // 电
+    {0x7537, "nán"}, // 男
+    {0x753B, "huà"}, // 画
+    {0x754C, "jiè"}, // 界
+    {0x7559, "liú"}, // 留
+    {0x7591, "yí"}, // 疑
+    {0x75AF, "fēng"}, // 疯
+    {0x75BC, "téng"}, // 疼
+    {0x75C5, "bìng"}, // 病
+    {0x75DB, "tòng"}, // 痛
+    {0x75F4, "chī"}, // 痴
+    {0x7626, "shòu"}, // 瘦
+    {0x767D, "bái"}, // 白
+    {0x767E, "bǎi"}, // 百
+    {0x7684, "de"}, // 的
+    {0x7687, "huáng"}, // 皇
+    {0x76AE, "pí"}, // 皮
+    {0x76D6, "gài"}, // 盖
+    {0x76D8, "pán"}, // 盘
+    {0x76EE, "mù"}, // 目
+    {0x76F2, "máng"}, // 盲
+    {0x76F4, "zhí"}, // 直
+    {0x76F8, "xiāng"}, // 相
+    {0x76FC, "pàn"}, // 盼
+    {0x7709, "méi"}, // 眉
+    {0x770B, "kàn"}, // 看
+    {0x771F, "zhēn"}, // 真
+    {0x7720, "mián"}, // 眠
+    {0x7728, "zhǎ"}, // 眨
+    {0x773C, "yǎn"}, // 眼
+    {0x7740, "zhe"}, // 着
+    {0x7741, "zhēng"}, // 睁
+    {0x7761, "shuì"}, // 睡
+    {0x77E5, "zhī"}, // 知
+    {0x77ED, "duǎn"}, // 短
+    {0x77EE, "ǎi"}, // 矮
+    {0x77F3, "shí"}, // 石
+    {0x7834, "pò"}, // 破
+    {0x786C, "yìng"}, // 硬
+    {0x786E, "què"}, // 确
+    {0x788D, "ài"}, // 碍
+    {0x788E, "suì"}, // 碎
+    {0x78B0, "pèng"}, // 碰
+    {0x793C, "lǐ"}, // 礼
+    {0x793E, "shè"}, // 社
+    {0x795D, "zhù"}, // 祝
+    {0x795E, "shén"}, // 神
+    {0x7968, "piào"}, // 票
+    {0x798F, "fú"}, // 福
+    {0x79BB, "lí"}, // 离
+    {0x79C1, "sī"}, // 私
+    {0x79CB, "qiū"}, // 秋
+    {0x79CD, "zhǒng"}, // 种
+    {0x79D1, "kē"}, // 科
+    {0x79D2, "miǎo"}, // 秒
+    {0x79D8, "mì"}, // 秘
+    {0x79EF, "jī"}, // 积
+    {0x79F0, "chēng"}, // 称
+    {0x79FB, "yí"}, // 移
+    {0x7A0B, "chéng"}, // 程
+    {0x7A33, "wěn"}, // 稳
+    {0x7A76, "jiū"}, // 究
+    {0x7A77, "qióng"}, // 穷
+    {0x7A7A, "kōng"}, // 空
+    {0x7A7F, "chuān"}, // 穿
+    {0x7A81, "tū"}, // 突
+    {0x7A97, "chuāng"}, // 窗
+    {0x7ACB, "lì"}, // 立
+    {0x7AD9, "zhàn"}, // 站
+    {0x7ADF, "jìng"}, // 竟
+    {0x7AE5, "tóng"}, // 童
+    {0x7AEF, "duān"}, // 端
+    {0x7AF9, "zhú"}, // 竹
+    {0x7B11, "xiào"}, // 笑
+    {0x7B14, "bǐ"}, // 笔
+    {0x7B1B, "dí"}, // 笛
+    {0x7B28, "bèn"}, // 笨
+    {0x7B2C, "dì"}, // 第
+    {0x7B49, "děng"}, // 等
+    {0x7B54, "dá"}, // 答
+    {0x7B80, "jiǎn"}, // 简
+    {0x7B97, "suàn"}, // 算
+    {0x7BA1, "guǎn"}, // 管
+    {0x7BC7, "piān"}, // 篇
+    {0x7C7B, "lèi"}, // 类
+    {0x7C89, "fěn"}, // 粉
+    {0x7CD6, "táng"}, // 糖
+    {0x7CFB, "xì"}, // 系
+    {0x7D27, "jǐn"}, // 紧
+    {0x7D2B, "zǐ"}, // 紫
+    {0x7D2F, "lèi"}, // 累
+    {0x7D93, "jīng"}, // 經
+    {0x7EA2, "hóng"}, // 红
+    {0x7EA6, "yuē"}, // 约
+    {0x7EAF, "chún"}, // 纯
+    {0x7EB7, "fēn"}, // 纷
+    {0x7EB8, "zhǐ"}, // 纸
+    {0x7EBF, "xiàn"}, // 线
+    {0x7EC3, "liàn"}, // 练
+    {0x7EC6, "xì"}, // 细
+    {0x7EC8, "zhōng"}, // 终
+    {0x7ECF, "jīng"}, // 经
+    {0x7ED3, "jié"}, // 结
+    {0x7ED5, "rào"}, // 绕
+    {0x7ED9, "gěi"}, // 给
+    {0x7EDD, "jué"}, // 绝
+    {0x7EE7, "jì"}, // 继
+    {0x7EED, "xù"}, // 续
+    {0x7EF3, "shéng"}, // 绳
+    {0x7EFF, "lǜ"}, // 绿
+    {0x7F16, "biān"}, // 编
+    {0x7F20, "chán"}, // 缠
+    {0x7F3A, "quē"}, // 缺
+    {0x7F51, "wǎng"}, // 网
+    {0x7F57, "luó"}, // 罗
+    {0x7F62, "bà"}, // 罢
+    {0x7F6A, "zuì"}, // 罪
+    {0x7F8A, "yáng"}, // 羊
+    {0x7F8E, "měi"}, // 美
+    {0x7FA4, "qún"}, // 群
+    {0x7FC5, "chì"}, // 翅
+    {0x7FFB, "fān"}, // 翻
+    {0x8001, "lǎo"}, // 老
+    {0x8003, "kǎo"}, // 考
+    {0x800C, "ér"}, // 而
+    {0x8010, "nài"}, // 耐
+    {0x8033, "ěr"}, // 耳
+    {0x804A, "liáo"}, // 聊
+    {0x805A, "jù"}, // 聚
+    {0x8072, "shēng"}, // 聲
+    {0x807D, "tīng"}, // 聽
+    {0x8089, "ròu"}, // 肉
+    {0x809A, "dù"}, // 肚
+    {0x80A0, "cháng"}, // 肠
+    {0x80A5, "féi"}, // 肥
+    {0x80A9, "jiān"}, // 肩
+    {0x80AF, "kěn"}, // 肯
+    {0x80C6, "dǎn"}, // 胆
+    {0x80CC, "bēi"}, // 背
+    {0x80DC, "shèng"}, // 胜
+    {0x80E1, "hú"}, // 胡
+    {0x80F8, "xiōng"}, // 胸
+    {0x80FD, "néng"}, // 能
+    {0x8106, "cuì"}, // 脆
+    {0x810F, "zāng"}, // 脏
+    {0x8111, "nǎo"}, // 脑
+    {0x811A, "jiǎo"}, // 脚
+    {0x8131, "tuō"}, // 脱
+    {0x8138, "liǎn"}, // 脸
+    {0x8170, "yāo"}, // 腰
+    {0x81C2, "bì"}, // 臂
+    {0x81EA, "zì"}, // 自
+    {0x81F3, "zhì"}, // 至
+    {0x8207, "yǔ"}, // 與
+    {0x821E, "wǔ"}, // 舞
+    {0x822C, "bān"}, // 般
+    {0x8239, "chuán"}, // 船
+    {0x826F, "liáng"}, // 良
+    {0x8272, "sè"}, // 色
+    {0x827E, "ài"}, // 艾
+    {0x8282, "jié"}, // 节
+    {0x82B1, "huā"}, // 花
+    {0x82CD, "cāng"}, // 苍
+    {0x82D7, "miáo"}, // 苗
+    {0x82E5, "ruò"}, // 若
+    {0x82E6, "kǔ"}, // 苦
+    {0x82F1, "yīng"}, // 英
+    {0x8336, "chá"}, // 茶
+    {0x8349, "cǎo"}, // 草
+    {0x8352, "huāng"}, // 荒
+    {0x8363, "róng"}, // 荣
+    {0x836F, "yào"}, // 药
+    {0x83AB, "mò"}, // 莫
+    {0x83B7, "huò"}, // 获
+    {0x83DC, "cài"}, // 菜
+    {0x843D, "luò"}, // 落
+    {0x84DD, "lán"}, // 蓝
+    {0x85CF, "cáng"}, // 藏
+    {0x864E, "hǔ"}, // 虎
+    {0x866B, "chóng"}, // 虫
+    {0x867D, "suī"}, // 虽
+    {0x86C7, "shé"}, // 蛇
+    {0x86CB, "dàn"}, // 蛋
+    {0x8776, "dié"}, // 蝶
+    {0x8840, "xuè"}, // 血
+    {0x884C, "xíng"}, // 行
+    {0x8857, "jiē"}, // 街
+    {0x8863, "yī"}, // 衣
+    {0x8865, "bǔ"}, // 补
+    {0x8868, "biǎo"}, // 表
+    {0x888B, "dài"}, // 袋
+    {0x88AB, "bèi"}, // 被
+    {0x88C5, "zhuāng"}, // 装
+    {0x88E1, "lǐ"}, // 裡
+    {0x897F, "xī"}, // 西
+    {0x8981, "yào"}, // 要
+    {0x898B, "jiàn"}, // 見
+    {0x89C1, "jiàn"}, // 见
+    {0x89C2, "guān"}, // 观
+    {0x89C4, "guī"}, // 规
+    {0x89C6, "shì"}, // 视
+    {0x89C9, "jué"}, // 觉
+    {0x89D2, "jiǎo"}, // 角
+    {0x89E3, "jiě"}, // 解
+    {0x89E6, "chù"}, // 触
+    {0x8A00, "yán"}, // 言
+    {0x8A18, "jì"}, // 記
+    {0x8A71, "huà"}, // 話
+    {0x8AAA, "shuō"}, // 說
+    {0x8B93, "ràng"}, // 讓
+    {0x8BA1, "jì"}, // 计
+    {0x8BA4, "rèn"}, // 认
+    {0x8BA8, "tǎo"}, // 讨
+    {0x8BA9, "ràng"}, // 让
+    {0x8BB0, "jì"}, // 记
+    {0x8BB2, "jiǎng"}, // 讲
+    {0x8BB8, "xǔ"}, // 许
+    {0x8BBA, "lùn"}, // 论
+    {0x8BBE, "shè"}, // 设
+    {0x8BC1, "zhèng"}, // 证
+    {0x8BC6, "shí"}, // 识
+    {0x8BC9, "sù"}, // 诉
+    {0x8BCD, "cí"}, // 词
+    {0x8BD5, "shì"}, // 试
+    {0x8BD7, "shī"}, // 诗
+    {0x8BDA, "chéng"}, // 诚
+    {0x8BDD, "huà"}, // 话
+    {0x8BE5, "gāi"}, // 该
+    {0x8BED, "yǔ"}, // 语
+    {0x8BEF, "wù"}, // 误
+    {0x8BF4, "shuō"}, // 说
+    {0x8BF7, "qǐng"}, // 请
+    {0x8BFB, "dú"}, // 读
+    {0x8BFE, "kè"}, // 课
+    {0x8C01, "shéi"}, // 谁
+    {0x8C03, "diào"}, // 调
+    {0x8C08, "tán"}, // 谈
+    {0x8C22, "xiè"}, // 谢
+    {0x8C46, "dòu"}, // 豆
+    {0x8D1D, "bèi"}, // 贝
+    {0x8D1F, "fù"}, // 负
+    {0x8D22, "cái"}, // 财
+    {0x8D25, "bài"}, // 败
+    {0x8D2B, "pín"}, // 贫
+    {0x8D35, "guì"}, // 贵
+    {0x8D39, "fèi"}, // 费
+    {0x8D3A, "hè"}, // 贺
+    {0x8D44, "zī"}, // 资
+    {0x8D4F, "shǎng"}, // 赏
+    {0x8D5B, "sài"}, // 赛
+    {0x8D5E, "zàn"}, // 赞
+    {0x8D62, "yíng"}, // 赢
+    {0x8D64, "chì"}, // 赤
+    {0x8D70, "zǒu"}, // 走
+    {0x8D76, "gǎn"}, // 赶
+    {0x8D77, "qǐ"}, // 起
+    {0x8D81, "chèn"}, // 趁
+    {0x8D85, "chāo"}, // 超
+    {0x8D8A, "yuè"}, // 越
+    {0x8DA3, "qù"}, // 趣
+    {0x8DB3, "zú"}, // 足
+    {0x8DD1, "pǎo"}, // 跑
+    {0x8DDF, "gēn"}, // 跟
+    {0x8DEA, "guì"}, // 跪
+    {0x8DEF, "lù"}, // 路
+    {0x8DF3, "tiào"}, // 跳
+    {0x8E22, "tī"}, // 踢
+    {0x8E29, "cǎi"}, // 踩
+    {0x8E2A, "zōng"}, // 踪
+    {0x8E72, "dūn"}, // 蹲
+    {0x8EAB, "shēn"}, // 身
+    {0x8EB2, "duǒ"}, // 躲
+    {0x8EBA, "tǎng"}, // 躺
+    {0x8F15, "qīng"}, // 輕
+    {0x8F66, "chē"}, // 车
+    {0x8F6C, "zhuǎn"}, // 转
+    {0x8F6E, "lún"}, // 轮
+    {0x8F6F, "ruǎn"}, // 软
+    {0x8F88, "bèi"}, // 辈
+    {0x8F93, "shū"}, // 输
+    {0x8F9E, "cí"}, // 辞
+    {0x8FA3, "là"}, // 辣
+    {0x8FB9, "biān"}, // 边
+    {0x8FBE, "dá"}, // 达
+    {0x8FC7, "guò"}, // 过
+    {0x8FCE, "yíng"}, // 迎
+    {0x8FD0, "yùn"}, // 运
+    {0x8FD1, "jìn"}, // 近
+    {0x8FD8, "hái"}, // 还
+    {0x8FD9, "zhè"}, // 这
+    {0x8FDB, "jìn"}, // 进
+    {0x8FDC, "yuǎn"}, // 远
+    {0x8FDE, "lián"}, // 连
+    {0x8FDF, "chí"}, // 迟
+    {0x8FF7, "mí"}, // 迷
+    {0x8FFD, "zhuī"}, // 追
+    {0x9000, "tuì"}, // 退
+    {0x9001, "sòng"}, // 送
+    {0x9003, "táo"}, // 逃
+    {0x9006, "nì"}, // 逆
+    {0x9009, "xuǎn"}, // 选
+    {0x9019, "zhè"}, // 這
+    {0x901A, "tōng"}, // 通
+    {0x901F, "sù"}, // 速
+    {0x9020, "zào"}, // 造
+    {0x9022, "féng"}, // 逢
+    {0x9032, "jìn"}, // 進
+    {0x9047, "yù"}, // 遇
+    {0x904D, "biàn"}, // 遍
+    {0x904E, "guò"}, // 過
+    {0x9053, "dào"}, // 道
+    {0x9060, "yuǎn"}, // 遠
+    {0x9065, "yáo"}, // 遥
+    {0x907F, "bì"}, // 避
+    {0x9084, "hái"}, // 還
+    {0x908A, "biān"}, // 邊
+    {0x90A3, "nà"}, // 那
+    {0x90E8, "bù"}, // 部
+    {0x90FD, "dōu"}, // 都
+    {0x914D, "pèi"}, // 配
+    {0x9152, "jiǔ"}, // 酒
+    {0x9177, "kù"}, // 酷
+    {0x9189, "zuì"}, // 醉
+    {0x9192, "xǐng"}, // 醒
+    {0x91CC, "lǐ"}, // 里
+    {0x91CD, "zhòng"}, // 重
+    {0x91CE, "yě"}, // 野
+    {0x91CF, "liáng"}, // 量
+    {0x91D1, "jīn"}, // 金
+    {0x949F, "zhōng"}, // 钟
+    {0x94A2, "gāng"}, // 钢
+    {0x94B1, "qián"}, // 钱
+    {0x94C3, "líng"}, // 铃
+    {0x94F6, "yín"}, // 银
+    {0x9501, "suǒ"}, // 锁
+    {0x9519, "cuò"}, // 错
+    {0x955C, "jìng"}, // 镜
+    {0x9577, "cháng"}, // 長
+    {0x957F, "cháng"}, // 长
+    {0x9580, "mén"}, // 門
+    {0x958B, "kāi"}, // 開
+    {0x9593, "jiān"}, // 間
+    {0x95DC, "guān"}, // 關
+    {0x95E8, "mén"}, // 门
+    {0x95EA, "shǎn"}, // 闪
+    {0x95ED, "bì"}, // 闭
+    {0x95EE, "wèn"}, // 问
+    {0x95F2, "xián"}, // 闲
+    {0x95F4, "jiān"}, // 间
+    {0x95F9, "nào"}, // 闹
+    {0x95FB, "wén"}, // 闻
+    {0x961F, "duì"}, // 队
+    {0x9632, "fáng"}, // 防
+    {0x9633, "yáng"}, // 阳
+    {0x9634, "yīn"}, // 阴
+    {0x9635, "zhèn"}, // 阵
+    {0x963F, "ā"}, // 阿
+    {0x9644, "fù"}, // 附
+    {0x9645, "jì"}, // 际
+    {0x9662, "yuàn"}, // 院
+    {0x9664, "chú"}, // 除
+    {0x966A, "péi"}, // 陪
+    {0x968F, "suí"}, // 随
+    {0x9690, "yǐn"}, // 隐
+    {0x9694, "gé"}, // 隔
+    {0x96BE, "nán"}, // 难
+    {0x96C6, "jí"}, // 集
+    {0x96E8, "yǔ"}, // 雨
+    {0x96EA, "xué"}, // 雪
+    {0x96F6, "líng"}, // 零
+    {0x96FE, "wù"}, // 雾
+    {0x9700, "xū"}, // 需
+    {0x9732, "lù"}, // 露
+    {0x9759, "jìng"}, // 静
+    {0x975E, "fēi"}, // 非
+    {0x9760, "kào"}, // 靠
+    {0x9762, "miàn"}, // 面
+    {0x978B, "xié"}, // 鞋
+    {0x97F3, "yīn"}, // 音
+    {0x97FF, "xiǎng"}, // 響
+    {0x982D, "tóu"}, // 頭
+    {0x9876, "dǐng"}, // 顶
+    {0x987A, "shùn"}, // 顺
+    {0x987E, "gù"}, // 顾
+    {0x987F, "dùn"}, // 顿
+    {0x9884, "yù"}, // 预
+    {0x9886, "lǐng"}, // 领
+    {0x9898, "tí"}, // 题
+    {0x989C, "yán"}, // 颜
+    {0x989D, "é"}, // 额
+    {0x98A8, "fēng"}, // 風
+    {0x98CE, "fēng"}, // 风
+    {0x98D8, "piāo"}, // 飘
+    {0x98DE, "fēi"}, // 飞
+    {0x996D, "fàn"}, // 饭
+    {0x9971, "bǎo"}, // 饱
+    {0x997F, "è"}, // 饿
+    {0x9996, "shǒu"}, // 首
+    {0x9999, "xiāng"}, // 香
+    {0x9A6C, "mǎ"}, // 马
+    {0x9A84, "jiāo"}, // 骄
+    {0x9A91, "qí"}, // 骑
+    {0x9A97, "piàn"}, // 骗
+    {0x9AA8, "gǔ"}, // 骨
+    {0x9AD8, "gāo"}, // 高
+    {0x9B3C, "guǐ"}, // 鬼
+    {0x9B42, "hún"}, // 魂
+    {0x9B54, "mó"}, // 魔
+    {0x9C7C, "yú"}, // 鱼
+    {0x9E1F, "niǎo"}, // 鸟
+    {0x9E21, "jī"}, // 鸡
+    {0x9E45, "é"}, // 鹅
+    {0x9EA6, "mài"}, // 麦
+    {0x9EBB, "má"}, // 麻
+    {0x9EBC, "me"}, // 麼
+    {0x9EC4, "huáng"}, // 黄
+    {0x9ED1, "hēi"}, // 黑
+    {0x9ED8, "mò"}, // 默
+    {0x9EDE, "diǎn"}, // 點
+    {0x9F13, "gǔ"}, // 鼓
+    {0x9F3B, "bí"}, // 鼻
+    {0x9F7F, "chǐ"}, // 齿
+    {0x9F99, "lóng"}, // 龙
+};
+
+const size_t kPinyinTableSize = sizeof(kPinyinTable) / sizeof(kPinyinTable[0]);
@@ -0,0 +1,373 @@
+#include "tag_lyrics.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "text_encoding.h"
+
+namespace {
+
+// 标签再大也不超过这么多（带高清封面的 ID3 也远小于此）；超出按格式错误处理
+const size_t kMaxTagRegion = 64 << 20;
+// 映射按这个粒度扩大，减少 mremap 次数；没读到的页不会从磁盘读入
+const size_t kMapGranularity = 64 << 10;
+
+// 文件开头的一段只读映射，按需扩大。关闭预读（MADV_RANDOM），内核不会顺带读入后面的音频数据
+class TagMap {
+public:
+    TagMap(int fd, size_t file_size) : fd_(fd), file_size_(file_size) {}
+    TagMap(const TagMap &) = delete;
+    TagMap &operator=(const TagMap &) = delete;
+    ~TagMap() { if (addr_) munmap(addr_, mapped_); }
+
+    // 确保 [0, end) 已映射；超出文件或上限返回 false
+    bool ensure(size_t end) {
+        if (end <= mapped_) return true;
+        if (end > file_size_ || end > kMaxTagRegion) return false;
+        size_t length = std::min(file_size_, (end + kMapGranularity - 1) / kMapGranularity * kMapGranularity);
+        void *addr = addr_ ? mremap(addr_, mapped_, length, MREMAP_MAYMOVE) : mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (addr == MAP_FAILED) return false;
+        addr_ = addr;
+        mapped_ = length;
+        madvise(addr_, mapped_, MADV_RANDOM);
+        return true;
+    }
+    const unsigned char *at(size_t offset) const { return static_cast<const unsigned char *>(addr_) + offset; }
+    size_t file_size() const { return file_size_; }
+
+private:
+    int fd_;
+    size_t file_size_;
+    void *addr_ = nullptr;
+    size_t mapped_ = 0;
+};
+
+uint32_t be32(const unsigned char *p) { return static_cast<uint32_t>(p[0]) << 24 | p[1] << 16 | p[2] << 8 | p[3]; }
+uint32_t be24(const unsigned char *p) { return static_cast<uint32_t>(p[0]) << 16 | p[1] << 8 | p[2]; }
+uint32_t le32(const unsigned char *p) { return static_cast<uint32_t>(p[3]) << 24 | p[2] << 16 | p[1] << 8 | p[0]; }
+uint32_t synchsafe(const unsigned char *p) { return (p[0] & 0x7Fu) << 21 | (p[1] & 0x7Fu) << 14 | (p[2] & 0x7Fu) << 7 | (p[3] & 0x7Fu); }
+
+// --- ID3v2 ---
+
+// 反同步：去掉 0xFF 之后插入的 0x00
+std::string unsynchronise(const unsigned char *p, size_t n) {
+    std::string out;
+    out.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        out.push_back(static_cast<char>(p[i]));
+        if (p[i] == 0xFF && i + 1 < n && p[i + 1] == 0x00) ++i;
+    }
+    return out;
+}
+
+// 编码 0 ISO-8859-1，1 带 BOM 的 UTF-16，2 UTF-16BE，3 UTF-8；都转成 UTF-8
+std::string id3_text(int encoding, std::string_view raw) {
+    if (encoding == 0) {
+        std::string out;
+        out.reserve(raw.size());
+        for (unsigned char c : raw) {
+            if (c < 0x80) out.push_back(static_cast<char>(c));
+            else { out.push_back(static_cast<char>(0xC0 | c >> 6)); out.push_back(static_cast<char>(0x80 | (c & 0x3F))); }
+        }
+        return decode_lyric_text(out);
+    }
+    if (encoding == 2) return decode_lyric_text("\xFE\xFF" + std::string(raw));
+    return decode_lyric_text(raw);
+}
+
+// 按编码找字符串结束符（UTF-16 为对齐的两个 0），返回字符串，*pos 移到结束符之后；没有结束符时到末尾
+std::string_view id3_string(std::string_view data, int encoding, size_t *pos) {
+    size_t begin = *pos, end = begin;
+    if (encoding == 1 || encoding == 2) {
+        while (end + 1 < data.size() && (data[end] != 0 || data[end + 1] != 0)) end += 2;
+        *pos = std::min(data.size(), end + 2);
+        return data.substr(begin, std::min(end, data.size()) - begin);
+    }
+    while (end < data.size() && data[end] != 0) ++end;
+    *pos = std::min(data.size(), end + 1);
+    return data.substr(begin, end - begin);
+}
+
+// USLT：编码 | 语言(3) | 描述 | 文本
+std::string parse_uslt(std::string_view data) {
+    if (data.size() < 4) return std::string();
+    int encoding = static_cast<unsigned char>(data[0]);
+    size_t pos = 4;
+    id3_string(data, encoding, &pos);
+    return id3_text(encoding, data.substr(pos));
+}
+
+// SYLT：编码 | 语言(3) | 时间格式 | 内容类型 | 描述 | {文本 | 时间戳(BE32)}...
+// 只认毫秒时间戳（格式 2），MPEG 帧号要知道音频参数才能换算。
+// 逐字（卡拉 OK）同步的歌词用以换行开头的条目标出新行，其余条目接在当前行后；没有换行时每条就是一行
+std::vector<LyricLine> parse_sylt(std::string_view data) {
+    std::vector<LyricLine> lines;
+    if (data.size() < 6 || data[4] != 2) return lines;
+    int encoding = static_cast<unsigned char>(data[0]);
+    size_t pos = 6;
+    id3_string(data, encoding, &pos);
+    typedef struct { int64_t timestamp_us; std::string text; } entry_t;
+    std::vector<entry_t> entries;
+    bool has_breaks = false;
+    while (pos < data.size()) {
+        std::string text = id3_text(encoding, id3_string(data, encoding, &pos));
+        if (pos + 4 > data.size()) break;
+        int64_t timestamp_us = static_cast<int64_t>(be32(reinterpret_cast<const unsigned char *>(data.data()) + pos)) * 1000;
+        pos += 4;
+        if (!text.empty() && text[0] == '\n') has_breaks = true;
+        entries.push_back(entry_t{timestamp_us, std::move(text)});
+    }
+    for (entry_t &entry : entries) {
+        bool starts_line = !has_breaks || lines.empty() || (!entry.text.empty() && entry.text[0] == '\n');
+        size_t skip = !entry.text.empty() && entry.text[0] == '\n' ? 1 : 0;
+        if (starts_line) lines.push_back(LyricLine{entry.timestamp_us, entry.text.substr(skip)});
+        else lines.back().text += entry.text;
+    }
+    // 与 parse_lrc 一致：按时间排序，空行只用来结束上一行
+    std::stable_sort(lines.begin(), lines.end(), [](const LyricLine &a, const LyricLine &b) { return a.timestamp_us < b.timestamp_us; });
+    std::vector<LyricLine> timeline;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (lines[i].text.empty()) continue;
+        size_t next = i + 1;
+        while (next < lines.size() && lines[next].timestamp_us == lines[i].timestamp_us) ++next;
+        if (next < lines.size()) { lines[i].end_us = lines[next].timestamp_us; lines[i].gap_after = lines[next].text.empty(); }
+        timeline.push_back(std::move(lines[i]));
+    }
+    return timeline;
+}
+
+// 只读帧头，跳过封面等无关帧的数据；offset 是 ID3 头所在位置，*end 返回标签之后的位置
+bool read_id3v2(TagMap &map, size_t offset, provider_lyrics_t *lyrics, size_t *end) {
+    if (!map.ensure(offset + 10)) return false;
+    const unsigned char *header = map.at(offset);
+    int version = header[3], flags = header[5];
+    size_t size = synchsafe(header + 6);
+    *end = offset + 10 + size + ((flags & 0x10) ? 10 : 0);
+    if (version < 2 || version > 4 || !map.ensure(offset + 10 + size)) return false;
+
+    // 整个标签反同步（v2.2/2.3 的帧头也在反同步范围内）时先复制一份；v2.4 按帧处理
+    std::string unsynced;
+    std::string_view tag(reinterpret_cast<const char *>(map.at(offset + 10)), size);
+    if ((flags & 0x80) && version < 4) { unsynced = unsynchronise(map.at(offset + 10), size); tag = unsynced; }
+    size_t pos = 0;
+    if ((flags & 0x40) && version >= 3 && tag.size() >= 4) {
+        const unsigned char *ext = reinterpret_cast<const unsigned char *>(tag.data());
+        pos = version == 3 ? 4 + be32(ext) : synchsafe(ext);
+    }
+
+    size_t header_size = version == 2 ? 6 : 10;
+    std::string text;
+    while (pos + header_size <= tag.size() && tag[pos] != 0) {
+        const unsigned char *frame = reinterpret_cast<const unsigned char *>(tag.data()) + pos;
+        size_t frame_size = version == 2 ? be24(frame + 3) : version == 3 ? be32(frame + 4) : synchsafe(frame + 4);
+        int frame_flags = version == 2 ? 0 : frame[8] << 8 | frame[9];
+        if (frame_size > tag.size() - pos - header_size) break;
+        std::string_view id(reinterpret_cast<const char *>(frame), version == 2 ? 3 : 4);
+        bool is_sylt = id == "SYLT" || id == "SLT", is_uslt = id == "USLT" || id == "ULT";
+        // 压缩、加密的帧跳过
+        bool unsupported = version == 3 ? (frame_flags & 0x00C0) != 0 : version == 4 && (frame_flags & 0x000C) != 0;
+        if ((is_sylt || is_uslt) && !unsupported) {
+            std::string_view data = tag.substr(pos + header_size, frame_size);
+            std::string frame_unsynced;
+            if (version == 4 && (frame_flags & 0x0001) && data.size() >= 4) data.remove_prefix(4);
+            if (version == 4 && ((frame_flags & 0x0002) || (flags & 0x80))) {
+                frame_unsynced = unsynchronise(reinterpret_cast<const unsigned char *>(data.data()), data.size());
+                data = frame_unsynced;
+            }
+            if (is_sylt) {
+                std::vector<LyricLine> timeline = parse_sylt(data);
+                if (!timeline.empty()) { lyrics->timeline = std::move(timeline); return true; }
+            } else if (text.empty()) {
+                text = parse_uslt(data);
+            }
+        }
+        pos += header_size + frame_size;
+    }
+    if (text.empty()) return false;
+    lyrics->text = std::move(text);
+    return true;
+}
+
+// --- Vorbis 注释（FLAC 元数据块和 Ogg 注释包共用）---
+
+// 若干段不连续的文件区域（Ogg 的一个包跨多页）顺序读取；跳过时不碰数据所在的页
+class SpanReader {
+public:
+    SpanReader(const TagMap &map, std::vector<std::pair<size_t, size_t>> spans) : map_(map), spans_(std::move(spans)) {}
+    bool read(std::string *out, size_t n) {
+        while (n > 0) {
+            if (span_ >= spans_.size()) return false;
+            size_t take = std::min(n, spans_[span_].second - offset_);
+            out->append(reinterpret_cast<const char *>(map_.at(spans_[span_].first + offset_)), take);
+            advance(take);
+            n -= take;
+        }
+        return true;
+    }
+    bool skip(size_t n) {
+        while (n > 0) {
+            if (span_ >= spans_.size()) return false;
+            size_t take = std::min(n, spans_[span_].second - offset_);
+            advance(take);
+            n -= take;
+        }
+        return true;
+    }
+    bool read_le32(uint32_t *value) {
+        std::string bytes;
+        if (!read(&bytes, 4)) return false;
+        *value = le32(reinterpret_cast<const unsigned char *>(bytes.data()));
+        return true;
+    }
+
+private:
+    void advance(size_t n) {
+        offset_ += n;
+        while (span_ < spans_.size() && offset_ == spans_[span_].second) { span_++; offset_ = 0; }
+    }
+
+    const TagMap &map_;
+    std::vector<std::pair<size_t, size_t>> spans_;
+    size_t span_ = 0, offset_ = 0;
+};
+
+// 厂商串 | 条目数 | {长度 | KEY=value}...；只读每个条目的开头判断键名，封面（METADATA_BLOCK_PICTURE）等整段跳过
+bool read_vorbis_comment(SpanReader &reader, provider_lyrics_t *lyrics) {
+    static const char *const kKeys[] = {"LYRICS=", "UNSYNCEDLYRICS="};
+    uint32_t length, count;
+    if (!reader.read_le32(&length) || !reader.skip(length) || !reader.read_le32(&count)) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!reader.read_le32(&length)) return false;
+        std::string head;
+        size_t peek = std::min<size_t>(length, 16);
+        if (!reader.read(&head, peek)) return false;
+        const char *matched = nullptr;
+        for (const char *key : kKeys) if (head.size() >= strlen(key) && strncasecmp(head.c_str(), key, strlen(key)) == 0) matched = key;
+        if (!matched) { if (!reader.skip(length - peek)) return false; continue; }
+        std::string value = head.substr(strlen(matched));
+        if (!reader.read(&value, length - peek)) return false;
+        lyrics->text = decode_lyric_text(value);
+        if (!lyrics->text.empty()) return true;
+    }
+    return false;
+}
+
+// FLAC：每块 1 字节（最高位为最后一块，低 7 位类型）+ 24 位长度；类型 4 为 VORBIS_COMMENT
+bool read_flac(TagMap &map, size_t offset, provider_lyrics_t *lyrics) {
+    offset += 4;
+    for (;;) {
+        if (!map.ensure(offset + 4)) return false;
+        const unsigned char *block = map.at(offset);
+        bool last = (block[0] & 0x80) != 0;
+        size_t length = be24(block + 1);
+        if ((block[0] & 0x7F) == 4) {
+            if (!map.ensure(offset + 4 + length)) return false;
+            SpanReader reader(map, {{offset + 4, length}});
+            return read_vorbis_comment(reader, lyrics);
+        }
+        if (last) return false;
+        offset += 4 + length;
+    }
+}
+
+// Ogg：逐页读页头和分段表，把第一个逻辑流的第二个包（Vorbis/Opus 注释）的各段收集起来，包结束即停止扫描
+bool read_ogg(TagMap &map, provider_lyrics_t *lyrics) {
+    std::vector<std::pair<size_t, size_t>> spans;
+    size_t offset = 0;
+    int packet = 0;
+    uint32_t serial = 0;
+    bool first_page = true;
+    while (packet < 2) {
+        if (!map.ensure(offset + 27)) return false;
+        const unsigned char *page = map.at(offset);
+        if (std::memcmp(page, "OggS", 4) != 0 || page[4] != 0) return false;
+        size_t segments = page[26];
+        if (!map.ensure(offset + 27 + segments)) return false;
+        page = map.at(offset);
+        size_t data = offset + 27 + segments, page_size = 0;
+        for (size_t i = 0; i < segments; ++i) page_size += page[27 + i];
+        uint32_t page_serial = le32(page + 14);
+        if (first_page) { serial = page_serial; first_page = false; }
+        if (page_serial == serial) {
+            for (size_t i = 0; i < segments && packet < 2; ++i) {
+                size_t length = page[27 + i];
+                if (packet == 1 && length > 0) {
+                    if (!spans.empty() && spans.back().first + spans.back().second == data) spans.back().second += length;
+                    else spans.push_back({data, length});
+                }
+                data += length;
+                if (length < 255) packet++;
+            }
+        }
+        offset += 27 + segments + page_size;
+    }
+    size_t total = 0;
+    for (const std::pair<size_t, size_t> &span : spans) total += span.second;
+    if (!spans.empty() && !map.ensure(spans.back().first + spans.back().second)) return false;
+    SpanReader reader(map, std::move(spans));
+    std::string magic;
+    if (total < 8 || !reader.read(&magic, 7)) return false;
+    if (magic == "\x03vorbis") return read_vorbis_comment(reader, lyrics);
+    if (magic == "OpusTag" && reader.read(&magic, 1) && magic == "OpusTags") return read_vorbis_comment(reader, lyrics);
+    return false;
+}
+
+}  // namespace
+
+std::string path_from_file_url(std::string_view url) {
+    if (!url.empty() && url[0] == '/') return std::string(url);
+    static const char kScheme[] = "file://";
+    if (url.compare(0, sizeof(kScheme) - 1, kScheme) != 0) return std::string();
+    url.remove_prefix(sizeof(kScheme) - 1);
+    if (url.compare(0, 9, "localhost") == 0) url.remove_prefix(9);
+    if (url.empty() || url[0] != '/') return std::string();
+    std::string path;
+    path.reserve(url.size());
+    for (size_t i = 0; i < url.size(); ++i) {
+        auto hex = [](char c) { return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1; };
+        if (url[i] == '%' && i + 2 < url.size() && hex(url[i + 1]) >= 0 && hex(url[i + 2]) >= 0) {
+            path.push_back(static_cast<char>(hex(url[i + 1]) << 4 | hex(url[i + 2])));
+            i += 2;
+        } else {
+            path.push_back(url[i]);
+        }
+    }
+    return path;
+}
+
+bool read_embedded_lyrics(const std::string &path, provider_lyrics_t *lyrics) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    bool found = false;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        TagMap map(fd, static_cast<size_t>(st.st_size));
+        size_t offset = 0;
+        if (map.ensure(4) && std::memcmp(map.at(0), "ID3", 3) == 0) {
+            found = read_id3v2(map, 0, lyrics, &offset);
+        }
+        // FLAC 前面偶尔也有 ID3v2
+        if (!found && map.ensure(offset + 4) && std::memcmp(map.at(offset), "fLaC", 4) == 0) found = read_flac(map, offset, lyrics);
+        else if (!found && offset == 0 && map.ensure(4) && std::memcmp(map.at(0), "OggS", 4) == 0) found = read_ogg(map, lyrics);
+    }
+    close(fd);
+    return found;
+}
+
+LyricProvider tag_lyric_provider(int64_t deadline_us) {
+    LyricProvider provider;
+    provider.name = "tags";
+    provider.deadline_us = deadline_us;
+    provider.fetch = [](const lyric_query_t &query, const std::atomic<bool> &) {
+        provider_lyrics_t lyrics;
+        std::string path = path_from_file_url(query.url);
+        if (!path.empty() && !read_embedded_lyrics(path, &lyrics)) lyrics = provider_lyrics_t();
+        return lyrics;
+    };
+    return provider;
+}
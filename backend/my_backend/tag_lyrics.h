@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "lyric_providers.h"
+
+// 音频文件内嵌歌词（musicfox 播放本地文件时 xesam:url 是文件地址）。
+// 只 mmap 文件开头的标签区域，按需扩大映射，只有读到的页才从磁盘读入，不读音频数据：
+//   ID3v2（文件开头）  SYLT 同步歌词（毫秒时间戳）直接转成时间轴；USLT 文本交给引擎按 LRC 解析
+//   FLAC             逐个元数据块只读块头，跳过封面等大块，VORBIS_COMMENT 里的 LYRICS / UNSYNCEDLYRICS
+//   Ogg Vorbis/Opus  按页扫描到注释包结束为止，同样取 LYRICS / UNSYNCEDLYRICS
+// SYLT 优先于文本歌词；都没有时返回 false
+
+// file:///path（主机名为空或 localhost，百分号解码）或绝对路径转成本地路径，其他地址返回空
+std::string path_from_file_url(std::string_view url);
+
+bool read_embedded_lyrics(const std::string &path, provider_lyrics_t *lyrics);
+
+// 读内嵌歌词的来源，名为 "tags"
+LyricProvider tag_lyric_provider(int64_t deadline_us);
@@ -0,0 +1,52 @@
+#include "test_main.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "audio_latency.h"
+
+class FakeProbe : public SinkProbe {
+public:
+    std::vector<std::pair<std::string, int64_t>> samples;
+    size_t next = 0;
+    bool probe(std::string &sink, int64_t &latency_us) override {
+        if (next >= samples.size()) return false;
+        sink = samples[next].first; latency_us = samples[next].second; next++;
+        return true;
+    }
+};
+
+int main() {
+    LatencyTable table;
+    table.set_global_offset_us(-20000);
+    table.set_sink_offset_us("bluez_output.00_11_22_33_44_55.1", 180000);
+    CHECK_EQ(table.offset_for("bluez_output.00_11_22_33_44_55.1"), 160000);
+    CHECK_EQ(table.offset_for("alsa_output.pci"), -20000);
+
+    char path[] = "/tmp/latency_test_XXXXXX";
+    int fd = mkstemp(path);
+    CHECK(fd >= 0);
+    close(fd);
+    CHECK(table.save(path));
+    LatencyTable loaded;
+    CHECK(loaded.load(path));
+    CHECK_EQ(loaded.global_offset_us(), -20000);
+    CHECK_EQ(loaded.sink_count(), 1u);
+    CHECK_EQ(loaded.offset_for("bluez_output.00_11_22_33_44_55.1"), 160000);
+    unlink(path);
+    CHECK(!loaded.load("/nonexistent/latency.conf"));
+
+    // 中位数抗抖动；采样途中换设备以最后的设备为准
+    FakeProbe probe;
+    probe.samples = { {"alsa", 20000}, {"bt", 210000}, {"bt", 190000}, {"bt", 900000}, {"bt", 200000} };
+    std::string sink; int64_t latency_us = 0;
+    CHECK(calibrate_sink_latency(probe, table, 5, &sink, &latency_us));
+    CHECK_EQ(sink, std::string("bt"));
+    CHECK_EQ(latency_us, 210000);
+    CHECK_EQ(table.offset_for("bt"), 190000);
+    FakeProbe empty;
+    CHECK(!calibrate_sink_latency(empty, table, 3));
+    return g_failures;
+}
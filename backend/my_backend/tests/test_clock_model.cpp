@@ -0,0 +1,17 @@
+#include "test_main.h"
+
+#include "clock_model.h"
+
+int main() {
+    clock_model_t clock = {};
+    clock_sync(clock, 5000000, 1000000);
+    CHECK_EQ(clock_predict_us(clock, true, 1000000), 5000000);
+    CHECK_EQ(clock_predict_us(clock, true, 1250000), 5250000);
+    // 暂停时停在锚点
+    CHECK_EQ(clock_predict_us(clock, false, 9000000), 5000000);
+    clock_sync(clock, 0, 2000000);
+    CHECK_EQ(clock_predict_us(clock, true, 2100000), 100000);
+    int64_t a = clock_now_us(), b = clock_now_us();
+    CHECK(b >= a);
+    return g_failures;
+}
@@ -0,0 +1,93 @@
+#include "test_main.h"
+
+#include <vector>
+
+#include "clock_model.h"
+#include "deadline_source.h"
+
+typedef struct {
+    std::vector<int64_t> fired_us;
+} fire_log_t;
+
+static gboolean on_deadline(gpointer data) {
+    static_cast<fire_log_t*>(data)->fired_us.push_back(clock_now_us());
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean on_guard(gpointer data) {
+    *static_cast<bool*>(data) = true;
+    return G_SOURCE_REMOVE;
+}
+
+// 在独立的 GMainContext 上跑 run_ms 毫秒：期间触发几次都记下来，用来确认只触发一次
+static void run_for(GMainContext *context, int run_ms) {
+    bool done = false;
+    GSource *guard = g_timeout_source_new(run_ms);
+    g_source_set_callback(guard, on_guard, &done, nullptr);
+    g_source_attach(guard, context);
+    while (!done) g_main_context_iteration(context, TRUE);
+    g_source_destroy(guard);
+    g_source_unref(guard);
+}
+
+static void test_fires_once_not_early() {
+    GMainContext *context = g_main_context_new();
+    fire_log_t log;
+    GSource *source = deadline_source_new(on_deadline, &log);
+    g_source_attach(source, context);
+    int64_t target_us = clock_now_us() + 5000;
+    deadline_source_set(source, target_us, 0);
+    CHECK_EQ(deadline_source_target(source), target_us);
+    run_for(context, 60);
+    CHECK_EQ(log.fired_us.size(), static_cast<size_t>(1));
+    if (!log.fired_us.empty()) CHECK(log.fired_us[0] >= target_us);
+    g_source_destroy(source);
+    g_source_unref(source);
+    g_main_context_unref(context);
+}
+
+// 余量大于 1ms 时触发时刻向上对齐到余量的整数倍；目标时刻本身不变，仍用于统计延迟
+static void test_slack_rounds_up() {
+    GMainContext *context = g_main_context_new();
+    fire_log_t log;
+    GSource *source = deadline_source_new(on_deadline, &log);
+    g_source_attach(source, context);
+    const int64_t slack_us = 50000;
+    // 目标落在某个 50ms 整数倍之后 1ms，对齐后要晚 49ms
+    int64_t target_us = (clock_now_us() / slack_us + 1) * slack_us + 1000;
+    int64_t aligned_us = target_us - 1000 + slack_us;
+    deadline_source_set(source, target_us, slack_us);
+    CHECK_EQ(deadline_source_target(source), target_us);
+    run_for(context, 250);
+    CHECK_EQ(log.fired_us.size(), static_cast<size_t>(1));
+    if (!log.fired_us.empty()) CHECK(log.fired_us[0] >= aligned_us);
+    g_source_destroy(source);
+    g_source_unref(source);
+    g_main_context_unref(context);
+}
+
+static void test_clear_disarms() {
+    GMainContext *context = g_main_context_new();
+    fire_log_t log;
+    GSource *source = deadline_source_new(on_deadline, &log);
+    g_source_attach(source, context);
+    deadline_source_set(source, clock_now_us() + 5000, 0);
+    deadline_source_clear(source);
+    CHECK_EQ(deadline_source_target(source), static_cast<int64_t>(0));
+    run_for(context, 40);
+    CHECK(log.fired_us.empty());
+    // 清除后还能重新设定
+    deadline_source_set(source, clock_now_us() + 5000, 0);
+    run_for(context, 40);
+    CHECK_EQ(log.fired_us.size(), static_cast<size_t>(1));
+    g_source_destroy(source);
+    g_source_unref(source);
+    g_main_context_unref(context);
+}
+
+int main() {
+    test_fires_once_not_early();
+    test_slack_rounds_up();
+    test_clear_disarms();
+    return g_failures;
+}
@@ -0,0 +1,176 @@
+#include "test_main.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <functional>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "lrc_index.h"
+
+static std::string g_dir;
+
+static void write_file(const std::string &path, const std::string &content) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (write(fd, content.data(), content.size()) != static_cast<ssize_t>(content.size())) CHECK(false);
+    close(fd);
+}
+
+// 索引在后台线程上更新，轮询到条件成立或超时
+static bool wait_until(const std::function<bool()> &cond) {
+    for (int i = 0; i < 500; ++i) {
+        if (cond()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return cond();
+}
+
+static void test_normalize() {
+    CHECK_EQ(LrcIndex::normalize("Jay Chou"), std::string("jaychou"));
+    CHECK_EQ(LrcIndex::normalize("晴天 (Live)"), std::string("晴天"));
+    CHECK_EQ(LrcIndex::normalize("Don't Stop [Remastered 2011]!"), std::string("dontstop"));
+    CHECK_EQ(LrcIndex::normalize("  A-B_C  "), std::string("abc"));
+    CHECK_EQ(LrcIndex::normalize(""), std::string());
+}
+
+static void test_lookup() {
+    std::string root = g_dir + "/lookup";
+    mkdir(root.c_str(), 0755);
+    mkdir((root + "/sub").c_str(), 0755);
+    // 标签优先，没有标签时按文件名 "歌手 - 标题"
+    write_file(root + "/a.lrc", "[ar:周杰伦]\n[ti:晴天]\n[00:01.00]故事的小黄花\n");
+    write_file(root + "/sub/Carpenters - Yesterday Once More.lrc", "[00:01.00]When I was young\n");
+    write_file(root + "/sub/notes.txt", "[ti:不是歌词]\n");
+    LrcIndex index(root, "");
+    index.start();
+    CHECK(wait_until([&] { return index.size() == 2; }));
+    CHECK_EQ(index.find("周杰伦", "晴天"), root + "/a.lrc");
+    CHECK_EQ(index.find("周杰伦", "晴天 (Live)"), root + "/a.lrc");
+    CHECK_EQ(index.find("carpenters", "YESTERDAY ONCE MORE"), root + "/sub/Carpenters - Yesterday Once More.lrc");
+    // 三元组模糊匹配：少一个字母仍命中，不相干的不命中
+    CHECK_EQ(index.find("Carpenters", "Yesterday Once Mor"), root + "/sub/Carpenters - Yesterday Once More.lrc");
+    CHECK(index.find("Carpenters", "Top of the World").empty());
+    CHECK(index.find("", "不是歌词").empty());
+    index.stop();
+}
+
+// 两个文件规范化后同键：删掉精确匹配指向的那个，另一个仍是精确匹配（而不是退回模糊匹配）
+static void test_duplicate_key() {
+    std::string root = g_dir + "/duplicate";
+    mkdir(root.c_str(), 0755);
+    write_file(root + "/周杰伦 - 晴天.lrc", "[00:01.00]故事的小黄花\n");
+    write_file(root + "/qingtian.lrc", "[ar:周杰伦]\n[ti:晴天 (Live)]\n");
+    LrcIndex index(root, "");
+    index.start();
+    CHECK(wait_until([&] { return index.size() == 2; }));
+    bool exact = false;
+    std::string first = index.find("周杰伦", "晴天", &exact);
+    CHECK(exact);
+    std::string second = first == root + "/qingtian.lrc" ? root + "/周杰伦 - 晴天.lrc" : root + "/qingtian.lrc";
+    unlink(first.c_str());
+    CHECK(wait_until([&] { return index.size() == 1; }));
+    CHECK_EQ(index.find("周杰伦", "晴天", &exact), second);
+    CHECK(exact);
+    unlink(second.c_str());
+    CHECK(wait_until([&] { return index.size() == 0; }));
+    CHECK(index.find("周杰伦", "晴天", &exact).empty());
+    CHECK(!exact);
+    index.stop();
+}
+
+// 缓存往返：mtime 和 size 没变的文件不重新读取，变了的重新读取，消失的删除
+static void test_cache_rescan() {
+    std::string root = g_dir + "/cache", cache = g_dir + "/cache.idx";
+    mkdir(root.c_str(), 0755);
+    write_file(root + "/same.lrc", "[ar:A]\n[ti:Old]\n");
+    write_file(root + "/grow.lrc", "[ar:B]\n[ti:Old]\n");
+    write_file(root + "/gone.lrc", "[ar:C]\n[ti:Gone]\n");
+    {
+        LrcIndex index(root, cache);
+        index.start();
+        CHECK(wait_until([&] { return index.size() == 3; }));
+        index.stop();
+    }
+    struct stat st;
+    CHECK_EQ(stat(cache.c_str(), &st), 0);
+
+    // 内容改了但长度和 mtime 不变：按缓存里的旧标签
+    struct stat same;
+    stat((root + "/same.lrc").c_str(), &same);
+    write_file(root + "/same.lrc", "[ar:A]\n[ti:New]\n");
+    struct timespec times[2] = {same.st_atim, same.st_mtim};
+    utimensat(AT_FDCWD, (root + "/same.lrc").c_str(), times, 0);
+    write_file(root + "/grow.lrc", "[ar:B]\n[ti:Longer]\n");
+    unlink((root + "/gone.lrc").c_str());
+
+    LrcIndex index(root, cache);
+    index.start();
+    // 消失的文件在整棵树扫完之后才删除
+    CHECK(wait_until([&] { return index.size() == 2; }));
+    CHECK_EQ(index.find("A", "Old"), root + "/same.lrc");
+    CHECK_EQ(index.find("B", "Longer"), root + "/grow.lrc");
+    CHECK(index.find("C", "Gone").empty());
+    index.stop();
+}
+
+static void test_inotify() {
+    std::string root = g_dir + "/watch";
+    mkdir(root.c_str(), 0755);
+    write_file(root + "/first.lrc", "[ar:A]\n[ti:First]\n");
+    LrcIndex index(root, "");
+    index.start();
+    CHECK(wait_until([&] { return index.size() == 1; }));
+
+    write_file(root + "/歌手 - 新歌.lrc", "[00:01.00]新歌\n");
+    CHECK(wait_until([&] { return index.find("歌手", "新歌") == root + "/歌手 - 新歌.lrc"; }));
+    // 新建的子目录也被监听
+    mkdir((root + "/album").c_str(), 0755);
+    write_file(root + "/album/x.lrc", "[ar:X]\n[ti:Deep Track]\n");
+    CHECK(wait_until([&] { return index.find("X", "Deep Track") == root + "/album/x.lrc"; }));
+    CHECK(wait_until([&] { return index.size() == 3; }));
+
+    // 改名：旧路径删除，新路径加入
+    rename((root + "/first.lrc").c_str(), (root + "/renamed.lrc").c_str());
+    CHECK(wait_until([&] { return index.find("A", "First") == root + "/renamed.lrc"; }));
+    unlink((root + "/album/x.lrc").c_str());
+    rmdir((root + "/album").c_str());
+    CHECK(wait_until([&] { return index.size() == 2; }));
+    CHECK(index.find("X", "Deep Track").empty());
+
+    // 子目录移出根目录：条目删除，移走的目录不再监听。否则在原位置新建同名目录后，
+    // 移走目录里的删除事件会按旧路径报上来，误删新目录里的同名文件
+    mkdir((root + "/moving").c_str(), 0755);
+    mkdir((root + "/moving/inner").c_str(), 0755);
+    write_file(root + "/moving/inner/m.lrc", "[ar:M]\n[ti:Moved]\n");
+    CHECK(wait_until([&] { return index.size() == 3; }));
+    std::string outside = g_dir + "/moved_out";
+    rename((root + "/moving").c_str(), outside.c_str());
+    CHECK(wait_until([&] { return index.size() == 2; }));
+    CHECK(index.find("M", "Moved").empty());
+    write_file(outside + "/late.lrc", "[ar:L]\n[ti:Late]\n");
+    mkdir((root + "/moving").c_str(), 0755);
+    write_file(root + "/moving/late.lrc", "[ar:N]\n[ti:Replacement]\n");
+    CHECK(wait_until([&] { return index.find("N", "Replacement") == root + "/moving/late.lrc"; }));
+    unlink((outside + "/late.lrc").c_str());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    CHECK_EQ(index.find("N", "Replacement"), root + "/moving/late.lrc");
+    CHECK_EQ(index.size(), static_cast<size_t>(3));
+    index.stop();
+}
+
+int main() {
+    char dir[] = "/tmp/test_lrc_index.XXXXXX";
+    if (!mkdtemp(dir)) return 1;
+    g_dir = dir;
+    test_normalize();
+    test_lookup();
+    test_duplicate_key();
+    test_cache_rescan();
+    test_inotify();
+    std::string cleanup = "rm -rf '" + g_dir + "'";
+    if (system(cleanup.c_str()) != 0) return 1;
+    return g_failures;
+}
@@ -0,0 +1,67 @@
+#include "test_main.h"
+
+#include <cstdio>
+#include <string>
+
+#include "lrc_timestamp.h"
+#include "lyric_timeline.h"
+
+// --- 编译期验证：以下断言不成立时测试本身编译不过 ---
+static_assert(lrc_decode_digits<2>("07") == 7, "");
+static_assert(lrc_decode_digits<3>("120") == 120, "");
+static_assert(lrc_decode_digits<2>("0a") == -1, "");
+static_assert(lrc_decode_digits<2>("/0") == -1, "");
+static_assert(lrc_decode_digits<2>(":0") == -1, "");
+
+static_assert(lrc_decode_timestamp<2, 2>("00:00.00]") == 0, "");
+static_assert(lrc_decode_timestamp<2, 2>("01:02.03]") == 62030000, "");
+static_assert(lrc_decode_timestamp<2, 2>("99:59.99]") == (99 * 60 + 59) * 1000000LL + 990000, "");
+static_assert(lrc_decode_timestamp<2, 3>("00:01.234]") == 1234000, "");
+static_assert(lrc_decode_timestamp<2, 3>("10:00.001]") == 600001000, "");
+static_assert(lrc_decode_timestamp<3, 0>("123:45]") == (123 * 60 + 45) * 1000000LL, "");
+// 分隔符、位数或结尾不符
+static_assert(lrc_decode_timestamp<2, 2>("01-02.03]") == -1, "");
+static_assert(lrc_decode_timestamp<2, 2>("01:02:03]") == -1, "");
+static_assert(lrc_decode_timestamp<2, 2>("01:02.03)") == -1, "");
+static_assert(lrc_decode_timestamp<2, 2>("01:0x.03]") == -1, "");
+static_assert(lrc_decode_timestamp<2, 3>("00:01.23]x") == -1, "");
+static_assert(lrc_decode_timestamp<3, 0>("12:345]") == -1, "");
+static_assert(lrc_decode_timestamp<3, 0>("ti:abc]") == -1, "");
+
+// SWAR 路径要与通用解码逐字节一致：穷举所有两位数组合，再在每个位置上放各种非数字字节
+static void test_swar_matches_generic() {
+    char buf[16];
+    for (int m = 0; m < 100; m += 7) for (int s = 0; s < 100; ++s) for (int c = 0; c < 100; c += 3) {
+        snprintf(buf, sizeof(buf), "%02d:%02d.%02d", m, s, c);
+        CHECK_EQ(lrc_decode_timestamp_swar(buf), (m * 60 + s) * 1000000LL + c * 10000LL);
+    }
+    const unsigned char bad[] = { 0x00, '/', ':', '.', 'A', 0x7F, 0x80, 0xC0, 0xF9, 0xFA, 0xFF };
+    for (int pos = 0; pos < 8; ++pos) for (unsigned char b : bad) {
+        char probe[10] = "12:34.56]";
+        probe[pos] = static_cast<char>(b);
+        CHECK_EQ(lrc_decode_timestamp_swar(probe), (lrc_decode_timestamp<2, 2>(probe)));
+    }
+}
+
+static void test_line_timestamp() {
+    size_t text_begin = 0;
+    CHECK_EQ(lrc_parse_line_timestamp("[01:02.03]歌词", 16, &text_begin), 62030000);
+    CHECK_EQ(text_begin, 10u);
+    CHECK_EQ(lrc_parse_line_timestamp("[01:02.003]x", 12, &text_begin), 62003000);
+    CHECK_EQ(text_begin, 11u);
+    CHECK_EQ(lrc_parse_line_timestamp("[123:04]x", 9, &text_begin), 7384000000LL);
+    CHECK_EQ(text_begin, 8u);
+    CHECK_EQ(lrc_parse_line_timestamp("[ti:晴天]", 11, &text_begin), -1);
+    CHECK_EQ(lrc_parse_line_timestamp("[01:02.03", 9, &text_begin), -1);
+    CHECK_EQ(lrc_parse_line_timestamp("[offset:0]", 10, &text_begin), -1);
+    // 解析器整体：三种形状混排
+    std::vector<LyricLine> lines = parse_lrc("[100:00]尾声\n[00:01.5]不支持\n[00:02.000]二\n[00:01.00]一\n");
+    CHECK_EQ(lines.size(), 3u);
+    if (lines.size() == 3) { CHECK_EQ(lines[0].text, std::string("一")); CHECK_EQ(lines[1].timestamp_us, 2000000); CHECK_EQ(lines[2].timestamp_us, 6000000000LL); }
+}
+
+int main() {
+    test_swar_matches_generic();
+    test_line_timestamp();
+    return g_failures;
+}
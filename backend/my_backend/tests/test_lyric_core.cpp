@@ -0,0 +1,93 @@
+#include "test_main.h"
+
+#include <string>
+
+#include "lyric_timeline.h"
+#include "romanization.h"
+
+static void test_parse_lrc() {
+    std::vector<LyricLine> lines = parse_lrc("[ti:晴天]\n[00:12.50]第二行\n[00:01.234]  第一行  \n[00:20.00]\n[01:02.03]第三行\nnot a lyric\n");
+    CHECK_EQ(lines.size(), 3u);
+    if (lines.size() != 3) return;
+    CHECK_EQ(lines[0].timestamp_us, 1234000);
+    CHECK_EQ(lines[0].text, std::string("第一行"));
+    CHECK_EQ(lines[1].timestamp_us, 12500000);
+    CHECK_EQ(lines[2].timestamp_us, 62030000);
+    CHECK(parse_lrc("").empty());
+}
+
+static void test_line_end_and_gap() {
+    // 第二行后面是间奏（空行），最后一行结束时间未知
+    std::vector<LyricLine> lines = parse_lrc("[00:01.00]a\n[00:03.00]b\n[00:05.00]\n[00:20.00]c\n");
+    CHECK_EQ(lines.size(), 3u);
+    if (lines.size() != 3) return;
+    CHECK_EQ(lines[0].end_us, 3000000);
+    CHECK(!lines[0].gap_after);
+    CHECK_EQ(lines[1].end_us, 5000000);
+    CHECK(lines[1].gap_after);
+    CHECK_EQ(lines[2].end_us, -1);
+    // 相同时间戳的行不互相结束
+    lines = parse_lrc("[00:01.00]a\n[00:01.00]b\n[00:02.00]c\n");
+    CHECK_EQ(lines.size(), 3u);
+    if (lines.size() == 3) { CHECK_EQ(lines[0].end_us, 2000000); CHECK_EQ(lines[1].end_us, 2000000); }
+}
+
+static bool same_timeline(const std::vector<LyricLine> &a, const std::vector<LyricLine> &b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].timestamp_us != b[i].timestamp_us || a[i].text != b[i].text || a[i].end_us != b[i].end_us || a[i].gap_after != b[i].gap_after) return false;
+    }
+    return true;
+}
+
+static void test_lrc_stream() {
+    // 乱序、间奏空行、同一时间戳的多行：在任意字节处截断后逐步追加，结果都应与整份解析相同
+    const std::string full = "[00:05.00]二\n[00:01.00]一\n[00:09.00]\n[00:05.00]二b\n[00:12.00]三\n[00:03.00]插入";
+    for (size_t cut = 0; cut <= full.size(); ++cut) {
+        lrc_stream_t stream = {};
+        CHECK(lrc_stream_append(stream, full.substr(0, cut)));
+        CHECK(same_timeline(lrc_stream_timeline(stream), parse_lrc(full.substr(0, cut))));
+        CHECK(lrc_stream_append(stream, full));
+        CHECK(same_timeline(lrc_stream_timeline(stream), parse_lrc(full)));
+    }
+    // 不是延续时不改动
+    lrc_stream_t stream = {};
+    lrc_stream_reset(stream, "[00:01.00]a\n");
+    CHECK(!lrc_stream_append(stream, "[00:02.00]b\n"));
+    CHECK_EQ(stream.text, std::string("[00:01.00]a\n"));
+    CHECK_EQ(lrc_stream_timeline(stream).size(), 1u);
+}
+
+static void test_timeline_index_at() {
+    std::vector<LyricLine> lines = parse_lrc("[00:01.00]a\n[00:02.00]b\n[00:03.00]c\n");
+    CHECK_EQ(timeline_index_at(lines, 0), -1);
+    CHECK_EQ(timeline_index_at(lines, 1000000), 0);
+    CHECK_EQ(timeline_index_at(lines, 2500000), 1);
+    CHECK_EQ(timeline_index_at(lines, 99000000), 2);
+    CHECK_EQ(timeline_index_at({}, 1000000), -1);
+}
+
+static void test_romanize_line() {
+    CHECK_EQ(romanize_line("hello"), std::string());
+    // 中文：每个汉字一个带声调的音节，以空格分隔；其他字符原样保留
+    CHECK_EQ(romanize_line("晴天"), std::string("qíng tiān"));
+    CHECK_EQ(romanize_line("故事的小黄花"), std::string("gù shì de xiǎo huáng huā"));
+    CHECK_EQ(romanize_line("晴天 hello"), std::string("qíng tiān hello"));
+    // 纯假名：连写不加空格；拗音、促音、长音按平文式
+    CHECK_EQ(romanize_line("きみがいない"), std::string("kimigainai"));
+    CHECK_EQ(romanize_line("カタカナ"), std::string("katakana"));
+    CHECK_EQ(romanize_line("ちょっと"), std::string("chotto"));
+    CHECK_EQ(romanize_line("がっこう"), std::string("gakkou"));
+    // 汉字与假名混排：汉字原样保留，每个汉字和每段假名各为一个词，以空格分隔
+    CHECK_EQ(romanize_line("君の名は"), std::string("君 no 名 ha"));
+    CHECK_EQ(romanize_line("東京タワー"), std::string("東 京 tawaa"));
+}
+
+int main() {
+    test_parse_lrc();
+    test_line_end_and_gap();
+    test_lrc_stream();
+    test_timeline_index_at();
+    test_romanize_line();
+    return g_failures;
+}
@@ -0,0 +1,485 @@
+#include "test_main.h"
+
+#include <string>
+#include <vector>
+
+#include "lyric_engine.h"
+
+static const char *kLyrics = "[00:01.00]第一行\n[00:05.00]第二行\n[00:09.00]第三行\n";
+
+struct Harness {
+    ManualClock clock{1000000};
+    std::vector<EngineState> emitted;
+    std::vector<uint64_t> position_requests;
+    std::vector<uint64_t> timelines;
+    LyricEngine engine;
+
+    Harness() : engine(clock, callbacks()) {}
+    EngineCallbacks callbacks() {
+        EngineCallbacks cb;
+        cb.emit_state = [this](const EngineState &state) { emitted.push_back(state); };
+        cb.request_position = [this](uint64_t generation) { position_requests.push_back(generation); };
+        cb.timeline_changed = [this](uint64_t serial, const std::vector<LyricLine> &) { timelines.push_back(serial); };
+        return cb;
+    }
+};
+
+static PlayerUpdate track(const char *trackid, const char *title, const char *lyrics) {
+    PlayerUpdate update;
+    update.has_status = true; update.is_playing = true;
+    update.has_metadata = true;
+    update.metadata.trackid = trackid; update.metadata.title = title; update.metadata.artist = "歌手"; update.metadata.duration_us = 200000000;
+    if (lyrics) { update.has_lyrics = true; update.lyrics = lyrics; }
+    return update;
+}
+
+static void test_track_change() {
+    Harness h;
+    h.engine.on_player_update(track("/1", "晴天", kLyrics));
+    // 先发标题，再发时间轴就绪后的状态，并请求一次位置
+    CHECK_EQ(h.emitted.size(), 2u);
+    CHECK_EQ(h.emitted[0].title, std::string("晴天"));
+    CHECK_EQ(h.emitted[0].lyric, std::string());
+    CHECK_EQ(h.position_requests.size(), 1u);
+    CHECK_EQ(h.engine.timeline().size(), 3u);
+    CHECK_EQ(h.engine.metrics().track_change_first_emit.count, 1u);
+
+    CHECK_EQ(h.engine.state().line_start_us, -1);
+    CHECK_EQ(h.engine.state().line_end_us, 1000000);
+    CHECK_EQ(h.engine.state().next_lyric, std::string("第一行"));
+    h.engine.on_position_sample(5500000, h.engine.generation());
+    CHECK_EQ(h.engine.state().lyric, std::string("第二行"));
+    CHECK_EQ(h.engine.state().line_start_us, 5000000);
+    CHECK_EQ(h.engine.state().line_end_us, 9000000);
+    CHECK_EQ(h.engine.state().next_lyric, std::string("第三行"));
+    int64_t boundary = h.engine.next_line_time_us();
+    CHECK_EQ(boundary, h.clock.now_us() + 3500001);
+    h.clock.set(boundary);
+    h.engine.tick();
+    CHECK_EQ(h.engine.state().lyric, std::string("第三行"));
+    CHECK_EQ(h.engine.next_line_time_us(), -1);
+    // 最后一行用曲目时长作为结束
+    CHECK_EQ(h.engine.state().line_end_us, 200000000);
+    CHECK_EQ(h.engine.state().next_lyric, std::string());
+    h.clock.advance(500000 - 1);
+    h.engine.tick();
+    CHECK_EQ(h.engine.state().position_us, 9500000);
+}
+
+static void test_stale_position_and_pause() {
+    Harness h;
+    h.engine.on_player_update(track("/1", "晴天", kLyrics));
+    uint64_t old_generation = h.engine.generation();
+    h.engine.on_player_update(track("/2", "七里香", kLyrics));
+    h.engine.on_position_sample(9500000, old_generation);
+    CHECK_EQ(h.engine.state().lyric, std::string());
+
+    PlayerUpdate pause; pause.has_status = true; pause.is_playing = false;
+    h.engine.on_player_update(pause);
+    CHECK_EQ(h.position_requests.size(), 3u);
+    CHECK(!h.engine.music().is_playing);
+    CHECK_EQ(h.engine.music().title, std::string("七里香"));
+    h.engine.on_position_sample(1500000, h.engine.generation());
+    h.clock.advance(10000000);
+    h.engine.tick();
+    CHECK_EQ(h.engine.state().position_us, 1500000);
+    CHECK_EQ(h.engine.state().lyric, std::string("第一行"));
+}
+
+static void test_seek() {
+    Harness h;
+    h.engine.on_player_update(track("/3", "晴天", kLyrics));
+    CHECK_EQ(h.engine.timeline().size(), 3u);
+    uint64_t before_seek = h.engine.generation();
+    h.engine.on_seek(9000000);
+    CHECK_EQ(h.engine.state().lyric, std::string("第三行"));
+    // 跳转前发出的位置查询，回复带回旧位置，应被丢弃
+    h.engine.on_position_sample(1000000, before_seek);
+    CHECK_EQ(h.engine.state().lyric, std::string("第三行"));
+    h.engine.on_player_update(track("/4", "没有歌词", nullptr));
+    CHECK(h.engine.timeline().empty());
+    CHECK_EQ(h.timelines.back(), 0u);
+}
+
+static void test_romanization() {
+    Harness h;
+    h.engine.on_player_update(track("/1", "晴天", kLyrics));
+    uint64_t serial = h.timelines.back();
+    h.engine.on_seek(1000000);
+    h.engine.on_romanization_ready(serial + 1, {"x", "y", "z"});
+    CHECK_EQ(h.engine.state().romanization, std::string());
+    h.engine.on_romanization_ready(serial, {"di yi hang", "di er hang", "di san hang"});
+    CHECK_EQ(h.engine.state().romanization, std::string("di yi hang"));
+    // 同一份歌词再次到来，不替换时间轴，罗马音保留
+    PlayerUpdate same = track("/1", "晴天", kLyrics); same.has_status = false;
+    h.engine.on_player_update(same);
+    h.engine.tick();
+    CHECK_EQ(h.engine.state().romanization, std::string("di yi hang"));
+}
+
+static void test_coalescing() {
+    Harness h;
+    // 一串信号：旧歌元数据、状态、新歌元数据，合并后只按最后的元数据换一次歌
+    h.engine.queue_player_update(track("/1", "晴天", kLyrics));
+    PlayerUpdate pause; pause.has_status = true; pause.is_playing = false;
+    h.engine.queue_player_update(pause);
+    PlayerUpdate next = track("/2", "七里香", nullptr); next.has_status = false;
+    h.engine.queue_player_update(next);
+    CHECK(h.emitted.empty());
+    CHECK(h.engine.has_pending_update());
+    h.engine.flush_player_updates();
+    CHECK(!h.engine.has_pending_update());
+    CHECK_EQ(h.emitted.size(), 2u);
+    CHECK_EQ(h.engine.music().title, std::string("七里香"));
+    CHECK(!h.engine.music().is_playing);
+    // 最后一份元数据没带歌词，不沿用前一份的
+    CHECK(h.engine.timeline().empty());
+    CHECK_EQ(h.engine.metrics().updates_received, 3u);
+    CHECK_EQ(h.engine.metrics().updates_applied, 1u);
+    h.engine.flush_player_updates();
+    CHECK_EQ(h.engine.metrics().updates_applied, 1u);
+}
+
+static void test_output_offset() {
+    Harness h;
+    h.engine.set_output_offset_us(250000);
+    h.engine.on_player_update(track("/1", "晴天", kLyrics));
+    CHECK_EQ(h.engine.timeline()[0].timestamp_us, 1250000);
+    h.engine.on_seek(1100000);
+    CHECK_EQ(h.engine.state().lyric, std::string());
+    h.clock.advance(150000);
+    h.engine.tick();
+    CHECK_EQ(h.engine.state().lyric, std::string("第一行"));
+    // 换到延迟更大的设备，当前行随之退回
+    h.engine.set_output_offset_us(400000);
+    CHECK_EQ(h.engine.timeline()[1].timestamp_us, 5400000);
+    CHECK_EQ(h.engine.timeline()[1].end_us, 9400000);
+    CHECK_EQ(h.engine.timeline()[2].end_us, -1);
+    CHECK_EQ(h.engine.state().lyric, std::string());
+}
+
+static void test_prefetch() {
+    Harness h;
+    int requests = 0;
+    h.engine.on_player_update(track("/1", "晴天", kLyrics));
+    // 播放器给的歌词：预取的 payload 相同才采用
+    PrefetchedLyrics next; next.trackid = "/2"; next.from_player = true; next.payload = kLyrics; next.timeline = parse_lyric_payload(kLyrics);
+    next.timeline[0].text = "预取";
+    h.engine.store_prefetched(next);
+    CHECK(h.engine.has_prefetched("/2"));
+    h.engine.on_player_update(track("/2", "七里香", kLyrics));
+    CHECK_EQ(h.engine.metrics().prefetch_hits, 1u);
+    CHECK_EQ(h.engine.timeline()[0].text, std::string("预取"));
+    CHECK(!h.engine.has_prefetched("/2"));
+
+    next.trackid = "/3"; next.payload = "[00:01.00]旧版本\n";
+    h.engine.store_prefetched(next);
+    h.engine.on_player_update(track("/3", "稻香", kLyrics));
+    CHECK_EQ(h.engine.metrics().prefetch_hits, 1u);
+    CHECK(h.engine.has_prefetched("/3"));
+
+    // 本地歌词库的结果：命中时不再请求流水线；确认本地没有歌词的也算命中，但仍交给流水线查别的来源
+    EngineCallbacks cb = h.callbacks();
+    cb.request_lyrics = [&requests](const music_t &) { requests++; };
+    ManualClock clock{0};
+    LyricEngine engine(clock, std::move(cb));
+    PrefetchedLyrics local; local.trackid = "/4"; local.payload = kLyrics; local.timeline = parse_lyric_payload(kLyrics);
+    engine.store_prefetched(local);
+    PrefetchedLyrics none; none.trackid = "/5";
+    engine.store_prefetched(none);
+    engine.on_player_update(track("/4", "本地", nullptr));
+    CHECK_EQ(engine.timeline().size(), 3u);
+    CHECK_EQ(requests, 0);
+    engine.on_player_update(track("/5", "没有歌词", nullptr));
+    CHECK(engine.timeline().empty());
+    CHECK_EQ(requests, 1);
+    CHECK_EQ(engine.metrics().prefetch_hits, 2u);
+    engine.on_player_update(track("/6", "没有歌词", nullptr));
+    CHECK_EQ(requests, 2);
+
+    // 最多保留 kPrefetchDepth 份，先存的先丢
+    for (int i = 0; i < 3; ++i) { PrefetchedLyrics p; p.trackid = "/q" + std::to_string(i); engine.store_prefetched(p); }
+    CHECK(!engine.has_prefetched("/q0"));
+    CHECK(engine.has_prefetched("/q2"));
+}
+
+static void test_progressive_lyrics() {
+    Harness h;
+    const std::string full = "[00:01.00]第一行\n[00:05.00]第二行\n[00:09.00]第三行\n[00:13.00]第四行\n";
+    // 先到的元数据没有歌词内容
+    h.engine.on_player_update(track("/1", "晴天", ""));
+    CHECK(h.engine.timeline().empty());
+    h.engine.on_position_sample(5500000, h.engine.generation());
+    // 截断在第三行中间，当前行已经可以显示
+    PlayerUpdate partial = track("/1", "晴天", full.substr(0, 53).c_str()); partial.has_status = false;
+    size_t emitted = h.emitted.size();
+    h.engine.on_player_update(partial);
+    CHECK_EQ(h.emitted.size(), emitted + 1);
+    CHECK_EQ(h.engine.state().lyric, std::string("第二行"));
+    h.engine.on_romanization_ready(h.timelines.back(), {"di yi hang", "di er hang", "di"});
+    // 完整歌词到达：只解析追加部分，当前行和已有行的罗马音保留，没有发出空行
+    PlayerUpdate complete = track("/1", "晴天", full.c_str()); complete.has_status = false;
+    emitted = h.emitted.size();
+    h.engine.on_player_update(complete);
+    CHECK_EQ(h.engine.metrics().incremental_parses, 1u);
+    CHECK_EQ(h.engine.timeline().size(), 4u);
+    CHECK_EQ(h.emitted.size(), emitted + 1);
+    for (size_t i = emitted; i < h.emitted.size(); ++i) CHECK_EQ(h.emitted[i].lyric, std::string("第二行"));
+    CHECK_EQ(h.engine.state().romanization, std::string("di er hang"));
+    CHECK_EQ(h.engine.state().next_lyric, std::string("第三行"));
+}
+
+// 流水线的结果：与服务一样在交给引擎之前解析好
+static PrefetchedLyrics found_lyrics(const char *trackid, const char *payload) {
+    PrefetchedLyrics found; found.trackid = trackid; found.payload = payload; found.timeline = parse_lyric_payload(payload);
+    return found;
+}
+
+// 播放器没给歌词时交给异步的来源流水线：每首歌只请求一次，结果到达时已换歌则丢弃，同一首歌后续的元数据更新沿用结果
+static void test_async_lookup() {
+    Harness h;
+    std::vector<music_t> requests;
+    EngineCallbacks cb = h.callbacks();
+    cb.request_lyrics = [&requests](const music_t &music) { requests.push_back(music); };
+    ManualClock clock{0};
+    std::vector<EngineState> emitted;
+    cb.emit_state = [&emitted](const EngineState &state) { emitted.push_back(state); };
+    LyricEngine engine(clock, std::move(cb));
+    PlayerUpdate update = track("/1", "晴天", nullptr);
+    update.metadata.url = "file:///music/qingtian.flac";
+    engine.on_player_update(update);
+    CHECK_EQ(requests.size(), 1u);
+    CHECK_EQ(requests[0].url, std::string("file:///music/qingtian.flac"));
+    update.has_status = false; update.metadata.duration_us += 1;
+    engine.on_player_update(update);
+    CHECK_EQ(requests.size(), 1u);
+
+    engine.on_position_sample(5500000, engine.generation());
+    size_t before = emitted.size();
+    engine.on_lyrics_found(found_lyrics("/1", kLyrics));
+    CHECK_EQ(emitted.size(), before + 1);
+    CHECK_EQ(engine.state().lyric, std::string("第二行"));
+    update.metadata.duration_us += 1;
+    engine.on_player_update(update);
+    CHECK_EQ(engine.timeline().size(), 3u);
+    CHECK_EQ(requests.size(), 1u);
+
+    // 过期结果
+    engine.on_player_update(track("/2", "稻香", nullptr));
+    CHECK_EQ(requests.size(), 2u);
+    engine.on_lyrics_found(found_lyrics("/1", kLyrics));
+    CHECK(engine.timeline().empty());
+    // 播放器给了歌词后，晚到的结果不覆盖
+    engine.on_player_update(track("/4", "夜曲", nullptr));
+    CHECK_EQ(requests.size(), 3u);
+    engine.on_player_update(track("/4", "夜曲", "[00:01.00]播放器的歌词\n"));
+    engine.on_lyrics_found(found_lyrics("/4", kLyrics));
+    CHECK_EQ(engine.timeline().size(), 1u);
+
+    // 只有时间轴没有文本（内嵌 SYLT）：直接采用，之后的元数据更新沿用同一份
+    engine.on_player_update(track("/5", "七里香", nullptr));
+    PrefetchedLyrics synced; synced.trackid = "/5"; synced.timeline = {LyricLine{1000000, "窗外的麻雀", 3000000}, LyricLine{3000000, "在电线杆上多嘴"}};
+    engine.on_lyrics_found(synced);
+    CHECK_EQ(engine.timeline().size(), 2u);
+    CHECK_EQ(engine.timeline()[1].text, std::string("在电线杆上多嘴"));
+    PlayerUpdate again = track("/5", "七里香", nullptr); again.has_status = false; again.metadata.duration_us += 1;
+    engine.on_player_update(again);
+    CHECK_EQ(engine.timeline().size(), 2u);
+    CHECK_EQ(requests.size(), 4u);
+}
+
+// 客户端只拿最近一次发出的锚点自己外推，任何时刻都与引擎的预测相差不超过容差；
+// 没有换行、跳转或状态变化时 tick 不再发出
+static void test_clock_anchor() {
+    Harness h;
+    h.engine.on_player_update(track("/1", "晴天", kLyrics));
+    auto client_position = [&h]() {
+        const EngineState &last = h.emitted.back();
+        clock_model_t anchor = {}; anchor.anchor_time_us = last.anchor_time_us; anchor.anchor_position_us = last.anchor_position_us; anchor.rate = last.rate;
+        return clock_predict_us(anchor, last.is_playing, h.clock.now_us());
+    };
+    auto check_equivalent = [&]() {
+        int64_t diff = client_position() - h.engine.predicted_position_us();
+        CHECK(diff <= LyricEngine::kAnchorToleranceUs && diff >= -LyricEngine::kAnchorToleranceUs);
+    };
+    h.engine.on_position_sample(1500000, h.engine.generation());
+    check_equivalent();
+    // 1. 同一行内 tick：不发出，客户端外推仍然准确
+    size_t emitted = h.emitted.size();
+    for (int i = 0; i < 20; ++i) { h.clock.advance(100000); h.engine.tick(); check_equivalent(); }
+    CHECK_EQ(h.emitted.size(), emitted);
+    // 走到 5 秒换到第二行，只发这一次
+    for (int i = 0; i < 20; ++i) { h.clock.advance(100000); h.engine.tick(); check_equivalent(); }
+    CHECK_EQ(h.emitted.size(), emitted + 1);
+    CHECK_EQ(h.emitted.back().lyric, std::string("第二行"));
+    // 2. 小抖动的位置采样不重新发布锚点，超出容差才发布
+    int64_t anchor_time = h.emitted.back().anchor_time_us;
+    h.engine.on_position_sample(h.engine.predicted_position_us() + 5000, h.engine.generation());
+    CHECK_EQ(h.emitted.back().anchor_time_us, anchor_time);
+    check_equivalent();
+    h.clock.advance(1000);
+    h.engine.on_position_sample(h.engine.predicted_position_us() + 80000, h.engine.generation());
+    CHECK(h.emitted.back().anchor_time_us != anchor_time);
+    check_equivalent();
+    // 3. 暂停、变速、跳转都立即发出新锚点
+    PlayerUpdate pause; pause.has_status = true; pause.is_playing = false;
+    emitted = h.emitted.size();
+    h.engine.on_player_update(pause);
+    CHECK_EQ(h.emitted.size(), emitted + 1);
+    CHECK(!h.emitted.back().is_playing);
+    h.clock.advance(3000000);
+    check_equivalent();
+    PlayerUpdate resume; resume.has_status = true; resume.is_playing = true; resume.has_rate = true; resume.rate = 1.5;
+    h.engine.on_player_update(resume);
+    CHECK_EQ(h.emitted.back().rate, 1.5);
+    h.clock.advance(700000);
+    check_equivalent();
+    h.engine.on_seek(2000000);
+    CHECK_EQ(h.emitted.back().anchor_position_us, 2000000);
+    h.clock.advance(250000);
+    check_equivalent();
+}
+
+// 守护模式下各会话的引擎共用解析结果：第二个引擎不再解析，平移输出延迟也不影响共享的那份
+static void test_shared_cache() {
+    SharedLyricCache shared;
+    Harness a, b;
+    a.engine.set_shared_cache(&shared);
+    b.engine.set_shared_cache(&shared);
+    b.engine.set_output_offset_us(300000);
+    a.engine.on_player_update(track("/1", "晴天", kLyrics));
+    b.engine.on_player_update(track("/9", "晴天", kLyrics));
+    CHECK_EQ(a.engine.metrics().shared_cache_hits, 0u);
+    CHECK_EQ(b.engine.metrics().shared_cache_hits, 1u);
+    CHECK_EQ(shared.size(), 1u);
+    CHECK_EQ(a.engine.timeline()[0].timestamp_us, 1000000);
+    CHECK_EQ(b.engine.timeline()[0].timestamp_us, 1300000);
+    CHECK_EQ(shared.find(kLyrics)->at(0).timestamp_us, 1000000);
+    // 容量满了淘汰最久没用的
+    SharedLyricCache small(2);
+    small.insert("a", nullptr); small.insert("b", nullptr);
+    small.find("a");
+    small.insert("c", std::make_shared<const std::vector<LyricLine>>());
+    CHECK_EQ(small.size(), 2u);
+    CHECK(small.find("c") != nullptr);
+    small.insert("b", std::make_shared<const std::vector<LyricLine>>());
+    CHECK(small.find("b") != nullptr);
+    CHECK(small.find("a") == nullptr);
+}
+
+static void test_find_and_seek_to_line() {
+    Harness h;
+    h.engine.on_player_update(track("/1", "晴天", kLyrics));
+    CHECK((h.engine.find_lines("三") == std::vector<int>{2}));
+    CHECK_EQ(h.engine.find_lines("行").size(), 3u);
+    uint64_t generation = h.engine.generation();
+    size_t emitted = h.emitted.size();
+    CHECK_EQ(h.engine.seek_to_line(1), 5000000);
+    // 立即换行、重新锚定并发出，不等位置同步
+    CHECK_EQ(h.engine.state().lyric, std::string("第二行"));
+    CHECK_EQ(h.engine.generation(), generation + 1);
+    CHECK_EQ(h.emitted.size(), emitted + 1);
+    CHECK_EQ(h.emitted.back().anchor_position_us, 5000000);
+    CHECK_EQ(h.emitted.back().anchor_time_us, h.clock.now_us());
+    CHECK_EQ(h.engine.seek_to_line(3), -1);
+    CHECK_EQ(h.engine.seek_to_line(-1), -1);
+    CHECK_EQ(h.engine.generation(), generation + 1);
+    // 有输出延迟时发给播放器的是声音开始的位置，歌词随延迟显示
+    h.engine.set_output_offset_us(200000);
+    CHECK_EQ(h.engine.seek_to_line(0), 1000000);
+    CHECK_EQ(h.engine.state().lyric, std::string());
+    // 换了时间轴后索引重建
+    h.engine.on_player_update(track("/2", "雨", "[00:01.00]下雨天\n"));
+    CHECK((h.engine.find_lines("雨") == std::vector<int>{0}));
+    CHECK(h.engine.find_lines("三").empty());
+}
+
+static void test_layout_segments() {
+    Harness h;
+    h.engine.on_player_update(track("/1", "晴天", "[00:01.00]从出生那年就飘着，童年的荡秋千\n[00:08.50]第二行\n"));
+    uint64_t serial = h.timelines.back();
+    h.engine.on_seek(2000000);
+    // 排版未就绪时段就是整行
+    CHECK_EQ(h.engine.state().segment, std::string("从出生那年就飘着，童年的荡秋千"));
+    CHECK_EQ(h.engine.next_line_time_us(), h.clock.now_us() + 6500000 + 1);
+    h.engine.on_layout_ready(serial + 1, layout_timeline(h.engine.timeline(), 20));
+    CHECK_EQ(h.engine.state().segment, std::string("从出生那年就飘着，童年的荡秋千"));
+    size_t emitted = h.emitted.size();
+    h.engine.on_layout_ready(serial, layout_timeline(h.engine.timeline(), 20));
+    CHECK_EQ(h.engine.state().segment, std::string("从出生那年就飘着，"));
+    CHECK_EQ(h.emitted.size(), emitted + 1);
+    // 第二段在行内 4.5s 处开始，换段时机和换行一样由 next_line_time_us 给出
+    CHECK_EQ(h.engine.next_line_time_us(), h.clock.now_us() + 3500000 + 1);
+    h.clock.advance(3500001);
+    h.engine.tick();
+    CHECK_EQ(h.engine.state().segment, std::string("童年的荡秋千"));
+    CHECK_EQ(h.engine.state().lyric, std::string("从出生那年就飘着，童年的荡秋千"));
+    CHECK_EQ(h.emitted.size(), emitted + 2);
+    h.engine.tick();
+    CHECK_EQ(h.emitted.size(), emitted + 2);
+    // 跳回行首回到第一段；不需要分段的行段即整行
+    h.engine.on_seek(1500000);
+    CHECK_EQ(h.engine.state().segment, std::string("从出生那年就飘着，"));
+    h.engine.on_seek(9000000);
+    CHECK_EQ(h.engine.state().segment, std::string("第二行"));
+    // 输出延迟平移时间轴，段随行一起平移
+    h.engine.set_output_offset_us(500000);
+    h.engine.on_seek(6000000);
+    CHECK_EQ(h.engine.state().segment, std::string("童年的荡秋千"));
+    h.engine.on_seek(5900000);
+    CHECK_EQ(h.engine.state().segment, std::string("从出生那年就飘着，"));
+}
+
+static void test_snapshot_replay() {
+    Harness h;
+    h.engine.set_output_offset_us(300000);
+    h.engine.on_player_update(track("/1", "晴天", kLyrics));
+    h.engine.on_position_sample(6000000, h.engine.generation());
+    TimelineSnapshot snapshot = h.engine.snapshot();
+    CHECK_EQ(snapshot.title, std::string("晴天"));
+    CHECK_EQ(snapshot.output_offset_us, 300000);
+    CHECK_EQ(snapshot.anchor_position_us, 6000000);
+    CHECK_EQ(snapshot.captured_us, h.clock.now_us());
+    // 导出的是未平移的原始时间
+    CHECK_EQ(snapshot.timeline.size(), 3u);
+    CHECK_EQ(snapshot.timeline[1].timestamp_us, 5000000);
+
+    // 经过二进制往返后在另一个引擎里重放，时钟拨到导出时刻，结果与原引擎一致
+    std::string data = timeline_snapshot_encode(snapshot);
+    TimelineSnapshotView view;
+    CHECK(TimelineSnapshotView::parse(data, &view));
+    Harness replay;
+    replay.clock.set(view.captured_us());
+    replay.engine.load_snapshot(view.materialize());
+    CHECK_EQ(replay.engine.output_offset_us(), 300000);
+    CHECK_EQ(replay.engine.timeline()[1].timestamp_us, 5300000);
+    CHECK_EQ(replay.engine.state().lyric, std::string("第二行"));
+    CHECK_EQ(replay.engine.next_line_time_us(), h.engine.next_line_time_us());
+    CHECK_EQ(replay.emitted.size(), 1u);
+    CHECK_EQ(replay.timelines.size(), 1u);
+    replay.clock.set(replay.engine.next_line_time_us());
+    replay.engine.tick();
+    CHECK_EQ(replay.engine.state().lyric, std::string("第三行"));
+
+    // 没有歌词的曲目导出空时间轴
+    h.engine.on_player_update(track("/2", "没有歌词", nullptr));
+    CHECK(h.engine.snapshot().timeline.empty());
+}
+
+int main() {
+    test_track_change();
+    test_stale_position_and_pause();
+    test_seek();
+    test_romanization();
+    test_coalescing();
+    test_output_offset();
+    test_prefetch();
+    test_progressive_lyrics();
+    test_async_lookup();
+    test_clock_anchor();
+    test_shared_cache();
+    test_find_and_seek_to_line();
+    test_layout_segments();
+    test_snapshot_replay();
+    return g_failures;
+}
@@ -0,0 +1,73 @@
+#include "test_main.h"
+
+#include <string>
+#include <vector>
+
+#include "lyric_layout.h"
+
+static void test_columns() {
+    CHECK_EQ(display_columns("hello"), 5);
+    CHECK_EQ(display_columns("故事的小黄花"), 12);
+    CHECK_EQ(display_columns("君の名は。"), 10);
+    CHECK_EQ(display_columns("ＡＢ"), 4);
+    // 组合重音不占宽度，非法字节按 1 列
+    CHECK_EQ(display_columns("e\xcc\x81"), 1);
+    CHECK_EQ(display_columns(std::string("a\xff")), 2);
+}
+
+static std::vector<std::string> texts(const std::vector<LyricSegment> &segments) {
+    std::vector<std::string> out;
+    for (const LyricSegment &segment : segments) out.push_back(segment.text);
+    return out;
+}
+
+static void test_layout_line() {
+    // 放得下时不分段
+    CHECK(layout_lyric_line(LyricLine{0, "故事的小黄花", 4000000}, 12).empty());
+    CHECK(layout_lyric_line(LyricLine{0, "故事的小黄花", 4000000}, 0).empty());
+
+    // 在逗号后断开，时间按宽度分配
+    std::vector<LyricSegment> segments = layout_lyric_line(LyricLine{10000000, "从出生那年就飘着，童年的荡秋千", 17500000}, 20);
+    CHECK((texts(segments) == std::vector<std::string>{"从出生那年就飘着，", "童年的荡秋千"}));
+    CHECK_EQ(segments[0].offset_us, 0);
+    CHECK_EQ(segments[1].offset_us, 4500000);
+
+    // 英文在空格处断开，段首段尾不留空格，两段宽度接近
+    segments = layout_lyric_line(LyricLine{0, "Rain falls on the window and the night is long", 9000000}, 30);
+    CHECK_EQ(segments.size(), 2u);
+    for (const LyricSegment &segment : segments) {
+        CHECK(display_columns(segment.text) <= 30);
+        CHECK(segment.text.front() != ' ' && segment.text.back() != ' ');
+    }
+    CHECK_EQ(segments[0].text, std::string("Rain falls on the window"));
+
+    // 没有标点的中文在字间断开，各段不超过上限且均匀
+    segments = layout_lyric_line(LyricLine{0, "随记忆一直晃到现在随记忆一直晃到现在随记忆一直晃", 5000000}, 20);
+    CHECK_EQ(segments.size(), 3u);
+    for (const LyricSegment &segment : segments) CHECK(display_columns(segment.text) <= 20 && display_columns(segment.text) >= 14);
+
+    // 长于一段的单词硬切；结束时间未知时按每列估算
+    segments = layout_lyric_line(LyricLine{0, "Supercalifragilisticexpialidocious"}, 10);
+    CHECK_EQ(segments.size(), 4u);
+    CHECK_EQ(segments[0].text, std::string("Supercalif"));
+    CHECK_EQ(segments[1].offset_us, 10 * kColumnEstimateUs);
+
+    // 闭引号不放在段首
+    segments = layout_lyric_line(LyricLine{0, "她说「再见了」然后离开", 3000000}, 14);
+    for (const LyricSegment &segment : segments) CHECK(segment.text.rfind("」", 0) != 0);
+}
+
+static void test_layout_timeline() {
+    std::vector<LyricLine> timeline = {LyricLine{0, "短", 1000000}, LyricLine{1000000, "很长很长很长很长很长很长的一行", 5000000}};
+    std::vector<std::vector<LyricSegment>> layout = layout_timeline(timeline, 16);
+    CHECK_EQ(layout.size(), 2u);
+    CHECK(layout[0].empty());
+    CHECK_EQ(layout[1].size(), 2u);
+}
+
+int main() {
+    test_columns();
+    test_layout_line();
+    test_layout_timeline();
+    return g_failures;
+}
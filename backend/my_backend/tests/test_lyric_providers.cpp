@@ -0,0 +1,203 @@
+#include "test_main.h"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "lyric_providers.h"
+
+static const char *kLyrics = "[00:01.00]第一行\n[00:05.00]第二行\n";
+
+// 本地的 HTTP 桩服务器：标题为 hit 的请求返回歌词，其余 404；每个响应先等 latency_ms
+class StubServer {
+public:
+    explicit StubServer(int latency_ms) : latency_ms_(latency_ms) {
+        fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(fd_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+        socklen_t length = sizeof(addr);
+        getsockname(fd_, reinterpret_cast<struct sockaddr *>(&addr), &length);
+        port_ = ntohs(addr.sin_port);
+        listen(fd_, 16);
+        thread_ = std::thread(&StubServer::serve, this);
+    }
+    ~StubServer() { stop_ = true; thread_.join(); close(fd_); }
+    std::string url(const char *path) const { return "http://127.0.0.1:" + std::to_string(port_) + path; }
+    int requests() const { return requests_; }
+
+private:
+    void serve() {
+        while (!stop_) {
+            struct pollfd pfd = {fd_, POLLIN, 0};
+            if (poll(&pfd, 1, 20) <= 0) continue;
+            int client = accept(fd_, nullptr, nullptr);
+            if (client < 0) continue;
+            std::string request;
+            char buf[1024];
+            ssize_t n;
+            while (request.find("\r\n\r\n") == std::string::npos && (n = recv(client, buf, sizeof(buf), 0)) > 0) request.append(buf, static_cast<size_t>(n));
+            requests_++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(latency_ms_));
+            bool hit = request.find("title=hit") != std::string::npos;
+            std::string body = hit ? kLyrics : "not found";
+            std::string response = std::string(hit ? "HTTP/1.0 200 OK" : "HTTP/1.0 404 Not Found") + "\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+            send(client, response.data(), response.size(), MSG_NOSIGNAL);
+            close(client);
+        }
+    }
+
+    int latency_ms_;
+    int fd_ = -1;
+    int port_ = 0;
+    std::atomic<bool> stop_{false};
+    std::atomic<int> requests_{0};
+    std::thread thread_;
+};
+
+static int64_t ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static LyricProvider provider(const char *name, int64_t deadline_us, int delay_ms, const char *payload) {
+    LyricProvider p;
+    p.name = name;
+    p.deadline_us = deadline_us;
+    p.fetch = [delay_ms, payload](const lyric_query_t &, const std::atomic<bool> &cancelled) {
+        auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms);
+        while (!cancelled && std::chrono::steady_clock::now() < until) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return provider_lyrics_t{payload, {}};
+    };
+    return p;
+}
+
+static lyric_result_t lookup_and_wait(LyricPipeline &pipeline, const char *title) {
+    std::promise<lyric_result_t> promise;
+    std::future<lyric_result_t> future = promise.get_future();
+    pipeline.lookup(lyric_query_t{"/1", "歌手", title, "", 200000000}, [&promise](lyric_result_t result) { promise.set_value(std::move(result)); });
+    return future.get();
+}
+
+static void test_url_template() {
+    lyric_query_t query = {"/org/1", "周 杰伦", "晴天&Rain", "", 269500000};
+    CHECK_EQ(expand_url_template("http://h/lrc?a={artist}&t={title}&d={duration}&x={unknown}", query),
+             std::string("http://h/lrc?a=%E5%91%A8%20%E6%9D%B0%E4%BC%A6&t=%E6%99%B4%E5%A4%A9%26Rain&d=269&x={unknown}"));
+    CHECK_EQ(expand_url_template("http://h/{trackid}{", query), std::string("http://h/%2Forg%2F1{"));
+}
+
+static void test_http_get() {
+    StubServer server(0);
+    std::atomic<bool> cancelled{false};
+    std::string body;
+    CHECK_EQ(http_get(server.url("/lyrics?title=hit"), 2000000, cancelled, &body), 200);
+    CHECK_EQ(body, std::string(kLyrics));
+    CHECK_EQ(http_get(server.url("/lyrics?title=miss"), 2000000, cancelled, &body), 404);
+    CHECK_EQ(http_get("https://127.0.0.1/", 2000000, cancelled, &body), -1);
+
+    // 服务器太慢：到期限就放弃；已取消的请求立即返回
+    StubServer slow(1000);
+    auto start = std::chrono::steady_clock::now();
+    CHECK_EQ(http_get(slow.url("/lyrics?title=hit"), 100000, cancelled, &body), -1);
+    CHECK(ms_since(start) < 800);
+    cancelled = true;
+    start = std::chrono::steady_clock::now();
+    CHECK_EQ(http_get(slow.url("/lyrics?title=hit"), 5000000, cancelled, &body), -1);
+    CHECK(ms_since(start) < 800);
+}
+
+static void test_first_result_wins() {
+    std::vector<LyricProvider> providers;
+    providers.push_back(provider("miss", 0, 0, ""));
+    providers.push_back(provider("slow-hit", 0, 30, kLyrics));
+    // 一直阻塞到被取消
+    providers.push_back(provider("stuck", 0, 60000, "[00:01.00]不该采用\n"));
+    LyricPipeline pipeline(std::move(providers));
+    auto start = std::chrono::steady_clock::now();
+    lyric_result_t result = lookup_and_wait(pipeline, "晴天");
+    CHECK(ms_since(start) < 2000);
+    CHECK_EQ(result.provider, std::string("slow-hit"));
+    CHECK_EQ(result.lyrics.text, std::string(kLyrics));
+    CHECK_EQ(pipeline.provider_count(), 3u);
+    CHECK_EQ(pipeline.metrics(0).misses, 1u);
+    CHECK_EQ(pipeline.metrics(1).hits, 1u);
+    CHECK_EQ(pipeline.metrics(1).wins, 1u);
+    CHECK_EQ(pipeline.metrics(2).cancelled, 1u);
+    CHECK_EQ(pipeline.metrics(2).hits, 0u);
+}
+
+static void test_deadline_and_cancel() {
+    std::vector<LyricProvider> providers;
+    providers.push_back(provider("miss", 0, 0, ""));
+    providers.push_back(provider("late", 50000, 60000, kLyrics));
+    LyricPipeline pipeline(std::move(providers));
+    auto start = std::chrono::steady_clock::now();
+    lyric_result_t result = lookup_and_wait(pipeline, "晴天");
+    CHECK(ms_since(start) < 2000);
+    CHECK(result.provider.empty());
+    CHECK_EQ(pipeline.metrics(1).timeouts, 1u);
+    CHECK_EQ(pipeline.metrics(1).requests, 1u);
+
+    // 取消：结果为空，回调照样来一次
+    std::promise<lyric_result_t> promise;
+    std::future<lyric_result_t> future = promise.get_future();
+    std::vector<LyricProvider> blocking;
+    blocking.push_back(provider("stuck", 0, 60000, kLyrics));
+    LyricPipeline pipeline2(std::move(blocking));
+    uint64_t id = pipeline2.lookup(lyric_query_t{"/1", "歌手", "晴天", "", 0}, [&promise](lyric_result_t r) { promise.set_value(std::move(r)); });
+    pipeline2.cancel(id);
+    CHECK(future.get().provider.empty());
+    CHECK_EQ(pipeline2.metrics(0).cancelled, 1u);
+
+    // 析构时还有查找在进行：取消并等线程退出
+    std::atomic<int> calls{0};
+    {
+        std::vector<LyricProvider> stuck;
+        stuck.push_back(provider("stuck", 0, 60000, kLyrics));
+        LyricPipeline pipeline3(std::move(stuck));
+        pipeline3.lookup(lyric_query_t{"/1", "歌手", "晴天", "", 0}, [&calls](lyric_result_t) { calls++; });
+    }
+    CHECK_EQ(calls.load(), 1);
+}
+
+static void test_http_provider_metrics() {
+    StubServer server(5);
+    std::vector<LyricProvider> providers;
+    providers.push_back(provider("local", 200000, 0, ""));
+    providers.push_back(http_lyric_provider(server.url("/lyrics?artist={artist}&title={title}"), 2000000));
+    LyricPipeline pipeline(std::move(providers));
+    const char *titles[] = {"hit", "miss", "hit", "miss"};
+    int found = 0;
+    for (const char *title : titles) {
+        lyric_result_t result = lookup_and_wait(pipeline, title);
+        if (!result.provider.empty()) { found++; CHECK_EQ(result.provider, std::string("http")); CHECK_EQ(result.lyrics.text, std::string(kLyrics)); }
+    }
+    CHECK_EQ(found, 2);
+    CHECK_EQ(server.requests(), 4);
+    provider_metrics_t metrics = pipeline.metrics(1);
+    CHECK_EQ(pipeline.provider_name(1), std::string("http"));
+    CHECK_EQ(metrics.requests, 4u);
+    CHECK_EQ(metrics.hits, 2u);
+    CHECK_EQ(metrics.misses, 2u);
+    CHECK_EQ(metrics.wins, 2u);
+    CHECK(metrics.total_latency_us >= 4 * 5000);
+    CHECK(metrics.max_latency_us >= 5000);
+    CHECK_EQ(pipeline.metrics(0).misses, 4u);
+}
+
+int main() {
+    test_url_template();
+    test_http_get();
+    test_first_result_wins();
+    test_deadline_and_cancel();
+    test_http_provider_metrics();
+    return g_failures;
+}
@@ -0,0 +1,43 @@
+#include "test_main.h"
+
+#include <string>
+#include <vector>
+
+#include "lyric_search.h"
+
+static std::vector<LyricLine> timeline(const std::vector<std::string> &texts) {
+    std::vector<LyricLine> lines;
+    for (size_t i = 0; i < texts.size(); ++i) lines.push_back(LyricLine{static_cast<int64_t>(i) * 1000000, texts[i]});
+    return lines;
+}
+
+static void test_normalize() {
+    CHECK(lyric_search_normalize("Hello, World!") == U"helloworld");
+    // 全角字母折成半角，中文标点和空白去掉
+    CHECK(lyric_search_normalize("ＡＢｃ　故事的，小黄花。") == U"abc故事的小黄花");
+    CHECK(lyric_search_normalize("「君の名は」…") == U"君の名は");
+    // 非法字节跳过，截断的多字节序列丢弃
+    CHECK(lyric_search_normalize(std::string("a\xff" "b\xe6\x95")) == U"ab");
+    CHECK(lyric_search_normalize("  ,. ").empty());
+}
+
+static void test_find() {
+    LyricSearchIndex index(timeline({"故事的小黄花", "从出生那年就飘着", "童年的荡秋千", "随记忆一直晃到现在", "Rain falls on the window", "故事的 小黄花 (Live)"}));
+    CHECK_EQ(index.line_count(), 6u);
+    CHECK((index.find("小黄花") == std::vector<int>{0, 5}));
+    CHECK((index.find("故事的小黄花") == std::vector<int>{0, 5}));
+    CHECK((index.find("年") == std::vector<int>{1, 2}));
+    CHECK((index.find("RAIN  FALLS") == std::vector<int>{4}));
+    CHECK((index.find("live") == std::vector<int>{5}));
+    // 两个 bigram 都出现但不相连
+    CHECK(index.find("的年").empty());
+    CHECK(index.find("晴天").empty());
+    CHECK(index.find("，。").empty());
+    CHECK(LyricSearchIndex().find("小黄花").empty());
+}
+
+int main() {
+    test_normalize();
+    test_find();
+    return g_failures;
+}
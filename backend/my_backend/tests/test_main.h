@@ -0,0 +1,9 @@
+#pragma once
+
+// 不依赖测试框架的最小断言：失败时打印位置并计数，main 返回失败数
+#include <iostream>
+
+static int g_failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #cond << std::endl; g_failures++; } } while (0)
+#define CHECK_EQ(a, b) do { auto va_ = (a); auto vb_ = (b); if (!(va_ == vb_)) { std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK_EQ failed: " #a " == " #b " (" << va_ << " vs " << vb_ << ")" << std::endl; g_failures++; } } while (0)
@@ -0,0 +1,232 @@
+#include "test_main.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "tag_lyrics.h"
+
+static const char *kLyrics = "[00:01.00]第一行\n[00:05.00]第二行\n";
+
+static std::string g_dir;
+
+// 写一个合成的音频文件：标签之后补 audio_bytes 字节的空洞充当音频数据
+static std::string write_file(const char *name, const std::string &tag, size_t audio_bytes = 1 << 20) {
+    std::string path = g_dir + "/" + name;
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (write(fd, tag.data(), tag.size()) != static_cast<ssize_t>(tag.size())) CHECK(false);
+    if (ftruncate(fd, static_cast<off_t>(tag.size() + audio_bytes)) != 0) CHECK(false);
+    close(fd);
+    return path;
+}
+
+static std::string be32(uint32_t v) { return std::string{static_cast<char>(v >> 24), static_cast<char>(v >> 16), static_cast<char>(v >> 8), static_cast<char>(v)}; }
+static std::string le32(uint32_t v) { return std::string{static_cast<char>(v), static_cast<char>(v >> 8), static_cast<char>(v >> 16), static_cast<char>(v >> 24)}; }
+static std::string synchsafe(uint32_t v) { return std::string{static_cast<char>(v >> 21 & 0x7F), static_cast<char>(v >> 14 & 0x7F), static_cast<char>(v >> 7 & 0x7F), static_cast<char>(v & 0x7F)}; }
+
+static std::string id3_frame(int version, const char *id, const std::string &data) {
+    return std::string(id) + (version == 4 ? synchsafe(static_cast<uint32_t>(data.size())) : be32(static_cast<uint32_t>(data.size()))) + std::string(2, '\0') + data;
+}
+static std::string id3_tag(int version, const std::string &frames, int flags = 0) {
+    return std::string("ID3") + static_cast<char>(version) + '\0' + static_cast<char>(flags) + synchsafe(static_cast<uint32_t>(frames.size())) + frames;
+}
+// UTF-16LE，带 BOM
+static std::string utf16(const std::u16string &text) {
+    std::string out = "\xFF\xFE";
+    for (char16_t c : text) { out.push_back(static_cast<char>(c & 0xFF)); out.push_back(static_cast<char>(c >> 8)); }
+    return out;
+}
+// SYLT（UTF-8，毫秒）：条目是 {文本, 毫秒}
+static std::string sylt(const std::vector<std::pair<std::string, uint32_t>> &entries) {
+    std::string data = std::string("\x03zho\x02\x01", 6) + "desc" + '\0';
+    for (const auto &entry : entries) data += entry.first + '\0' + be32(entry.second);
+    return data;
+}
+static std::string vorbis_comment(const std::vector<std::string> &comments) {
+    std::string data = le32(9) + "reference" + le32(static_cast<uint32_t>(comments.size()));
+    for (const std::string &comment : comments) data += le32(static_cast<uint32_t>(comment.size())) + comment;
+    return data;
+}
+// 把包按 Ogg 分段切开，每页最多 per_page 段（强制注释包跨页）；不算校验和，读取时也不检查
+static std::string ogg_pages(const std::vector<std::string> &packets, size_t per_page) {
+    std::vector<unsigned char> lacing;
+    std::string data;
+    for (const std::string &packet : packets) {
+        for (size_t left = packet.size();; left -= 255) { lacing.push_back(static_cast<unsigned char>(left >= 255 ? 255 : left)); if (left < 255) break; }
+        data += packet;
+    }
+    std::string out;
+    size_t offset = 0;
+    for (size_t i = 0, page = 0; i < lacing.size(); i += per_page, ++page) {
+        size_t count = std::min(per_page, lacing.size() - i), bytes = 0;
+        out += std::string("OggS\0", 5) + static_cast<char>(page == 0 ? 2 : 0) + std::string(8, '\0') + le32(0x1234) + le32(static_cast<uint32_t>(page)) + std::string(4, '\0') + static_cast<char>(count);
+        for (size_t j = 0; j < count; ++j) { out.push_back(static_cast<char>(lacing[i + j])); bytes += lacing[i + j]; }
+        out += data.substr(offset, bytes);
+        offset += bytes;
+    }
+    return out;
+}
+
+static void test_file_url() {
+    CHECK_EQ(path_from_file_url("file:///music/%E6%99%B4%E5%A4%A9%20live.flac"), std::string("/music/晴天 live.flac"));
+    CHECK_EQ(path_from_file_url("file://localhost/a%2"), std::string("/a%2"));
+    CHECK_EQ(path_from_file_url("/music/a.mp3"), std::string("/music/a.mp3"));
+    CHECK(path_from_file_url("file://host/a.mp3").empty());
+    CHECK(path_from_file_url("https://music.163.com/song?id=1").empty());
+    CHECK(path_from_file_url("").empty());
+}
+
+static void test_id3_uslt() {
+    // 大封面在前，UTF-16 的 USLT 在后
+    std::string apic = std::string("\x00image/jpeg\x00\x03\x00", 14) + std::string(200000, '\xFF');
+    std::string uslt = std::string("\x01zho", 4) + utf16(u"") + std::string(2, '\0') + utf16(u"[00:01.00]第一行\n[00:05.00]第二行\n");
+    std::string path = write_file("uslt.mp3", id3_tag(3, id3_frame(3, "TIT2", std::string("\x00晴天", 7)) + id3_frame(3, "APIC", apic) + id3_frame(3, "USLT", uslt)));
+    provider_lyrics_t lyrics;
+    CHECK(read_embedded_lyrics(path, &lyrics));
+    CHECK_EQ(lyrics.text, std::string(kLyrics));
+    CHECK(lyrics.timeline.empty());
+
+    // 整个标签反同步（v2.3）：ISO-8859-1 的 ÿ 是 0xFF，后面插入了 0x00
+    std::string frame = id3_frame(3, "USLT", std::string("\x00" "eng\x00[00:01.00]\xFF" "x", 17));
+    frame.insert(frame.find('\xFF') + 1, 1, '\0');
+    path = write_file("unsync.mp3", id3_tag(3, frame, 0x80));
+    lyrics = provider_lyrics_t();
+    CHECK(read_embedded_lyrics(path, &lyrics));
+    CHECK_EQ(lyrics.text, std::string("[00:01.00]\xC3\xBFx"));
+
+    // v2.2 的三字符帧 ULT
+    std::string v22 = std::string("ULT") + std::string("\x00\x00", 2) + static_cast<char>(5 + strlen(kLyrics)) + std::string("\x03zho\x00", 5) + kLyrics;
+    path = write_file("v22.mp3", id3_tag(2, v22));
+    lyrics = provider_lyrics_t();
+    CHECK(read_embedded_lyrics(path, &lyrics));
+    CHECK_EQ(lyrics.text, std::string(kLyrics));
+}
+
+static void test_id3_sylt() {
+    // 逐字同步：换行开头的条目开始新行；同时有 USLT 时 SYLT 优先
+    std::string karaoke = sylt({{"\n故事的", 1000}, {"小黄花", 1800}, {"\n从出生那年", 5000}, {"就飘着", 6000}, {"\n", 9000}, {"\n童年的荡秋千", 12000}});
+    std::string path = write_file("karaoke.mp3", id3_tag(4, id3_frame(4, "USLT", std::string("\x03zho\x00", 5) + kLyrics) + id3_frame(4, "SYLT", karaoke)));
+    provider_lyrics_t lyrics;
+    CHECK(read_embedded_lyrics(path, &lyrics));
+    CHECK(lyrics.text.empty());
+    CHECK_EQ(lyrics.timeline.size(), 3u);
+    if (lyrics.timeline.size() == 3) {
+        CHECK_EQ(lyrics.timeline[0].text, std::string("故事的小黄花"));
+        CHECK_EQ(lyrics.timeline[0].timestamp_us, 1000000);
+        CHECK_EQ(lyrics.timeline[0].end_us, 5000000);
+        CHECK(!lyrics.timeline[0].gap_after);
+        CHECK_EQ(lyrics.timeline[1].text, std::string("从出生那年就飘着"));
+        CHECK_EQ(lyrics.timeline[1].end_us, 9000000);
+        CHECK(lyrics.timeline[1].gap_after);
+        CHECK_EQ(lyrics.timeline[2].end_us, -1);
+    }
+
+    // 逐行同步：每条一行，按时间排序
+    path = write_file("lines.mp3", id3_tag(4, id3_frame(4, "SYLT", sylt({{"第二行", 5000}, {"第一行", 1000}}))));
+    lyrics = provider_lyrics_t();
+    CHECK(read_embedded_lyrics(path, &lyrics));
+    CHECK_EQ(lyrics.timeline.size(), 2u);
+    if (lyrics.timeline.size() == 2) {
+        CHECK_EQ(lyrics.timeline[0].text, std::string("第一行"));
+        CHECK_EQ(lyrics.timeline[0].end_us, 5000000);
+        CHECK_EQ(lyrics.timeline[1].timestamp_us, 5000000);
+    }
+
+    // MPEG 帧号时间戳不支持，退回文本
+    std::string frames = sylt({{"第一行", 40}});
+    frames[4] = 1;
+    path = write_file("frames.mp3", id3_tag(3, id3_frame(3, "SYLT", frames) + id3_frame(3, "USLT", std::string("\x03zho\x00", 5) + kLyrics)));
+    lyrics = provider_lyrics_t();
+    CHECK(read_embedded_lyrics(path, &lyrics));
+    CHECK(lyrics.timeline.empty());
+    CHECK_EQ(lyrics.text, std::string(kLyrics));
+}
+
+static void test_flac() {
+    std::string streaminfo = std::string("\x00\x00\x00\x22", 4) + std::string(34, '\0');
+    std::string picture = std::string(100000, '\x55');
+    std::string comment = vorbis_comment({"TITLE=晴天", std::string("METADATA_BLOCK_PICTURE=") + std::string(5000, 'A'), std::string("lyrics=") + kLyrics});
+    std::string blocks = streaminfo + '\x06' + be32(static_cast<uint32_t>(picture.size())).substr(1) + picture + '\x84' + be32(static_cast<uint32_t>(comment.size())).substr(1) + comment;
+    std::string path = write_file("a.flac", "fLaC" + blocks);
+    provider_lyrics_t lyrics;
+    CHECK(read_embedded_lyrics(path, &lyrics));
+    CHECK_EQ(lyrics.text, std::string(kLyrics));
+
+    // FLAC 前面带 ID3v2
+    path = write_file("id3.flac", id3_tag(3, id3_frame(3, "TIT2", std::string("\x00x", 2))) + "fLaC" + blocks);
+    lyrics = provider_lyrics_t();
+    CHECK(read_embedded_lyrics(path, &lyrics));
+    CHECK_EQ(lyrics.text, std::string(kLyrics));
+
+    // 没有歌词
+    std::string plain = vorbis_comment({"TITLE=晴天"});
+    path = write_file("plain.flac", "fLaC" + streaminfo.replace(0, 1, "\x00") + '\x84' + be32(static_cast<uint32_t>(plain.size())).substr(1) + plain);
+    lyrics = provider_lyrics_t();
+    CHECK(!read_embedded_lyrics(path, &lyrics));
+}
+
+static void test_ogg() {
+    std::string comment = "\x03vorbis" + vorbis_comment({"ARTIST=周杰伦", std::string(600, 'X') + "=padding", std::string("UNSYNCEDLYRICS=") + kLyrics});
+    std::string identification = "\x01vorbis" + std::string(23, '\0');
+    // 注释包跨三页；后面还有 setup 包和音频页
+    std::string path = write_file("a.ogg", ogg_pages({identification, comment, "\x05vorbis" + std::string(3000, '\0')}, 2));
+    provider_lyrics_t lyrics;
+    CHECK(read_embedded_lyrics(path, &lyrics));
+    CHECK_EQ(lyrics.text, std::string(kLyrics));
+
+    path = write_file("a.opus", ogg_pages({"OpusHead" + std::string(11, '\0'), "OpusTags" + vorbis_comment({std::string("LYRICS=") + kLyrics})}, 255));
+    lyrics = provider_lyrics_t();
+    CHECK(read_embedded_lyrics(path, &lyrics));
+    CHECK_EQ(lyrics.text, std::string(kLyrics));
+}
+
+// 截断在任意位置都不越界，也不会得到错误结果
+static void test_truncated() {
+    std::string tags[] = {
+        id3_tag(4, id3_frame(4, "SYLT", sylt({{"\n故事的", 1000}, {"小黄花", 1800}}))),
+        "fLaC" + std::string("\x80\x00\x00\x0A", 4) + std::string(10, '\0'),
+        ogg_pages({"\x01vorbis" + std::string(23, '\0'), "\x03vorbis" + vorbis_comment({std::string("LYRICS=") + kLyrics})}, 1),
+    };
+    for (const std::string &tag : tags) {
+        for (size_t n = 0; n < tag.size(); ++n) {
+            provider_lyrics_t lyrics;
+            CHECK(!read_embedded_lyrics(write_file("cut", tag.substr(0, n), 0), &lyrics));
+        }
+    }
+    provider_lyrics_t lyrics;
+    CHECK(!read_embedded_lyrics(g_dir + "/missing.mp3", &lyrics));
+    CHECK(!read_embedded_lyrics(g_dir, &lyrics));
+    CHECK(!read_embedded_lyrics(write_file("noise.mp3", std::string(4096, '\xFB')), &lyrics));
+}
+
+static void test_provider() {
+    std::string path = write_file("晴天 live.mp3", id3_tag(3, id3_frame(3, "USLT", std::string("\x03zho\x00", 5) + kLyrics)));
+    LyricProvider provider = tag_lyric_provider(200000);
+    CHECK_EQ(provider.name, std::string("tags"));
+    std::atomic<bool> cancelled{false};
+    std::string url = "file://" + g_dir + "/%E6%99%B4%E5%A4%A9%20live.mp3";
+    CHECK_EQ(provider.fetch(lyric_query_t{"/1", "周杰伦", "晴天", url, 0}, cancelled).text, std::string(kLyrics));
+    CHECK(provider.fetch(lyric_query_t{"/1", "周杰伦", "晴天", "https://music.163.com/1.mp3", 0}, cancelled).text.empty());
+    CHECK(provider.fetch(lyric_query_t{"/1", "周杰伦", "晴天", "", 0}, cancelled).text.empty());
+}
+
+int main() {
+    char dir[] = "/tmp/test_tag_lyrics.XXXXXX";
+    if (!mkdtemp(dir)) return 1;
+    g_dir = dir;
+    test_file_url();
+    test_id3_uslt();
+    test_id3_sylt();
+    test_flac();
+    test_ogg();
+    test_truncated();
+    test_provider();
+    std::string cleanup = "rm -rf '" + g_dir + "'";
+    if (system(cleanup.c_str()) != 0) return 1;
+    return g_failures;
+}
@@ -0,0 +1,43 @@
+#include "test_main.h"
+
+#include <string>
+
+#include "text_encoding.h"
+
+static void test_utf8_validate() {
+    const char *valid[] = { "", "ascii only", "故事的小黄花", "きみがいない", "\xF0\x9F\x8E\xB5" };
+    const char *invalid[] = { "\xC0\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "abc\xE6\x95", "\xFF" };
+    for (const char *s : valid) CHECK(utf8_validate(s, std::char_traits<char>::length(s)));
+    for (const char *s : invalid) CHECK(!utf8_validate(s, std::char_traits<char>::length(s)));
+    // 长输入走向量路径，错误字节放在块边界附近
+    std::string long_text(200, 'a');
+    CHECK(utf8_validate(long_text.data(), long_text.size()));
+    for (size_t at : {31u, 32u, 63u, 64u, 199u}) {
+        std::string bad = long_text; bad[at] = '\x80';
+        CHECK(!utf8_validate(bad.data(), bad.size()));
+        CHECK_EQ(utf8_validate(bad.data(), bad.size()), utf8_validate_scalar(bad.data(), bad.size()));
+    }
+}
+
+static void test_decode_lyric_text() {
+    CHECK_EQ(decode_lyric_text("\xEF\xBB\xBF[00:01.00]a\r\n[00:02.00]b\r"), std::string("[00:01.00]a\n[00:02.00]b\n"));
+    // GBK 编码的 "晴天"
+    CHECK_EQ(decode_lyric_text("[00:01.00]\xC7\xE7\xCC\xEC\n"), std::string("[00:01.00]晴天\n"));
+    // UTF-16LE 带 BOM 的 "晴天"
+    CHECK_EQ(decode_lyric_text(std::string("\xFF\xFE\x74\x66\x29\x59", 6)), std::string("晴天"));
+}
+
+// Big5 编码的繁体歌词按 GB18030 也能解码成功（得到一串不相干的字），靠常用字打分选出 Big5
+static void test_decode_big5() {
+    const char big5[] = "[00:01.00]\xA7\xDA\xAD\xCC\xAA\xBA\xB7R \xC1\xD9\xA6" "b\xB0O\xBE\xD0\xB8\xCC\n";
+    CHECK_EQ(decode_lyric_text(big5), std::string("[00:01.00]我們的愛 還在記憶裡\n"));
+    // 同样能双向解码的简体 GBK 仍选 GBK
+    CHECK_EQ(decode_lyric_text("\xCE\xD2\xC3\xC7\xB5\xC4\xB0\xAE\n"), std::string("我们的爱\n"));
+}
+
+int main() {
+    test_utf8_validate();
+    test_decode_lyric_text();
+    test_decode_big5();
+    return g_failures;
+}
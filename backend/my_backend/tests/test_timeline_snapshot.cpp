@@ -0,0 +1,90 @@
+#include "test_main.h"
+
+#include <string>
+#include <vector>
+
+#include "timeline_snapshot.h"
+
+static TimelineSnapshot sample() {
+    TimelineSnapshot snapshot;
+    snapshot.trackid = "/org/mpris/MediaPlayer2/Track/42"; snapshot.artist = "周杰伦"; snapshot.title = "晴天";
+    snapshot.duration_us = 269000000; snapshot.is_playing = true;
+    snapshot.captured_us = 5000000; snapshot.anchor_time_us = 4200000; snapshot.anchor_position_us = 61000000; snapshot.rate = 1.25;
+    snapshot.output_offset_us = -180000;
+    snapshot.timeline = {LyricLine{1000000, "故事的小黄花", 5000000, false}, LyricLine{5000000, "从出生那年就飘着", 9000000, true}, LyricLine{12000000, "say \"hi\"\\", -1, false}};
+    return snapshot;
+}
+
+static void test_round_trip() {
+    std::string data = timeline_snapshot_encode(sample());
+    CHECK_EQ(data.size() % 8, 0u);
+    TimelineSnapshotView view;
+    CHECK(TimelineSnapshotView::parse(data, &view));
+    CHECK_EQ(view.size(), data.size());
+    CHECK_EQ(view.version(), kTimelineSnapshotVersion);
+    CHECK(view.trackid() == "/org/mpris/MediaPlayer2/Track/42");
+    CHECK(view.artist() == "周杰伦");
+    CHECK(view.title() == "晴天");
+    CHECK(view.is_playing());
+    CHECK_EQ(view.duration_us(), 269000000);
+    CHECK_EQ(view.anchor_position_us(), 61000000);
+    CHECK_EQ(view.rate(), 1.25);
+    CHECK_EQ(view.output_offset_us(), -180000);
+    CHECK_EQ(view.line_count(), 3u);
+    snapshot_line_t line = view.line(1);
+    CHECK_EQ(line.timestamp_us, 5000000);
+    CHECK_EQ(line.end_us, 9000000);
+    CHECK(line.gap_after);
+    CHECK(line.text == "从出生那年就飘着");
+    // 文本直接指向原缓冲区，不复制
+    CHECK(line.text.data() >= data.data() && line.text.data() < data.data() + data.size());
+    CHECK_EQ(view.line(2).end_us, -1);
+
+    TimelineSnapshot copy = view.materialize();
+    CHECK_EQ(copy.title, std::string("晴天"));
+    CHECK_EQ(copy.timeline.size(), 3u);
+    CHECK_EQ(copy.timeline[2].text, std::string("say \"hi\"\\"));
+    CHECK_EQ(copy.anchor_time_us, 4200000);
+}
+
+static void test_concatenated_and_corrupt() {
+    TimelineSnapshot second = sample();
+    second.title = "七里香"; second.timeline.clear();
+    std::string data = timeline_snapshot_encode(sample()) + timeline_snapshot_encode(second);
+    std::vector<std::string> titles;
+    std::string_view rest(data);
+    TimelineSnapshotView view;
+    while (!rest.empty() && TimelineSnapshotView::parse(rest, &view)) { titles.push_back(std::string(view.title())); rest.remove_prefix(view.size()); }
+    CHECK((titles == std::vector<std::string>{"晴天", "七里香"}));
+    CHECK(rest.empty());
+
+    std::string one = timeline_snapshot_encode(sample());
+    CHECK(!TimelineSnapshotView::parse(std::string_view(one).substr(0, one.size() - 8), &view));
+    CHECK(!TimelineSnapshotView::parse(std::string_view(one).substr(0, 40), &view));
+    std::string bad_magic = one; bad_magic[0] = 'X';
+    CHECK(!TimelineSnapshotView::parse(bad_magic, &view));
+    std::string bad_version = one; bad_version[4] = 9;
+    CHECK(!TimelineSnapshotView::parse(bad_version, &view));
+    // 行文本偏移越界
+    std::string bad_offset = one; bad_offset[80 + 16 + 3] = 0x7f;
+    CHECK(!TimelineSnapshotView::parse(bad_offset, &view));
+}
+
+static void test_json() {
+    std::string data = timeline_snapshot_encode(sample());
+    TimelineSnapshotView view;
+    CHECK(TimelineSnapshotView::parse(data, &view));
+    std::string json = timeline_snapshot_json(view);
+    CHECK(json.find("\"title\":\"晴天\"") != std::string::npos);
+    CHECK(json.find("\"rate\":1.25") != std::string::npos);
+    CHECK(json.find("\"text\":\"say \\\"hi\\\"\\\\\"") != std::string::npos);
+    CHECK(json.find("\"gap_after\":true") != std::string::npos);
+    CHECK(json.find("\"end_us\":-1") != std::string::npos);
+}
+
+int main() {
+    test_round_trip();
+    test_concatenated_and_corrupt();
+    test_json();
+    return g_failures;
+}
@@ -0,0 +1,54 @@
+#include "test_main.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "trace_ring.h"
+
+static size_t count_of(const std::string &haystack, const std::string &needle) {
+    size_t count = 0;
+    for (size_t at = haystack.find(needle); at != std::string::npos; at = haystack.find(needle, at + 1)) count++;
+    return count;
+}
+
+static void test_record_and_export() {
+    uint64_t before = trace_recorded_count();
+    {
+        TraceScope parse(TraceEvent::Parse, 1234);
+        trace_instant(TraceEvent::Emit, 7);
+    }
+    CHECK_EQ(trace_recorded_count(), before + 3);
+    std::string json = trace_export_json();
+    CHECK(json.compare(0, 15, "{\"displayTimeUn") == 0);
+    CHECK(json.find("\"name\":\"parse\",\"ph\":\"B\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"parse\",\"ph\":\"E\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"emit\",\"ph\":\"i\",\"s\":\"t\"") != std::string::npos);
+    CHECK(json.find("\"args\":{\"v\":1234}") != std::string::npos);
+
+    trace_set_enabled(false);
+    trace_instant(TraceEvent::Seek);
+    CHECK_EQ(trace_recorded_count(), before + 3);
+    trace_set_enabled(true);
+}
+
+// 多个线程同时写并绕环好几圈：导出的事件数不超过容量，每条都完整
+static void test_concurrent_wraparound() {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] { for (size_t i = 0; i < kTraceCapacity; ++i) trace_instant(TraceEvent::SyncReply, 42); });
+    }
+    std::string json;
+    for (int i = 0; i < 3; ++i) json = trace_export_json();
+    for (std::thread &thread : threads) thread.join();
+    json = trace_export_json();
+    CHECK_EQ(count_of(json, "\"name\":\"sync_reply\""), kTraceCapacity);
+    CHECK_EQ(count_of(json, "\"args\":{\"v\":42}"), kTraceCapacity);
+    CHECK(json.size() > 2 && json.compare(json.size() - 3, 3, "]}\n") == 0);
+}
+
+int main() {
+    test_record_and_export();
+    test_concurrent_wraparound();
+    return g_failures;
+}
@@ -0,0 +1,289 @@
+#include "text_encoding.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <iconv.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TEXT_ENCODING_X86 1
+#endif
+
+namespace {
+
+// 返回从 p 开始的一个合法 UTF-8 序列的长度，非法返回 0
+inline size_t utf8_sequence_length(const unsigned char *p, size_t avail) {
+    unsigned char c = p[0];
+    if (c < 0x80) return 1;
+    size_t n;
+    unsigned char lo = 0x80, hi = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF) n = 2;
+    else if (c == 0xE0) { n = 3; lo = 0xA0; }
+    else if (c == 0xED) { n = 3; hi = 0x9F; }
+    else if (c >= 0xE1 && c <= 0xEF) n = 3;
+    else if (c == 0xF0) { n = 4; lo = 0x90; }
+    else if (c >= 0xF1 && c <= 0xF3) n = 4;
+    else if (c == 0xF4) { n = 4; hi = 0x8F; }
+    else return 0;
+    if (avail < n) return 0;
+    if (p[1] < lo || p[1] > hi) return 0;
+    for (size_t i = 2; i < n; ++i) if ((p[i] & 0xC0) != 0x80) return 0;
+    return n;
+}
+
+#ifdef TEXT_ENCODING_X86
+
+// SSE2 是 x86-64 的基线：16 字节一组跳过纯 ASCII，遇到多字节序列再逐个标量校验
+bool utf8_validate_sse2(const char *data, size_t len) {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data);
+    size_t i = 0;
+    while (i + 16 <= len) {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i)));
+        if (mask == 0) { i += 16; continue; }
+        i += __builtin_ctz(mask);
+        size_t n = utf8_sequence_length(p + i, len - i);
+        if (n == 0) return false;
+        i += n;
+    }
+    return utf8_validate_scalar(data + i, len - i);
+}
+
+// AVX2：Keiser & Lemire 的查表法，每 32 字节用三次 vpshufb 查出所有错误类型
+__attribute__((target("avx2"))) inline __m256i lookup16(__m256i idx, const uint8_t (&table)[16]) {
+    __m256i t = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(table)));
+    return _mm256_shuffle_epi8(t, idx);
+}
+
+template <int N>
+__attribute__((target("avx2"))) inline __m256i prev_bytes(__m256i input, __m256i prev_input) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+}
+
+constexpr uint8_t TOO_SHORT = 1 << 0;
+constexpr uint8_t TOO_LONG = 1 << 1;
+constexpr uint8_t OVERLONG_3 = 1 << 2;
+constexpr uint8_t TOO_LARGE = 1 << 3;
+constexpr uint8_t SURROGATE = 1 << 4;
+constexpr uint8_t OVERLONG_2 = 1 << 5;
+constexpr uint8_t TOO_LARGE_1000 = 1 << 6;
+constexpr uint8_t OVERLONG_4 = 1 << 6;
+constexpr uint8_t TWO_CONTS = 1 << 7;
+constexpr uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+constexpr uint8_t kByte1High[16] = {
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    TOO_SHORT | OVERLONG_2,
+    TOO_SHORT,
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+};
+constexpr uint8_t kByte1Low[16] = {
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    CARRY | OVERLONG_2,
+    CARRY,
+    CARRY,
+    CARRY | TOO_LARGE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+};
+constexpr uint8_t kByte2High[16] = {
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+};
+
+__attribute__((target("avx2"))) bool utf8_validate_avx2(const char *data, size_t len) {
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    // 块末尾三个字节若是多字节序列的开头，需要下一块来补全
+    const __m256i incomplete_max = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xEF), static_cast<char>(0xDF), static_cast<char>(0xBF));
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+
+    auto check_block = [&](__m256i input) __attribute__((target("avx2"))) {
+        if (_mm256_movemask_epi8(input) == 0) {
+            error = _mm256_or_si256(error, prev_incomplete);
+        } else {
+            __m256i prev1 = prev_bytes<1>(input, prev_input);
+            __m256i b1h = lookup16(_mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble), kByte1High);
+            __m256i b1l = lookup16(_mm256_and_si256(prev1, low_nibble), kByte1Low);
+            __m256i b2h = lookup16(_mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble), kByte2High);
+            __m256i special = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+
+            __m256i prev2 = prev_bytes<2>(input, prev_input);
+            __m256i prev3 = prev_bytes<3>(input, prev_input);
+            __m256i is_third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+            __m256i is_fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+            __m256i must23_80 = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+            error = _mm256_or_si256(error, _mm256_xor_si256(must23_80, special));
+            prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+        }
+        prev_input = input;
+    };
+
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) check_block(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)));
+    if (i < len) {
+        // 尾部补零（ASCII），截断的序列会在补零处被判为 TOO_SHORT
+        alignas(32) char tail[32] = {};
+        std::memcpy(tail, data + i, len - i);
+        check_block(_mm256_load_si256(reinterpret_cast<const __m256i *>(tail)));
+    }
+    error = _mm256_or_si256(error, prev_incomplete);
+    return _mm256_testz_si256(error, error);
+}
+
+#endif // TEXT_ENCODING_X86
+
+bool iconv_to_utf8(const char *from_charset, std::string_view in, std::string &out) {
+    iconv_t cd = iconv_open("UTF-8", from_charset);
+    if (cd == reinterpret_cast<iconv_t>(-1)) return false;
+    out.assign(in.size() * 2 + 16, '\0');
+    char *src = const_cast<char *>(in.data());
+    size_t src_left = in.size();
+    size_t produced = 0;
+    bool ok = true;
+    while (src_left > 0) {
+        char *dst = out.data() + produced;
+        size_t dst_left = out.size() - produced;
+        size_t rc = iconv(cd, &src, &src_left, &dst, &dst_left);
+        produced = out.size() - dst_left;
+        if (rc != static_cast<size_t>(-1)) break;
+        if (errno == E2BIG) { out.resize(out.size() * 2); continue; }
+        ok = false;  // EILSEQ / EINVAL：不是这种编码
+        break;
+    }
+    iconv_close(cd);
+    out.resize(produced);
+    return ok;
+}
+
+// GBK 和 Big5 的字节范围高度重叠，两种都能解码时按常用字命中数选一个：
+// 用错编码解出来的多是生僻字，很少落在常用字表里
+const std::vector<uint32_t> &common_han() {
+    static const std::vector<uint32_t> table = [] {
+        const char *chars =
+            "的一是不了在人有我他她你们这个来说时会对过去想要看就都也还没让听见走再能好多里上下中大小"
+            "生年日月夜光花雨雪风心爱梦泪天地自己那些什么为和国到以后得着把给跟等谁最只从如果已经"
+            "這個們來說時會對過還沒讓聽見裡為國後麼從經愛夢淚風記憶與輕為開關頭邊間無樣";
+        std::vector<uint32_t> cps;
+        for (const unsigned char *p = reinterpret_cast<const unsigned char *>(chars); *p;) {
+            uint32_t cp = ((p[0] & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+            cps.push_back(cp);
+            p += 3;
+        }
+        std::sort(cps.begin(), cps.end());
+        cps.erase(std::unique(cps.begin(), cps.end()), cps.end());
+        return cps;
+    }();
+    return table;
+}
+
+size_t score_han(const std::string &utf8) {
+    const auto &table = common_han();
+    size_t score = 0;
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(utf8.data());
+    const unsigned char *end = p + utf8.size();
+    while (p < end) {
+        if ((p[0] & 0xF0) == 0xE0 && end - p >= 3) {
+            uint32_t cp = ((p[0] & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+            if (std::binary_search(table.begin(), table.end(), cp)) score++;
+            p += 3;
+        } else {
+            p++;
+        }
+    }
+    return score;
+}
+
+// 最后的兜底：把非法字节替换成 U+FFFD，保证下游拿到的一定是合法 UTF-8
+std::string utf8_replace_invalid(std::string_view in) {
+    std::string out;
+    out.reserve(in.size());
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(in.data());
+    size_t i = 0;
+    while (i < in.size()) {
+        size_t n = utf8_sequence_length(p + i, in.size() - i);
+        if (n == 0) { out += "\xEF\xBF\xBD"; i++; continue; }
+        out.append(in.data() + i, n);
+        i += n;
+    }
+    return out;
+}
+
+std::string to_utf8(std::string_view raw) {
+    // 带 BOM 的情况编码是确定的
+    if (raw.size() >= 3 && std::memcmp(raw.data(), "\xEF\xBB\xBF", 3) == 0) raw.remove_prefix(3);
+    else if (raw.size() >= 2 && (std::memcmp(raw.data(), "\xFF\xFE", 2) == 0 || std::memcmp(raw.data(), "\xFE\xFF", 2) == 0)) {
+        const char *charset = raw[0] == '\xFF' ? "UTF-16LE" : "UTF-16BE";
+        std::string out;
+        if (iconv_to_utf8(charset, raw.substr(2), out) && utf8_validate(out.data(), out.size())) return out;
+        return utf8_replace_invalid(raw);
+    }
+    if (utf8_validate(raw.data(), raw.size())) return std::string(raw);
+
+    std::string gbk, big5;
+    bool gbk_ok = iconv_to_utf8("GB18030", raw, gbk);
+    bool big5_ok = iconv_to_utf8("BIG5", raw, big5);
+    if (gbk_ok && big5_ok) return score_han(big5) > score_han(gbk) ? big5 : gbk;
+    if (gbk_ok) return gbk;
+    if (big5_ok) return big5;
+    return utf8_replace_invalid(raw);
+}
+
+} // namespace
+
+bool utf8_validate_scalar(const char *data, size_t len) {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data);
+    size_t i = 0;
+    while (i < len) {
+        size_t n = utf8_sequence_length(p + i, len - i);
+        if (n == 0) return false;
+        i += n;
+    }
+    return true;
+}
+
+bool utf8_validate(const char *data, size_t len) {
+#ifdef TEXT_ENCODING_X86
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2 ? utf8_validate_avx2(data, len) : utf8_validate_sse2(data, len);
+#else
+    return utf8_validate_scalar(data, len);
+#endif
+}
+
+std::string decode_lyric_text(std::string_view raw) {
+    std::string text = to_utf8(raw);
+    // CRLF / 单独的 CR 统一成 LF：LRC 解析和增量解析只按 '\n' 分行，只用 CR 换行的文件否则会整份并成一行
+    size_t out = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\r') {
+            text[out++] = '\n';
+            if (i + 1 < text.size() && text[i + 1] == '\n') ++i;
+        } else {
+            text[out++] = text[i];
+        }
+    }
+    text.resize(out);
+    return text;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// 歌词文本编码预处理，放在 parse_lrc 之前，每份歌词只跑一次：
+// 去掉 BOM，UTF-16 / GBK(GB18030) / Big5 转成 UTF-8，CRLF / CR 统一成 LF。
+// 输出保证是合法 UTF-8，可以直接交给 g_variant_new_string。
+
+// UTF-8 校验：x86 上运行时选择 AVX2 / SSE2 向量路径，其他平台走标量实现
+bool utf8_validate(const char *data, size_t len);
+
+// 标量参考实现，供向量路径处理尾部和测试对照使用
+bool utf8_validate_scalar(const char *data, size_t len);
+
+std::string decode_lyric_text(std::string_view raw);
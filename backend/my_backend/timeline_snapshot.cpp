@@ -0,0 +1,161 @@
+#include "timeline_snapshot.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const char kMagic[4] = {'M', 'F', 'T', 'L'};
+const size_t kHeaderSize = 80;
+const size_t kLineSize = 24;
+const uint32_t kGapBit = 0x80000000u;
+
+// 逐字节拼装，与主机字节序无关，也不要求对齐
+void put_u16(std::string &out, uint16_t v) { for (int i = 0; i < 2; ++i) out.push_back(static_cast<char>(v >> (8 * i))); }
+void put_u32(std::string &out, uint32_t v) { for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>(v >> (8 * i))); }
+void put_u64(std::string &out, uint64_t v) { for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>(v >> (8 * i))); }
+void put_i64(std::string &out, int64_t v) { put_u64(out, static_cast<uint64_t>(v)); }
+void put_f64(std::string &out, double v) { uint64_t bits; std::memcpy(&bits, &v, sizeof(bits)); put_u64(out, bits); }
+
+uint16_t get_u16(const unsigned char *p) { return static_cast<uint16_t>(p[0] | p[1] << 8); }
+uint32_t get_u32(const unsigned char *p) { uint32_t v = 0; for (int i = 3; i >= 0; --i) v = v << 8 | p[i]; return v; }
+uint64_t get_u64(const unsigned char *p) { uint64_t v = 0; for (int i = 7; i >= 0; --i) v = v << 8 | p[i]; return v; }
+int64_t get_i64(const unsigned char *p) { return static_cast<int64_t>(get_u64(p)); }
+double get_f64(const unsigned char *p) { uint64_t bits = get_u64(p); double v; std::memcpy(&v, &bits, sizeof(v)); return v; }
+
+void append_json_string(std::string &out, std::string_view text) {
+    out.push_back('"');
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') { out.push_back('\\'); out.push_back(static_cast<char>(c)); }
+        else if (c == '\n') out += "\\n";
+        else if (c < 0x20) { char buf[8]; snprintf(buf, sizeof(buf), "\\u%04x", c); out += buf; }
+        else out.push_back(static_cast<char>(c));
+    }
+    out.push_back('"');
+}
+
+}  // namespace
+
+std::string timeline_snapshot_encode(const TimelineSnapshot &snapshot) {
+    std::string strings = snapshot.trackid + snapshot.artist + snapshot.title;
+    std::string out;
+    out.reserve(kHeaderSize + snapshot.timeline.size() * kLineSize + strings.size() + snapshot.timeline.size() * 32);
+    out.append(kMagic, sizeof(kMagic));
+    put_u16(out, kTimelineSnapshotVersion);
+    put_u16(out, static_cast<uint16_t>(kHeaderSize));
+    put_u32(out, static_cast<uint32_t>(snapshot.timeline.size()));
+    size_t strings_size_at = out.size();
+    put_u32(out, 0);
+    put_i64(out, snapshot.captured_us);
+    put_i64(out, snapshot.anchor_time_us);
+    put_i64(out, snapshot.anchor_position_us);
+    put_f64(out, snapshot.rate);
+    put_i64(out, snapshot.output_offset_us);
+    put_i64(out, snapshot.duration_us);
+    put_u32(out, snapshot.is_playing ? 1 : 0);
+    put_u32(out, static_cast<uint32_t>(snapshot.trackid.size()));
+    put_u32(out, static_cast<uint32_t>(snapshot.artist.size()));
+    put_u32(out, static_cast<uint32_t>(snapshot.title.size()));
+    for (const LyricLine &line : snapshot.timeline) {
+        put_i64(out, line.timestamp_us);
+        put_i64(out, line.end_us);
+        put_u32(out, static_cast<uint32_t>(strings.size()));
+        put_u32(out, static_cast<uint32_t>(line.text.size()) | (line.gap_after ? kGapBit : 0));
+        strings += line.text;
+    }
+    // 字符串区补齐到 8 字节，下一份快照的头部仍然对齐
+    strings.resize((strings.size() + 7) & ~static_cast<size_t>(7), '\0');
+    uint32_t strings_size = static_cast<uint32_t>(strings.size());
+    for (int i = 0; i < 4; ++i) out[strings_size_at + i] = static_cast<char>(strings_size >> (8 * i));
+    out += strings;
+    return out;
+}
+
+bool TimelineSnapshotView::parse(std::string_view data, TimelineSnapshotView *view) {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data.data());
+    if (data.size() < kHeaderSize || std::memcmp(p, kMagic, sizeof(kMagic)) != 0) return false;
+    TimelineSnapshotView v;
+    v.version_ = get_u16(p + 4);
+    size_t header_size = get_u16(p + 6);
+    if (v.version_ != kTimelineSnapshotVersion || header_size < kHeaderSize) return false;
+    v.line_count_ = get_u32(p + 8);
+    uint32_t strings_size = get_u32(p + 12);
+    // 64 位下不会溢出：行数和长度都不超过 2^32
+    uint64_t size = static_cast<uint64_t>(header_size) + static_cast<uint64_t>(v.line_count_) * kLineSize + strings_size;
+    if (size > data.size()) return false;
+    v.size_ = static_cast<size_t>(size);
+    v.captured_us_ = get_i64(p + 16);
+    v.anchor_time_us_ = get_i64(p + 24);
+    v.anchor_position_us_ = get_i64(p + 32);
+    v.rate_ = get_f64(p + 40);
+    v.output_offset_us_ = get_i64(p + 48);
+    v.duration_us_ = get_i64(p + 56);
+    v.is_playing_ = (get_u32(p + 64) & 1) != 0;
+    v.trackid_len_ = get_u32(p + 68);
+    v.artist_len_ = get_u32(p + 72);
+    v.title_len_ = get_u32(p + 76);
+    if (!std::isfinite(v.rate_)) return false;
+    if (static_cast<uint64_t>(v.trackid_len_) + v.artist_len_ + v.title_len_ > strings_size) return false;
+    v.lines_ = p + header_size;
+    v.strings_ = data.substr(header_size + static_cast<size_t>(v.line_count_) * kLineSize, strings_size);
+    for (uint32_t i = 0; i < v.line_count_; ++i) {
+        const unsigned char *line = v.lines_ + i * kLineSize;
+        uint64_t end = static_cast<uint64_t>(get_u32(line + 16)) + (get_u32(line + 20) & ~kGapBit);
+        if (end > strings_size) return false;
+    }
+    *view = v;
+    return true;
+}
+
+snapshot_line_t TimelineSnapshotView::line(size_t index) const {
+    const unsigned char *p = lines_ + index * kLineSize;
+    uint32_t length = get_u32(p + 20);
+    return snapshot_line_t{get_i64(p), get_i64(p + 8), (length & kGapBit) != 0, string_at(get_u32(p + 16), length & ~kGapBit)};
+}
+
+TimelineSnapshot TimelineSnapshotView::materialize() const {
+    TimelineSnapshot snapshot;
+    snapshot.trackid = std::string(trackid());
+    snapshot.artist = std::string(artist());
+    snapshot.title = std::string(title());
+    snapshot.duration_us = duration_us_;
+    snapshot.is_playing = is_playing_;
+    snapshot.captured_us = captured_us_;
+    snapshot.anchor_time_us = anchor_time_us_;
+    snapshot.anchor_position_us = anchor_position_us_;
+    snapshot.rate = rate_;
+    snapshot.output_offset_us = output_offset_us_;
+    snapshot.timeline.reserve(line_count_);
+    for (size_t i = 0; i < line_count_; ++i) {
+        snapshot_line_t line = this->line(i);
+        snapshot.timeline.push_back(LyricLine{line.timestamp_us, std::string(line.text), line.end_us, line.gap_after});
+    }
+    return snapshot;
+}
+
+std::string timeline_snapshot_json(const TimelineSnapshotView &view) {
+    std::string json;
+    char buf[320];
+    snprintf(buf, sizeof(buf), "{\"version\":%u,\"trackid\":", static_cast<unsigned>(view.version()));
+    json += buf;
+    append_json_string(json, view.trackid());
+    json += ",\"artist\":";
+    append_json_string(json, view.artist());
+    json += ",\"title\":";
+    append_json_string(json, view.title());
+    snprintf(buf, sizeof(buf), ",\"duration_us\":%lld,\"is_playing\":%s,\"captured_us\":%lld,\"clock\":{\"anchor_time_us\":%lld,\"anchor_position_us\":%lld,\"rate\":%.17g},\"output_offset_us\":%lld,\"lines\":[",
+             static_cast<long long>(view.duration_us()), view.is_playing() ? "true" : "false", static_cast<long long>(view.captured_us()),
+             static_cast<long long>(view.anchor_time_us()), static_cast<long long>(view.anchor_position_us()), view.rate(), static_cast<long long>(view.output_offset_us()));
+    json += buf;
+    for (size_t i = 0; i < view.line_count(); ++i) {
+        snapshot_line_t line = view.line(i);
+        snprintf(buf, sizeof(buf), "%s\n{\"timestamp_us\":%lld,\"end_us\":%lld,\"gap_after\":%s,\"text\":", i ? "," : "",
+                 static_cast<long long>(line.timestamp_us), static_cast<long long>(line.end_us), line.gap_after ? "true" : "false");
+        json += buf;
+        append_json_string(json, line.text);
+        json.push_back('}');
+    }
+    json += "]}\n";
+    return json;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lyric_timeline.h"
+
+// 时间轴快照：当前曲目解析后的时间轴、时钟模型和输出延迟偏移，用来排查换行时序问题
+// （D-Bus ExportTimeline、music-info-service --dump-timeline 导出，--load-timeline 离线重放）。
+//
+// 二进制格式，整数小端，字段按自然边界对齐，可以直接 mmap 后读取，文本不复制：
+//   头部  "MFTL" | u16 版本 | u16 头部长度 | u32 行数 | u32 字符串区长度
+//         i64 captured_us | i64 anchor_time_us | i64 anchor_position_us | f64 rate | i64 output_offset_us | i64 duration_us
+//         u32 标志（bit0 播放中）| u32 trackid 长度 | u32 artist 长度 | u32 title 长度
+//   行表  每行 24 字节：i64 timestamp_us | i64 end_us | u32 文本偏移 | u32 文本长度（bit31 为 gap_after）
+//   字符串区  trackid、artist、title 依次排在开头，随后是各行文本，都不带结尾 0，末尾补齐到 8 字节
+// 多份快照可以首尾相接放在同一个文件里（例如整个歌词库的导出），按 size() 逐份往后读。
+// 版本号不同的拒绝读取；同一版本以后只在头部末尾追加字段，头部长度大于已知长度时跳过多出的部分
+
+static const uint16_t kTimelineSnapshotVersion = 1;
+
+// 时间轴是未加输出延迟偏移的原始时间；anchor_time_us 与 captured_us 是导出进程的单调时钟，重放时把时钟拨到 captured_us
+struct TimelineSnapshot {
+    std::string trackid;
+    std::string artist;
+    std::string title;
+    int64_t duration_us = 0;
+    bool is_playing = false;
+    int64_t captured_us = 0;
+    int64_t anchor_time_us = 0;
+    int64_t anchor_position_us = 0;
+    double rate = 1.0;
+    int64_t output_offset_us = 0;
+    std::vector<LyricLine> timeline;
+};
+
+std::string timeline_snapshot_encode(const TimelineSnapshot &snapshot);
+
+typedef struct { int64_t timestamp_us; int64_t end_us; bool gap_after; std::string_view text; } snapshot_line_t;
+
+// 只读视图，所有字符串都指向原缓冲区，缓冲区须比视图活得久
+class TimelineSnapshotView {
+public:
+    // 校验头部和所有偏移，格式不对（魔数、版本、越界）返回 false；data 可以比这一份快照长
+    static bool parse(std::string_view data, TimelineSnapshotView *view);
+
+    size_t size() const { return size_; }
+    uint16_t version() const { return version_; }
+    std::string_view trackid() const { return string_at(0, trackid_len_); }
+    std::string_view artist() const { return string_at(trackid_len_, artist_len_); }
+    std::string_view title() const { return string_at(trackid_len_ + artist_len_, title_len_); }
+    int64_t duration_us() const { return duration_us_; }
+    bool is_playing() const { return is_playing_; }
+    int64_t captured_us() const { return captured_us_; }
+    int64_t anchor_time_us() const { return anchor_time_us_; }
+    int64_t anchor_position_us() const { return anchor_position_us_; }
+    double rate() const { return rate_; }
+    int64_t output_offset_us() const { return output_offset_us_; }
+    size_t line_count() const { return line_count_; }
+    snapshot_line_t line(size_t index) const;
+
+    // 复制成可修改的快照（重放用）
+    TimelineSnapshot materialize() const;
+
+private:
+    std::string_view string_at(size_t offset, size_t length) const { return strings_.substr(offset, length); }
+
+    const unsigned char *lines_ = nullptr;
+    std::string_view strings_;
+    size_t size_ = 0;
+    uint16_t version_ = 0;
+    uint32_t line_count_ = 0;
+    uint32_t trackid_len_ = 0, artist_len_ = 0, title_len_ = 0;
+    int64_t duration_us_ = 0;
+    bool is_playing_ = false;
+    int64_t captured_us_ = 0;
+    int64_t anchor_time_us_ = 0;
+    int64_t anchor_position_us_ = 0;
+    double rate_ = 1.0;
+    int64_t output_offset_us_ = 0;
+};
+
+// 人可读的 JSON（一份快照一个对象）
+std::string timeline_snapshot_json(const TimelineSnapshotView &view);
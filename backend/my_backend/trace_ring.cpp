@@ -0,0 +1,109 @@
+#include "trace_ring.h"
+
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+static_assert((kTraceCapacity & (kTraceCapacity - 1)) == 0, "capacity must be a power of two");
+
+// 每个槽位都用原子字段，读写并发时不算数据竞争。seq 为 2n+1 表示第 n 条正在写，2n+2 表示写完
+struct Slot {
+    std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> ts_ns;
+    std::atomic<int64_t> arg;
+    std::atomic<uint64_t> meta;  // tid << 32 | phase << 16 | event
+};
+
+Slot g_slots[kTraceCapacity];
+std::atomic<uint64_t> g_head{0};
+std::atomic<bool> g_enabled{true};
+
+const char *const kEventNames[] = {
+    "signal_received", "flush", "track_change", "parse", "sync_request", "sync_reply",
+    "seek", "emit", "line_boundary", "prefetch", "romanization", "layout",
+};
+static_assert(sizeof(kEventNames) / sizeof(kEventNames[0]) == static_cast<size_t>(TraceEvent::Count), "one name per event");
+
+uint32_t current_tid() {
+    static thread_local uint32_t tid = static_cast<uint32_t>(syscall(SYS_gettid));
+    return tid;
+}
+
+uint64_t now_ns() {
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+}  // namespace
+
+void trace_record(TraceEvent event, TracePhase phase, int64_t arg) {
+    if (!g_enabled.load(std::memory_order_relaxed)) return;
+    uint64_t n = g_head.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = g_slots[n & (kTraceCapacity - 1)];
+    // 认领槽位：只把写完的旧事件（偶数且更小）换成 2n+1。环绕整整一圈时上一轮的写者可能还停在半路，
+    // 等它写完再覆盖，否则它最后一步会把 seq 改回旧值、吞掉这条；更新的写者已经占了槽位时，
+    // 这条已不在最近 kTraceCapacity 条之内，直接丢弃
+    uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+    for (;;) {
+        if (seq >= 2 * n + 1) return;
+        if (seq & 1) { sched_yield(); seq = slot.seq.load(std::memory_order_relaxed); continue; }
+        if (slot.seq.compare_exchange_weak(seq, 2 * n + 1, std::memory_order_relaxed)) break;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.ts_ns.store(now_ns(), std::memory_order_relaxed);
+    slot.arg.store(arg, std::memory_order_relaxed);
+    slot.meta.store(static_cast<uint64_t>(current_tid()) << 32 | static_cast<uint64_t>(static_cast<unsigned char>(phase)) << 16 | static_cast<uint16_t>(event), std::memory_order_relaxed);
+    slot.seq.store(2 * n + 2, std::memory_order_release);
+}
+
+void trace_set_enabled(bool enabled) { g_enabled.store(enabled, std::memory_order_relaxed); }
+
+uint64_t trace_recorded_count() { return g_head.load(std::memory_order_relaxed); }
+
+std::string trace_export_json() {
+    uint64_t head = g_head.load(std::memory_order_acquire);
+    uint64_t first = head > kTraceCapacity ? head - kTraceCapacity : 0;
+    std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    char buf[256];
+    snprintf(buf, sizeof(buf), "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"music-info-service\"}}", static_cast<int>(getpid()));
+    json += buf;
+    for (uint64_t n = first; n < head; ++n) {
+        const Slot &slot = g_slots[n & (kTraceCapacity - 1)];
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq != 2 * n + 2) continue;
+        uint64_t ts_ns = slot.ts_ns.load(std::memory_order_relaxed);
+        int64_t arg = slot.arg.load(std::memory_order_relaxed);
+        uint64_t meta = slot.meta.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) continue;
+        uint16_t event = static_cast<uint16_t>(meta & 0xFFFF);
+        if (event >= static_cast<uint16_t>(TraceEvent::Count)) continue;
+        char phase = static_cast<char>((meta >> 16) & 0xFF);
+        // Chrome trace 的 ts 单位是微秒，保留到纳秒
+        snprintf(buf, sizeof(buf), ",{\"name\":\"%s\",\"ph\":\"%c\",%s\"ts\":%llu.%03u,\"pid\":%d,\"tid\":%u,\"args\":{\"v\":%lld}}",
+                 kEventNames[event], phase, phase == 'i' ? "\"s\":\"t\"," : "",
+                 static_cast<unsigned long long>(ts_ns / 1000), static_cast<unsigned>(ts_ns % 1000),
+                 static_cast<int>(getpid()), static_cast<unsigned>(meta >> 32), static_cast<long long>(arg));
+        json += buf;
+    }
+    json += "]}\n";
+    return json;
+}
+
+bool trace_dump_to_file(const std::string &path) {
+    std::string json = trace_export_json();
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) return false;
+        out << json;
+        if (!out.flush()) return false;
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
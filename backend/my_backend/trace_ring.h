@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// 进程内事件追踪：固定大小的二进制环，不分配，任意线程都可以记录；除了环绕整整一圈时要等上一轮没写完的槽位，都不加锁也不等待。
+// 每条事件带 CLOCK_MONOTONIC 纳秒时间戳，按需导出成 Chrome trace JSON，
+// 可以直接拖进 ui.perfetto.dev 或 chrome://tracing 查看换歌、解析、位置同步和换行的时序。
+// 环满后覆盖最旧的事件，只保留最近的 kTraceCapacity 条。
+
+enum class TraceEvent : uint16_t {
+    SignalReceived,   // 收到 PropertiesChanged
+    Flush,            // 合并后的更新交给引擎
+    TrackChange,      // arg 为新的 generation
+    Parse,            // 歌词解码和解析（B/E），arg 为原文字节数
+    SyncRequest,      // 位置查询发出，arg 为 generation
+    SyncReply,        // 位置查询回复，arg 为位置（微秒）
+    Seek,             // 播放器跳转，arg 为位置（微秒）
+    Emit,             // 发出显示状态，arg 为当前行号
+    LineBoundary,     // timerfd 换行触发，arg 为迟到的微秒数
+    Prefetch,         // 后台预取解析（B/E）
+    Romanization,     // 后台罗马音生成（B/E），arg 为行数
+    Layout,           // 后台长行分段（B/E），arg 为行数
+    Count
+};
+
+enum class TracePhase : char { Begin = 'B', End = 'E', Instant = 'i' };
+
+static const size_t kTraceCapacity = 8192;
+
+void trace_record(TraceEvent event, TracePhase phase, int64_t arg = 0);
+inline void trace_instant(TraceEvent event, int64_t arg = 0) { trace_record(event, TracePhase::Instant, arg); }
+
+// 作用域内的一段耗时，构造时记 B、析构时记 E
+class TraceScope {
+public:
+    explicit TraceScope(TraceEvent event, int64_t arg = 0) : event_(event) { trace_record(event, TracePhase::Begin, arg); }
+    ~TraceScope() { trace_record(event_, TracePhase::End); }
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    TraceEvent event_;
+};
+
+void trace_set_enabled(bool enabled);
+// 累计记录过的事件数（包括已被覆盖的）
+uint64_t trace_recorded_count();
+// 把环里仍然保留的事件导出为 Chrome trace JSON；导出时其他线程可以继续记录，正在被覆盖的事件跳过
+std::string trace_export_json();
+bool trace_dump_to_file(const std::string &path);
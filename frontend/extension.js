@@ -14,8 +14,13 @@ const MusicInfoInterface = `
     <property name="Title" type="s" access="read"/>
     <property name="IsPlaying" type="b" access="read"/>
     <property name="CurrentLyric" type="s" access="read"/>
+    <property name="CurrentSegment" type="s" access="read"/>
     <property name="Duration" type="d" access="read"/>
     <property name="Position" type="d" access="read"/>
+    <property name="CurrentRomanization" type="s" access="read"/>
+    <method name="Subscribe">
+      <arg name="tier" type="s" direction="in"/>
+    </method>
     <signal name="StateChanged">
       <arg name="artist" type="s"/>
       <arg name="title" type="s"/>
@@ -38,6 +43,9 @@ export default class MusicfoxLyricExtension extends Extension {
         this._signalId = null;
         this._indicator = null;
         this._label = null;
+        this._romanLabel = null;
+        this._propsChangedId = null;
+        this._nameOwnerId = null;
 
         // --- 新增：后端进程管理属性 ---
         this._backendPid = null; // 用于存储后端进程的PID
@@ -62,7 +70,9 @@ export default class MusicfoxLyricExtension extends Extension {
                 if (error) { this._logError(`D-Bus proxy creation error: ${error.message}`); return; }
                 this._log('D-Bus proxy created successfully.');
                 this._connectSignal();
-                this._initialUpdate();
+                // 后端刚启动时通常还没占用总线名，重启后也是新的连接：每次名字有了主人都重新登记并刷新
+                this._nameOwnerId = this._proxy.connect('notify::g-name-owner', () => this._onNameOwnerChanged());
+                this._onNameOwnerChanged();
             }
         );
         
@@ -73,28 +83,50 @@ export default class MusicfoxLyricExtension extends Extension {
             style: 'min-width: 280px; max-width: 280px; overflow: hidden; line-height: 1.2em;',
             y_align: Clutter.ActorAlign.CENTER
         });
+        // 长行由后端按宽度切成几段（CurrentSegment）依次显示，省略号只是兜底
         if (this._label.clutter_text) {
             this._label.clutter_text.set_single_line_mode(true);
             this._label.clutter_text.set_ellipsize(Pango.EllipsizeMode.END);
         }
-        this._indicator.add_child(this._label);
+        // 罗马音显示在歌词下方的小字行，后端未开启罗马音时保持隐藏
+        this._romanLabel = new St.Label({
+            text: '',
+            visible: false,
+            style: 'min-width: 280px; max-width: 280px; font-size: 0.7em;',
+        });
+        if (this._romanLabel.clutter_text) {
+            this._romanLabel.clutter_text.set_single_line_mode(true);
+            this._romanLabel.clutter_text.set_ellipsize(Pango.EllipsizeMode.END);
+        }
+        const box = new St.BoxLayout({ vertical: true, y_align: Clutter.ActorAlign.CENTER });
+        box.add_child(this._label);
+        box.add_child(this._romanLabel);
+        this._indicator.add_child(box);
         Main.panel.addToStatusArea(this.uuid, this._indicator, -1, 'left');
     }
 
     disable() {
         this._log('Disabling extension...');
         
+        // Shell 的总线连接不会断开，要显式取消登记（后端可能是守护模式下共用的，不会随扩展退出）
+        this._subscribe('off');
+
         // --- 新增：在插件禁用时，首先停止后端服务 ---
         this._stopBackend();
 
         // 清理UI和D-Bus连接（保持不变）
         if (this._signalId && this._proxy) { this._proxy.disconnectSignal(this._signalId); }
+        if (this._propsChangedId && this._proxy) { this._proxy.disconnect(this._propsChangedId); }
+        if (this._nameOwnerId && this._proxy) { this._proxy.disconnect(this._nameOwnerId); }
         if (this._indicator) { this._indicator.destroy(); }
         
         // 重置所有属性
         this._signalId = null;
+        this._propsChangedId = null;
+        this._nameOwnerId = null;
         this._indicator = null;
         this._label = null;
+        this._romanLabel = null;
         this._proxy = null;
     }
 
@@ -158,14 +190,35 @@ export default class MusicfoxLyricExtension extends Extension {
     }
 
     _connectSignal() {
+        // 后端先发 PropertiesChanged 再发 StateChanged，这里读到的 CurrentSegment 已是最新的
         this._signalId = this._proxy.connectSignal('StateChanged', (proxy, sender, [artist, title, isPlaying, lyric]) => {
-            this._updateUI(artist, title, isPlaying, lyric);
+            this._updateUI(artist, title, isPlaying, this._proxy.CurrentSegment || lyric);
+        });
+        // 罗马音不在 StateChanged 里，通过属性变化通知更新
+        this._propsChangedId = this._proxy.connect('g-properties-changed', () => {
+            this._updateRomanization(this._proxy.CurrentRomanization);
+        });
+    }
+
+    _onNameOwnerChanged() {
+        if (!this._proxy || !this._proxy.g_name_owner) return;
+        this._log(`Backend owns the bus name (${this._proxy.g_name_owner}).`);
+        // 后端没有消费者时不发信号，这里登记只需要换行的 lyric 档位
+        this._subscribe('lyric');
+        this._initialUpdate();
+    }
+
+    _subscribe(tier) {
+        if (!this._proxy) return;
+        this._proxy.SubscribeRemote(tier, (result, error) => {
+            if (error) this._logError(`Subscribe(${tier}) failed: ${error.message}`);
         });
     }
 
     _initialUpdate() {
         try {
-            this._updateUI(this._proxy.Artist, this._proxy.Title, this._proxy.IsPlaying, this._proxy.CurrentLyric);
+            this._updateUI(this._proxy.Artist, this._proxy.Title, this._proxy.IsPlaying, this._proxy.CurrentSegment || this._proxy.CurrentLyric);
+            this._updateRomanization(this._proxy.CurrentRomanization);
         } catch (e) { this._logError(`Error on initial update: ${e}. Waiting for signal.`); }
     }
 
@@ -177,6 +230,12 @@ export default class MusicfoxLyricExtension extends Extension {
         this._label.set_text(`${icon} ${displayText}`);
     }
     
+    _updateRomanization(text) {
+        if (!this._romanLabel) return;
+        this._romanLabel.set_text(text || '');
+        this._romanLabel.visible = !!text;
+    }
+
     // --- 新增：用于调试的日志读取器 ---
     _setupStreamReader(stream, prefix) {
         let dataInputStream = new Gio.DataInputStream({
@@ -11,12 +11,11 @@ SOURCE_DIR=$(dirname "$(readlink -f "$0")")
 # GNOME 扩展安装目录
 DEST_DIR="$HOME/.local/share/gnome-shell/extensions/musicfox-lyric@amazzy24128"
 
-# --- 2. 编译后端 (如果需要的话) ---
-# 如果你的后端代码需要编译，取消下面几行的注释
-# echo "⚙️  正在编译后端服务..."
-# cd "$SOURCE_DIR/backend/my_backend"
-# make # 或者你的编译命令，例如 g++ ...
-# cd "$SOURCE_DIR" # 返回项目根目录
+# --- 2. 编译后端 ---
+BUILD_DIR="$SOURCE_DIR/build"
+echo "⚙️  正在编译后端服务..."
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DMUSICFOX_BUILD_TESTS=OFF -DMUSICFOX_BUILD_BENCHMARKS=OFF
+cmake --build "$BUILD_DIR" --target music-info-service -j"$(nproc)"
 
 # --- 3. 安装文件 ---
 echo "🧩 准备安装目录..."
@@ -60,7 +59,7 @@ sudo cp "$SOURCE_DIR/frontend/extension.js" "$DEST_DIR/"
 sudo cp "$SOURCE_DIR/frontend/metadata.json" "$DEST_DIR/"
 
 # 复制后端编译好的二进制文件
-sudo cp "$SOURCE_DIR/backend/my_backend/music-info-service" "$DEST_DIR/"
+sudo cp "$BUILD_DIR/backend/my_backend/music-info-service" "$DEST_DIR/"
 
 # --- 4. 完成 ---
 echo "✅ 安装成功！"